@@ -19,6 +19,7 @@
 #define __PONGASOFT_UTILS_COLLECTION_CIRCULAR_BUFFER_H__
 
 #include <cassert>
+#include <cstring>
 #include <memory>
 
 namespace pongasoft {
@@ -86,10 +87,17 @@ public:
   {
     int adjStartOffset = adjustIndexFromOffset(startOffset);
 
-    if(adjStartOffset + iSize < fSize)
+    if(adjStartOffset + iSize <= fSize)
     {
       memcpy(oBuffer, &fBuf[adjStartOffset], iSize * sizeof(T));
     }
+    else if(iSize <= fSize)
+    {
+      // wraps once => 2 contiguous spans
+      int firstSpan = fSize - adjStartOffset;
+      memcpy(oBuffer, &fBuf[adjStartOffset], firstSpan * sizeof(T));
+      memcpy(oBuffer + firstSpan, fBuf, (iSize - firstSpan) * sizeof(T));
+    }
     else
     {
       int i = adjStartOffset;
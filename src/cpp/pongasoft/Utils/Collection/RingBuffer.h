@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include <pongasoft/logging/logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace pongasoft::Utils::Collection {
+
+/**
+ * Block oriented ring buffer meant to be used as a delay line (delays, lookahead, scopes...).
+ *
+ * - the capacity is always a power of 2 so that wrapping an index is a simple mask (no loop, no modulo)
+ * - `write` and `read` copy blocks of elements in (at most) 2 contiguous spans (`memcpy` for trivially copyable types)
+ * - `readInterpolated` reads at a fractional delay (linear interpolation)
+ * - in mirrored mode, every element is written twice (at `i` and `i + getCapacity()`) which makes every span of up
+ *   to `getCapacity()` elements contiguous in memory: `read` is then a single copy and `getSpan` gives direct
+ *   (zero copy) access to the elements (at the cost of twice the memory and twice the writes)
+ *
+ * The delay is expressed in number of elements relative to the write position: after writing a block of `n`
+ * elements, `read(oBlock, n, d)` returns the block delayed by `d` elements (`d = 0` returns the block just written).
+ *
+ * All the memory is allocated in the constructor: the other methods do not allocate and can be used in the RT
+ * thread.
+ *
+ * @tparam T the type of elements (interpolated reads require `T` to support `+`, `-` and `*` with a `float`)
+ */
+template<typename T>
+class RingBuffer
+{
+public:
+  /**
+   * @param iMinCapacity the minimum number of elements the buffer can hold (rounded up to the next power of 2)
+   * @param iMirrored `true` to use the mirrored layout (see class documentation)
+   */
+  explicit RingBuffer(int iMinCapacity, bool iMirrored = false) :
+    fCapacity{computeCapacity(iMinCapacity)},
+    fMask{fCapacity - 1},
+    fMirrored{iMirrored},
+    fBuffer(static_cast<size_t>(iMirrored ? 2 * fCapacity : fCapacity))
+  {
+  }
+
+  //! @return the number of elements the buffer can hold (always a power of 2)
+  inline int getCapacity() const { return fCapacity; }
+
+  //! @return `true` if the buffer uses the mirrored layout
+  inline bool isMirrored() const { return fMirrored; }
+
+  //! Sets every element to `iValue` (does not move the write position)
+  inline void init(T const &iValue)
+  {
+    std::fill(fBuffer.begin(), fBuffer.end(), iValue);
+  }
+
+  //! Writes a single element
+  inline void push(T const &iElement)
+  {
+    fBuffer[fWritePosition] = iElement;
+    if(fMirrored)
+      fBuffer[fWritePosition + fCapacity] = iElement;
+    fWritePosition = (fWritePosition + 1) & fMask;
+  }
+
+  /**
+   * Writes a block of `iCount` elements. If `iCount` is bigger than the capacity, only the last `getCapacity()`
+   * elements are kept (as if they had been written one at a time). */
+  void write(T const *iBlock, int iCount);
+
+  /**
+   * @return the element which was written `iDelay` elements ago (`0` is the last element written). `iDelay` must be in
+   *         the range `[0, getCapacity()[` */
+  inline T const &getDelayed(int iDelay) const
+  {
+    DCHECK_F(iDelay >= 0 && iDelay < fCapacity);
+    return fBuffer[(fWritePosition - 1 - iDelay) & fMask];
+  }
+
+  /**
+   * Reads a block of `iCount` elements delayed by `iDelay` elements: `oBlock[iCount - 1]` is the element returned by
+   * `getDelayed(iDelay)` and `oBlock[0]` the one returned by `getDelayed(iDelay + iCount - 1)`. `iDelay + iCount`
+   * must be `<= getCapacity()`. */
+  void read(T *oBlock, int iCount, int iDelay) const;
+
+  /**
+   * Same as `read` but for a fractional delay: each element is linearly interpolated between the 2 closest elements.
+   * `iDelay + iCount + 1` must be `<= getCapacity()`. */
+  void readInterpolated(T *oBlock, int iCount, float iDelay) const;
+
+  /**
+   * Returns a direct pointer to the elements that `read(oBlock, iCount, iDelay)` would copy (mirrored layout only).
+   * The pointer remains valid until the next write. */
+  inline T const *getSpan(int iCount, int iDelay) const
+  {
+    DCHECK_F(fMirrored, "getSpan requires the mirrored layout");
+    DCHECK_F(iCount >= 0 && iDelay >= 0 && iDelay + iCount <= fCapacity);
+    return fBuffer.data() + ((fWritePosition - iCount - iDelay) & fMask);
+  }
+
+private:
+  // rounds up to the next power of 2
+  static int computeCapacity(int iMinCapacity)
+  {
+    DCHECK_F(iMinCapacity > 0);
+    int capacity = 1;
+    while(capacity < iMinCapacity)
+      capacity <<= 1;
+    return capacity;
+  }
+
+  // copies iCount (contiguous) elements
+  static inline void copy(T const *iFrom, int iCount, T *oTo)
+  {
+    if constexpr(std::is_trivially_copyable_v<T>)
+      std::memcpy(oTo, iFrom, static_cast<size_t>(iCount) * sizeof(T));
+    else
+      std::copy(iFrom, iFrom + iCount, oTo);
+  }
+
+  // copies iCount elements into the buffer at (masked) index iIndex (iCount <= fCapacity - iIndex)
+  inline void copyIn(T const *iFrom, int iCount, int iIndex)
+  {
+    copy(iFrom, iCount, fBuffer.data() + iIndex);
+    if(fMirrored)
+      copy(iFrom, iCount, fBuffer.data() + iIndex + fCapacity);
+  }
+
+private:
+  int const fCapacity;
+  int const fMask;
+  bool const fMirrored;
+  std::vector<T> fBuffer;
+  int fWritePosition{0};
+};
+
+//------------------------------------------------------------------------
+// RingBuffer::write
+//------------------------------------------------------------------------
+template<typename T>
+void RingBuffer<T>::write(T const *iBlock, int iCount)
+{
+  if(iCount <= 0)
+    return;
+
+  // only the last fCapacity elements survive
+  if(iCount > fCapacity)
+  {
+    fWritePosition = (fWritePosition + iCount - fCapacity) & fMask;
+    iBlock += iCount - fCapacity;
+    iCount = fCapacity;
+  }
+
+  auto firstSpan = std::min(iCount, fCapacity - fWritePosition);
+  copyIn(iBlock, firstSpan, fWritePosition);
+  if(firstSpan < iCount)
+    copyIn(iBlock + firstSpan, iCount - firstSpan, 0);
+
+  fWritePosition = (fWritePosition + iCount) & fMask;
+}
+
+//------------------------------------------------------------------------
+// RingBuffer::read
+//------------------------------------------------------------------------
+template<typename T>
+void RingBuffer<T>::read(T *oBlock, int iCount, int iDelay) const
+{
+  DCHECK_F(iCount >= 0 && iDelay >= 0 && iDelay + iCount <= fCapacity);
+
+  auto start = (fWritePosition - iCount - iDelay) & fMask;
+
+  if(fMirrored)
+  {
+    copy(fBuffer.data() + start, iCount, oBlock);
+    return;
+  }
+
+  auto firstSpan = std::min(iCount, fCapacity - start);
+  copy(fBuffer.data() + start, firstSpan, oBlock);
+  if(firstSpan < iCount)
+    copy(fBuffer.data(), iCount - firstSpan, oBlock + firstSpan);
+}
+
+//------------------------------------------------------------------------
+// RingBuffer::readInterpolated
+//------------------------------------------------------------------------
+template<typename T>
+void RingBuffer<T>::readInterpolated(T *oBlock, int iCount, float iDelay) const
+{
+  DCHECK_F(iDelay >= 0 && iDelay + iCount + 1 <= fCapacity);
+
+  auto integerDelay = static_cast<int>(iDelay);
+  auto fraction = iDelay - static_cast<float>(integerDelay);
+
+  // x[t - integerDelay - 1] is one element "older" than x[t - integerDelay]
+  auto older = (fWritePosition - iCount - integerDelay - 1) & fMask;
+
+  if(fMirrored)
+  {
+    // contiguous => no wrapping
+    auto buffer = fBuffer.data() + older;
+    for(int i = 0; i < iCount; i++)
+      oBlock[i] = buffer[i + 1] + (buffer[i] - buffer[i + 1]) * fraction;
+    return;
+  }
+
+  for(int i = 0; i < iCount; i++)
+  {
+    auto const &a = fBuffer[(older + i) & fMask];
+    auto const &b = fBuffer[(older + i + 1) & fMask];
+    oBlock[i] = b + (a - b) * fraction;
+  }
+}
+
+}
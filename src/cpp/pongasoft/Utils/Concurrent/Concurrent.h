@@ -21,6 +21,13 @@
 #include "SpinLock.h"
 
 #include <memory>
+#include <algorithm>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 namespace pongasoft {
 namespace Utils {
@@ -44,11 +51,30 @@ namespace Concurrent {
  * safe when there is a single thread calling 'get' (resp 'pop') and another single thread calling 'set' (rep 'push').
  *
  * The WithSpinLock namespace a version which uses a very lightweight lock: a user space spin lock. The SpinLock
- * implementation is not allocating any memory in any thread and is relying on the std::atomic_flag concept which is
- * guaranteed to be lock free. It also does not make any system calls. The tradeoff is that the queue and atomic
- * value do lock for the duration of the copy of T. The advantages are less memory use and fully multi thread safe.
+ * implementation is not allocating any memory in any thread and is relying on a (lock free) std::atomic<bool>: it
+ * waits by reading the flag (test-and-test-and-set) with a cpu pause hint and an exponential backoff, and only
+ * yields the thread (its only system call) when the lock is held for a long time. The tradeoff is that the queue and
+ * atomic value do lock for the duration of the copy of T. The advantages are less memory use and fully multi thread
+ * safe.
+ *
+ * When every element matters (ex: a stream of events or chunks of data) a single element queue is not enough since
+ * it keeps only the latest value: LockFree::SPSCQueue is a bounded queue (fixed capacity allocated at creation)
+ * which does not lock nor allocate memory. For large elements, LockFree::PooledQueue transfers the ownership of
+ * preallocated elements instead of copying them.
+ *
+ * When 'push' (resp 'set') may be called by more than one thread, LockFree::MPSCSingleElementQueue (resp
+ * LockFree::MPSCAtomicValue) remains lock free and allocation free at the cost of more memory (one instance of T
+ * per concurrent producer).
+ *
+ * For small trivially copyable types (see `LockFree::kSeqLockMaxSize`), `LockFree::AtomicValue` stores the value
+ * inline (no memory allocation at all) and relies on a sequence counter instead (see `LockFree::SeqLockAtomicValue`).
  */
 
+/**
+ * Size of a cache line: used to keep data accessed by different threads in different cache lines (to avoid false
+ * sharing) */
+constexpr size_t kCacheLineSize = 64;
+
 //------------------------------------------------------------------------
 // Lock Free Implementation of AtomicValue and SingleQueueElement
 //------------------------------------------------------------------------
@@ -295,6 +321,20 @@ public:
     }
     return false;
   }
+
+  /**
+   * Gives direct access to the (internal) element that will be pushed next so that it can be filled in place,
+   * possibly over several calls (for example one frame accumulated across multiple processing blocks), then
+   * handed over with `pushAcquired`. Like with `updateAndPush`, the element is "recycled" (it contains whatever
+   * value it had the last time it was used). The pointer is only valid until `pushAcquired` is called.
+   */
+  T *acquire() { return fPushValue->fElement.get(); }
+
+  /**
+   * Pushes the element returned by `acquire` (no copy, only pointers are exchanged).
+   */
+  void pushAcquired() { pushValue(); }
+
 private:
   void pushValue()
   {
@@ -308,12 +348,25 @@ private:
   std::unique_ptr<Element> fPushValue;
 };
 
+/**
+ * Maximum size of a (trivially copyable) type for `AtomicValue` to use the `SeqLockAtomicValue` implementation */
+constexpr size_t kSeqLockMaxSize = 64;
+
+/**
+ * Whether `AtomicValue<T>` uses the `SeqLockAtomicValue` implementation */
+template<typename T>
+constexpr bool use_seq_lock_atomic_value_v =
+  std::is_trivially_copyable_v<T> && !std::is_array_v<T> && sizeof(T) <= kSeqLockMaxSize;
+
 /**
  * This is the lock free version of the AtomicValue. Internally it uses a different pointer for get and set.
  * As described in the comment for SingleElementStorage, all methods related to 'get' can be called in one thread
  * while all methods related to 'set' can be called by another.
+ *
+ * Note that small trivially copyable types use a different implementation (see `SeqLockAtomicValue`) which is
+ * selected automatically (`UseSeqLock` should not be provided).
  */
-template<typename T>
+template<typename T, bool UseSeqLock = use_seq_lock_atomic_value_v<T>>
 class AtomicValue : public SingleElementStorage<T>
 {
 public:
@@ -428,177 +481,1095 @@ private:
   std::unique_ptr<Element> fGetValue;
   std::unique_ptr<Element> fSetValue;
 };
-}
-
-/**
- * The purpose of this namespace is to emphasize the fact that the implementation is using a spinlock
- */
-namespace WithSpinLock {
 
 /**
- * This class implements a queue which has at most 1 element (0 or 1). If there is already an element and the
- * push method is called again, it will replace the current element. This implementation uses a SpinLock and is
- * thread safe to be called by any number of threads. This implementation does not allocate any memory and is expecting
- * the T type to have an empty constructor and operator=.
+ * This is an implementation of `AtomicValue` for small trivially copyable types: the value is stored inline (as
+ * atomic words) along with a sequence counter (seqlock) so that no memory is ever allocated and `get` does not need
+ * to follow any pointer. `set` is wait free (it never waits for the reader) and `get` is lock free (it tries again
+ * if the value was modified while being read, which is very unlikely since copying the value is very fast).
+ *
+ * It has the same api and the same threading rules as `AtomicValue`: all methods related to 'get' can be called in
+ * one thread while all methods related to 'set' can be called by another.
  */
 template<typename T>
-class SingleElementQueue
+class SeqLockAtomicValue
 {
+  static_assert(std::is_trivially_copyable_v<T>, "SeqLockAtomicValue requires a trivially copyable type");
+
 public:
-  SingleElementQueue() : fSingleElement{std::make_unique<T>()}, fIsEmpty{true}, fSpinLock{}
-  {}
+  // Constructor
+  explicit SeqLockAtomicValue(T const &iValue) : fGetValue{iValue}, fSetValue{iValue}
+  {
+    store(fSetValue);
+  }
+
+  // Constructor (same api as AtomicValue)
+  explicit SeqLockAtomicValue(std::unique_ptr<T> iValue) : SeqLockAtomicValue(*iValue) {}
 
   /**
-   * This constructor can be used to add one element to the queue right away or when there is no empty constructor
-   * (required by the no argument constructor).
-   */
-  explicit SingleElementQueue(std::unique_ptr<T> iFirstElement,
-                              bool iIsEmpty = false) :
-    fSingleElement{std::move(iFirstElement)},
-    fIsEmpty{iIsEmpty},
-    fSpinLock{}
-  {}
+   * Used (from test) to make sure that it is a lock free implementation. */
+  bool __isLockFree() const { return fSequence.is_lock_free() && fWords[0].is_lock_free(); }
+
+  //------------------------------------------------------------------------------------------------------------
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //
+  // All the following methods (get) should be called in a single thread
+  //
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //------------------------------------------------------------------------------------------------------------
 
   /**
-   * Note that although this api is thread safe, it will only report the state of the queue at the moment it is called.
-   * You should not assume that because isEmpty() returns false, then pop will return true!
-   *
-   * @return true if the queue is empty
+   * @return the value (the pointer remains valid but its content changes with the next call)
    */
-  bool isEmpty() const
+  T const *get()
   {
-    auto lock = fSpinLock.acquire();
-    return fIsEmpty;
+    load(fGetValue);
+    return &fGetValue;
   }
 
   /**
-   * Returns the single element in the queue if there is one
-   *
-   * @param oElement this will be populated with the value of the element in the queue or left untouched if there
-   *                 isn't one
-   * @return true if there was one element in the queue, false otherwise
+   * @return a copy of the value
    */
-  bool pop(T &oElement)
+  T getCopy()
   {
-    auto lock = fSpinLock.acquire();
-    if(fIsEmpty)
-      return false;
-
-    oElement = *fSingleElement;
-    fIsEmpty = true;
+    return *get();
+  }
 
-    return true;
-  };
+  /**
+   * Copy the value to oElement
+   */
+  void get(T &oElement) const
+  {
+    load(oElement);
+  }
 
   /**
-   * Returns the single element in the queue if there is one
-   *
-   * @param oElement this will be populated with the value of the element in the queue or left untouched if there
-   *                 isn't one
-   * @return true if there was one element in the queue, false otherwise
+   * Copy the value to *oElement
    */
-  bool pop(T *oElement)
+  void get(T *oElement) const
   {
-    auto lock = fSpinLock.acquire();
-    if(fIsEmpty)
-      return false;
+    load(*oElement);
+  }
 
-    *oElement = *fSingleElement;
-    fIsEmpty = true;
+  //------------------------------------------------------------------------------------------------------------
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //
+  // All the following methods (set / update) should be called in a single thread
+  //
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //------------------------------------------------------------------------------------------------------------
 
-    return true;
-  };
+  /**
+   * Copy the value to make it accessible to get
+   */
+  void set(T const &iValue)
+  {
+    fSetValue = iValue;
+    store(fSetValue);
+  }
 
+  /**
+   * Copy the value to make it accessible to get
+   */
+  void set(T const *iValue)
+  {
+    set(*iValue);
+  }
 
   /**
-   * Pushes one element in the queue. If the queue already had an element it will be replaced.
-   * @param iElement the element to push (clearly not modified by the call)
+   * ElementModifier will be called back with a pointer to the last value set to update it.
    */
-  void push(T const &iElement)
+  template<class ElementModifier>
+  void update(ElementModifier const &iElementModifier)
   {
-    auto lock = fSpinLock.acquire();
-    *fSingleElement = iElement;
-    fIsEmpty = false;
+    iElementModifier(&fSetValue);
+    store(fSetValue);
   }
 
   /**
-   * Pushes one element in the queue. If the queue already had an element it will be replaced.
-   * @param iElement the element to push (clearly not modified by the call)
+   * ElementModifier will be called back with a pointer to the last value set to update it. This flavor uses a
+   * callback that returns true when the update should happen and false otherwise.
    */
-  void push(T const *iElement)
+  template<class ElementModifier>
+  bool updateIf(ElementModifier const &iElementModifier)
   {
-    auto lock = fSpinLock.acquire();
-    *fSingleElement = *iElement;
-    fIsEmpty = false;
+    if(iElementModifier(&fSetValue))
+    {
+      store(fSetValue);
+      return true;
+    }
+
+    return false;
   }
 
 private:
-  std::unique_ptr<T> fSingleElement;
-  bool fIsEmpty;
-  mutable SpinLock fSpinLock;
+  static constexpr size_t kNumWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  // store (the sequence is odd while the words are being written)
+  void store(T const &iValue)
+  {
+    uint64_t words[kNumWords]{};
+    std::memcpy(words, &iValue, sizeof(T));
+
+    auto sequence = fSequence.load(std::memory_order_relaxed);
+    fSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for(size_t i = 0; i < kNumWords; i++)
+      fWords[i].store(words[i], std::memory_order_relaxed);
+
+    fSequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  // load (tries again if the value was being written or has been modified while reading it)
+  void load(T &oValue) const
+  {
+    uint64_t words[kNumWords];
+    uint32_t sequence1, sequence2;
+
+    do
+    {
+      sequence1 = fSequence.load(std::memory_order_acquire);
+
+      for(size_t i = 0; i < kNumWords; i++)
+        words[i] = fWords[i].load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      sequence2 = fSequence.load(std::memory_order_relaxed);
+    }
+    while(sequence1 != sequence2 || (sequence1 & 1) != 0);
+
+    std::memcpy(&oValue, words, sizeof(T));
+  }
+
+private:
+  std::atomic<uint32_t> fSequence{0};
+  std::atomic<uint64_t> fWords[kNumWords]{};
+
+  T fGetValue; // only accessed by the get thread
+  T fSetValue; // only accessed by the set thread
 };
 
 /**
- * This class encapsulates a single atomic value. This implementation uses a SpinLock and is
- * thread safe to be called by any number of threads. This implementation does not allocate any memory and is
- * expecting the T type to have an empty constructor, copy constructor and operator=.
- */
+ * Selects the seqlock implementation for small trivially copyable types */
 template<typename T>
-class AtomicValue
+class AtomicValue<T, true> : public SeqLockAtomicValue<T>
 {
 public:
-  explicit AtomicValue(std::unique_ptr<T> iValue) : fValue{std::move(iValue)}, fSpinLock{} {}
+  using SeqLockAtomicValue<T>::SeqLockAtomicValue;
+};
 
-  explicit AtomicValue(T const &iValue) : fValue{std::make_unique<T>(iValue)}, fSpinLock{} {}
+/**
+ * This is a bounded (fixed capacity), lock free and allocation free queue (memory is allocated only in the
+ * constructor). This implementation is only thread safe when there is a single thread calling the methods related to
+ * 'pop' (consumer) and another single thread calling the methods related to 'push' (producer).
+ *
+ * Contrary to `SingleElementQueue`, every element pushed is kept until popped: when the queue is full, push fails
+ * (and returns `false`) so the producer decides what to do (for example drop the element).
+ *
+ * Elements are stored in a preallocated ring buffer and are never constructed or destroyed after creation, they
+ * are only assigned (or updated in place using `updateAndPush` / `front`, which is the way to avoid copies).
+ */
+template<typename T>
+class SPSCQueue
+{
+public:
+  /**
+   * @param iCapacity the maximum number of elements in the queue (rounded up to the next power of 2)
+   */
+  explicit SPSCQueue(size_t iCapacity) : SPSCQueue(iCapacity, T{}) {}
 
   /**
-   * Returns the "current" value. Note that this method should be called by one thread at a time (it is ok to call
-   * "set" at the same time with another thread). The return value is copied in the oElement (copy vs creation).
+   * This constructor should be used if T does not provide an empty constructor (every slot is initialized with a
+   * copy of `iInitialValue`).
    */
-  T get()
+  SPSCQueue(size_t iCapacity, T const &iInitialValue) :
+    fElements(computeCapacity(iCapacity), iInitialValue),
+    fMask{fElements.size() - 1}
+  {}
+
+  // getCapacity
+  inline size_t getCapacity() const { return fElements.size(); }
+
+  /**
+   * Note that although this api is thread safe, it only reports the state of the queue at the moment it is called.
+   *
+   * @return the number of elements in the queue */
+  inline size_t getSize() const
   {
-    auto lock = fSpinLock.acquire();
-    return *fValue;
-  };
+    // the read index is loaded first: since the reader never goes past the writer, the write index loaded after it
+    // cannot be smaller (no wrap around when called from a third thread). Both may move in between the 2 loads, so
+    // the result is capped to the capacity.
+    auto readIndex = fReadIndex.load(std::memory_order_acquire);
+    auto writeIndex = fWriteIndex.load(std::memory_order_acquire);
+    return std::min(writeIndex - readIndex, getCapacity());
+  }
+
+  // isEmpty (same caveat as getSize)
+  inline bool isEmpty() const { return getSize() == 0; }
 
   /**
- * Returns the "current" value. Note that this method should be called by one thread at a time (it is ok to call
- * "set" at the same time with another thread). The return value is copied in the oElement (copy vs creation).
- */
-  void get(T &oElement)
+   * Used (from test) to make sure that it is a lock free implementation. */
+  bool __isLockFree() const { return fWriteIndex.is_lock_free() && fReadIndex.is_lock_free(); }
+
+  //------------------------------------------------------------------------------------------------------------
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //
+  // All the following methods (front, popFront, pop and popAll) should be called in a single thread
+  //
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //------------------------------------------------------------------------------------------------------------
+
+  /**
+   * @return the oldest element in the queue (without removing it) or `nullptr` if the queue is empty. The element
+   *         can be used (and modified) until `popFront` is called.
+   */
+  T *front()
   {
-    auto lock = fSpinLock.acquire();
-    oElement = *fValue;
-  };
+    auto readIndex = fReadIndex.load(std::memory_order_relaxed);
+
+    if(readIndex == fCachedWriteIndex)
+    {
+      fCachedWriteIndex = fWriteIndex.load(std::memory_order_acquire);
+      if(readIndex == fCachedWriteIndex)
+        return nullptr;
+    }
+
+    return &fElements[readIndex & fMask];
+  }
 
   /**
-   * Returns the "current" value. Note that this method should be called by one thread at a time (it is ok to call
-   * "set" at the same time with another thread). The return value is copied in the oElement (copy vs creation).
+   * Removes the oldest element from the queue. Must only be called after `front` returned a non `nullptr` value.
    */
-  void get(T *oElement)
+  void popFront()
   {
-    auto lock = fSpinLock.acquire();
-    *oElement = *fValue;
-  };
+    fReadIndex.store(fReadIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
 
   /**
-   * Updates the current value with the provided one.
+   * Copy the oldest element to oElement and removes it from the queue
+   *
+   * @return `true` if there was an element, `false` otherwise (in which case oElement is left untouched)
    */
-  void set(T const &iValue)
+  bool pop(T &oElement)
   {
-    auto lock = fSpinLock.acquire();
-    *fValue = iValue;
+    auto element = front();
+    if(element)
+    {
+      oElement = *element;
+      popFront();
+      return true;
+    }
+
+    return false;
   }
 
   /**
-   * Updates the current value with the provided one.
+   * Pops (up to `iMaxCount`) elements in one batch: `iElementConsumer` is called back with the internal pointer of
+   * each element (oldest first) and the elements are released all at once at the end.
+   *
+   * @return the number of elements popped
    */
-  void set(T const *iValue)
+  template<class ElementConsumer>
+  size_t popAll(ElementConsumer const &iElementConsumer, size_t iMaxCount = static_cast<size_t>(-1))
   {
-    auto lock = fSpinLock.acquire();
-    *fValue = *iValue;
+    auto readIndex = fReadIndex.load(std::memory_order_relaxed);
+    fCachedWriteIndex = fWriteIndex.load(std::memory_order_acquire);
+
+    auto count = std::min(fCachedWriteIndex - readIndex, iMaxCount);
+
+    for(size_t i = 0; i < count; i++)
+      iElementConsumer(&fElements[(readIndex + i) & fMask]);
+
+    if(count > 0)
+      fReadIndex.store(readIndex + count, std::memory_order_release);
+
+    return count;
   }
 
+  //------------------------------------------------------------------------------------------------------------
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //
+  // All the following methods (push and updateAndPush) should be called in a single thread
+  //
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //------------------------------------------------------------------------------------------------------------
+
+  /**
+   * Pushes (a copy of) iElement in the queue.
+   *
+   * @return `false` if the queue is full (in which case the element is not pushed) */
+  bool push(T const &iElement)
+  {
+    return updateAndPushIf([&iElement](T *oElement) { *oElement = iElement; return true; });
+  }
+
+  /**
+   * Pushes (a copy of) the `iCount` elements in one batch (they are made visible to the consumer all at once).
+   *
+   * @return the number of elements actually pushed (less than `iCount` if the queue gets full) */
+  size_t push(T const *iElements, size_t iCount)
+  {
+    auto writeIndex = fWriteIndex.load(std::memory_order_relaxed);
+    auto count = std::min(iCount, availableToPush(writeIndex, iCount));
+
+    for(size_t i = 0; i < count; i++)
+      fElements[(writeIndex + i) & fMask] = iElements[i];
+
+    if(count > 0)
+      fWriteIndex.store(writeIndex + count, std::memory_order_release);
+
+    return count;
+  }
+
+  /**
+   * Use this flavor of push to avoid copy. ElementModifier will be called back with the internal pointer to
+   * update it. Note that the element is "recycled" (it contains whatever value it had the last time this slot
+   * was used).
+   *
+   * @return `false` if the queue is full (in which case `iElementModifier` is not called) */
+  template<class ElementModifier>
+  bool updateAndPush(ElementModifier const &iElementModifier)
+  {
+    return updateAndPushIf([&iElementModifier](T *oElement) { iElementModifier(oElement); return true; });
+  }
+
+  /**
+   * Use this flavor of push to avoid copy. ElementModifier will be called back with the internal pointer to
+   * update it. This flavor uses a callback that returns true when the push should happen and false otherwise.
+   *
+   * @return `true` if the element was pushed, `false` if the queue is full or the callback returned `false` */
+  template<class ElementModifier>
+  bool updateAndPushIf(ElementModifier const &iElementModifier)
+  {
+    auto writeIndex = fWriteIndex.load(std::memory_order_relaxed);
+
+    if(availableToPush(writeIndex, 1) == 0)
+      return false;
+
+    if(iElementModifier(&fElements[writeIndex & fMask]))
+    {
+      fWriteIndex.store(writeIndex + 1, std::memory_order_release);
+      return true;
+    }
+
+    return false;
+  }
+
+private:
+  // availableToPush (only reloads the read index when the cached one is not enough)
+  inline size_t availableToPush(size_t iWriteIndex, size_t iCount)
+  {
+    auto available = getCapacity() - (iWriteIndex - fCachedReadIndex);
+    if(available < iCount)
+    {
+      fCachedReadIndex = fReadIndex.load(std::memory_order_acquire);
+      available = getCapacity() - (iWriteIndex - fCachedReadIndex);
+    }
+    return available;
+  }
+
+  // computeCapacity (next power of 2)
+  static size_t computeCapacity(size_t iCapacity)
+  {
+    size_t capacity = 1;
+    while(capacity < iCapacity)
+      capacity <<= 1;
+    return capacity;
+  }
+
+private:
+  std::vector<T> fElements;
+  size_t const fMask;
+
+  // the indices are ever increasing (wrapping is fine since the capacity is a power of 2) and each one is kept in
+  // its own cache line along with the cached copy of the other index (only accessed by the same thread). Note that
+  // the alignment of the class itself guarantees that the last cache line is not shared with anything else.
+  alignas(kCacheLineSize) std::atomic<size_t> fWriteIndex{0};
+  size_t fCachedReadIndex{0}; // producer only
+  alignas(kCacheLineSize) std::atomic<size_t> fReadIndex{0};
+  size_t fCachedWriteIndex{0}; // consumer only
+};
+
+/**
+ * This is a bounded, lock free and allocation free queue meant for large elements (sample buffers, spectrum
+ * frames...): the elements are never copied from the producer to the consumer, only their ownership is transferred.
+ * Like `SPSCQueue`, it is only thread safe when there is a single producer thread and a single consumer thread.
+ *
+ * All the elements are allocated in the constructor (pool). The producer `acquire`s a free element from the pool,
+ * fills it in place and hands it over to the consumer with `pushAcquired`. The consumer `pop`s the element and owns
+ * it until the next call to `pop` which returns it to the pool (the last element popped remains accessible via
+ * `last`). Internally only pointers travel between the 2 threads (via 2 `SPSCQueue<T *>`: one for the elements
+ * pushed and one for the elements returned to the pool).
+ *
+ * When the consumer does not keep up, the pool gets exhausted and `acquire` returns `nullptr` (so the producer
+ * decides what to do, for example drop the element).
+ */
+template<typename T>
+class PooledQueue
+{
+public:
+  /**
+   * @param iCapacity the maximum number of elements that can be pushed and not yet popped
+   * @param iInitialValue every element of the pool is initialized with a copy of this value
+   */
+  PooledQueue(size_t iCapacity, T const &iInitialValue) :
+    fPushedElements{iCapacity + kNumExtraElements, nullptr},
+    fFreeElements{iCapacity + kNumExtraElements, nullptr}
+  {
+    // 1 extra element for the one that the consumer owns (last)
+    fPool.reserve(iCapacity + kNumExtraElements);
+    for(size_t i = 0; i < iCapacity + kNumExtraElements; i++)
+    {
+      fPool.emplace_back(std::make_unique<T>(iInitialValue));
+      if(i == 0)
+        fLastElement = fPool[i].get();
+      else
+        fFreeElements.push(fPool[i].get());
+    }
+  }
+
+  /**
+   * Although this api is thread safe, it only reports the state of the queue at the moment it is called.
+   *
+   * @return the number of elements pushed and not yet popped */
+  inline size_t getSize() const { return fPushedElements.getSize(); }
+
+  // isEmpty (same caveat as getSize)
+  inline bool isEmpty() const { return fPushedElements.isEmpty(); }
+
+  // getPoolSize (total number of elements allocated)
+  inline size_t getPoolSize() const { return fPool.size(); }
+
+  /**
+   * Used (from test) to make sure that it is a lock free implementation. */
+  bool __isLockFree() const { return fPushedElements.__isLockFree() && fFreeElements.__isLockFree(); }
+
+  //------------------------------------------------------------------------------------------------------------
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //
+  // All the following methods (pop and last) should be called in a single thread
+  //
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //------------------------------------------------------------------------------------------------------------
+
+  /**
+   * Pops the oldest element pushed and returns the previously popped one to the pool.
+   *
+   * @return the element popped (owned by the caller until the next call to `pop`) or `nullptr` if nothing to pop
+   *         (in which case the previously popped element is kept) */
+  T *pop()
+  {
+    T *element = nullptr;
+    if(!fPushedElements.pop(element))
+      return nullptr;
+
+    // cannot fail: the free queue can hold every element of the pool
+    fFreeElements.push(fLastElement);
+    fLastElement = element;
+    return element;
+  }
+
+  /**
+   * @return the last element that was popped (never `nullptr`). Does NOT check for new element
+   */
+  T const *last() const { return fLastElement; }
+
+  //------------------------------------------------------------------------------------------------------------
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //
+  // All the following methods (acquire, pushAcquired and updateAndPush) should be called in a single thread
+  //
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //------------------------------------------------------------------------------------------------------------
+
+  /**
+   * Acquires a free element from the pool (calling this method again before `pushAcquired` returns the same
+   * element). The element is "recycled" (it contains whatever value it had the last time it was used) and can be
+   * filled in place, possibly over several calls.
+   *
+   * @return the element or `nullptr` if the pool is exhausted (the consumer has not popped enough elements) */
+  T *acquire()
+  {
+    if(!fAcquiredElement)
+      fFreeElements.pop(fAcquiredElement);
+    return fAcquiredElement;
+  }
+
+  /**
+   * Hands over the element returned by `acquire` to the consumer (no copy, only the pointer is pushed).
+   *
+   * @return `false` if no element was acquired */
+  bool pushAcquired()
+  {
+    if(!fAcquiredElement)
+      return false;
+
+    // cannot fail: the pushed queue can hold every element of the pool
+    fPushedElements.push(fAcquiredElement);
+    fAcquiredElement = nullptr;
+    return true;
+  }
+
+  /**
+   * Pushes (a copy of) iElement in the queue.
+   *
+   * @return `false` if the pool is exhausted (in which case the element is not pushed) */
+  bool push(T const &iElement)
+  {
+    return updateAndPushIf([&iElement](T *oElement) { *oElement = iElement; return true; });
+  }
+
+  /**
+   * Use this flavor of push to avoid copy (`acquire` + `pushAcquired` in one call).
+   *
+   * @return `false` if the pool is exhausted (in which case `iElementModifier` is not called) */
+  template<class ElementModifier>
+  bool updateAndPush(ElementModifier const &iElementModifier)
+  {
+    return updateAndPushIf([&iElementModifier](T *oElement) { iElementModifier(oElement); return true; });
+  }
+
+  /**
+   * Use this flavor of push to avoid copy. This flavor uses a callback that returns true when the push should
+   * happen and false otherwise (in which case the element remains acquired for the next call).
+   *
+   * @return `true` if the element was pushed, `false` if the pool is exhausted or the callback returned `false` */
+  template<class ElementModifier>
+  bool updateAndPushIf(ElementModifier const &iElementModifier)
+  {
+    auto element = acquire();
+    if(element && iElementModifier(element))
+      return pushAcquired();
+    return false;
+  }
+
+private:
+  static constexpr size_t kNumExtraElements = 1;
+
+  std::vector<std::unique_ptr<T>> fPool{};
+  SPSCQueue<T *> fPushedElements; // producer -> consumer
+  SPSCQueue<T *> fFreeElements;   // consumer -> producer
+  T *fLastElement{};              // consumer only
+  T *fAcquiredElement{};          // producer only
+};
+
+/**
+ * Default maximum number of threads which can push (resp set) at the exact same time in `MPSCSingleElementQueue`
+ * (resp `MPSCAtomicValue`) */
+constexpr size_t kDefaultMaxProducers = 4;
+
+/**
+ * This (internal) class is the multi producer version of `SingleElementStorage`: any number of threads can store
+ * elements concurrently (as long as there are no more than `iMaxProducers` of them storing at the exact same time)
+ * while a single thread loads them.
+ *
+ * All the elements are allocated in the constructor (`iMaxProducers + 2`: one per producer, one for the element
+ * currently stored and one for the element owned by the consumer). A producer claims a free element (flag), fills it
+ * in place and then exchanges it with the stored one (which it releases). The consumer exchanges its own element with
+ * the stored one (if new). Neither side ever waits for the other.
+ */
+template<typename T>
+class MPSCSingleElementStorage
+{
+public:
+  // Constructor
+  MPSCSingleElementStorage(std::unique_ptr<T> iElement, bool iIsEmpty, size_t iMaxProducers) :
+    fBusy(std::max<size_t>(iMaxProducers, 1) + 2)
+  {
+    fElements.reserve(fBusy.size());
+    for(size_t i = 1; i < fBusy.size(); i++)
+      fElements.emplace_back(std::make_unique<T>(*iElement));
+    fElements.emplace_back(std::move(iElement));
+
+    // the last element is the one stored and the one before is owned by the consumer
+    fStored = iIsEmpty ? fElements.size() - 1 : (fElements.size() - 1) | kNewFlag;
+    fConsumerIndex = fElements.size() - 2;
+    fBusy[fElements.size() - 1] = true;
+    fBusy[fElements.size() - 2] = true;
+  }
+
+  // isEmpty
+  inline bool isEmpty() const
+  {
+    return (fStored.load(std::memory_order_acquire) & kNewFlag) == 0;
+  }
+
+  // getMaxProducers
+  inline size_t getMaxProducers() const { return fElements.size() - 2; }
+
+  /**
+   * Used (from test) to make sure that it is a lock free implementation. */
+  bool __isLockFree() const { return fStored.is_lock_free() && (fBusy.empty() || fBusy[0].is_lock_free()); }
+
+protected:
+  /**
+   * Stores an element in the storage, after `iElementModifier` (`bool (T *)`) is called with a free element (which
+   * contains whatever value it had the last time it was used) and returns `true`. Can be called by any thread.
+   *
+   * @return `false` if `iElementModifier` returned `false` or there was no free element (more than
+   *         `getMaxProducers()` threads storing at the same time) */
+  template<class ElementModifier>
+  bool store(ElementModifier const &iElementModifier)
+  {
+    for(size_t i = 0; i < fBusy.size(); i++)
+    {
+      // cheap check first to avoid writing to the cache line of busy elements
+      if(fBusy[i].load(std::memory_order_relaxed) || fBusy[i].exchange(true, std::memory_order_acquire))
+        continue;
+
+      if(iElementModifier(fElements[i].get()))
+      {
+        auto previous = fStored.exchange(i | kNewFlag, std::memory_order_acq_rel);
+        fBusy[previous & ~kNewFlag].store(false, std::memory_order_release);
+        return true;
+      }
+
+      fBusy[i].store(false, std::memory_order_release);
+      return false;
+    }
+
+    return false;
+  }
+
+  /**
+   * Loads the element stored (if new) by exchanging it with the one owned by the consumer. Must be called by a
+   * single thread.
+   *
+   * @return `true` if there was a new element (accessible via `consumerElement`) */
+  bool load()
+  {
+    if(isEmpty())
+      return false;
+
+    // since only the consumer stores an element without the new flag, the element exchanged is always new
+    fConsumerIndex = fStored.exchange(fConsumerIndex, std::memory_order_acq_rel) & ~kNewFlag;
+    return true;
+  }
+
+  // consumerElement (the element owned by the consumer, never nullptr)
+  inline T *consumerElement() const { return fElements[fConsumerIndex].get(); }
+
+private:
+  static constexpr size_t kNewFlag = static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);
+
+  std::vector<std::unique_ptr<T>> fElements{};
+  std::vector<std::atomic<bool>> fBusy;
+  std::atomic<size_t> fStored{};
+  size_t fConsumerIndex{}; // consumer only
+};
+
+/**
+ * This is the multi producer version of `SingleElementQueue`: it is lock free and allocation free, 'push' can be
+ * called from any number of threads (up to `getMaxProducers()` at the exact same time) while 'pop' must be called by
+ * a single thread. Use it when the producer is not guaranteed to always be the same thread (ex: `setState` can be
+ * called by different host threads).
+ */
+template<typename T>
+class MPSCSingleElementQueue : public MPSCSingleElementStorage<T>
+{
+public:
+  // Constructor
+  explicit MPSCSingleElementQueue(size_t iMaxProducers = kDefaultMaxProducers) :
+    MPSCSingleElementStorage<T>{std::make_unique<T>(), true, iMaxProducers}
+  {}
+
+  /**
+   * This constructor should be used if T does not provide an empty constructor */
+  explicit MPSCSingleElementQueue(std::unique_ptr<T> iElement,
+                                  bool iIsEmpty = false,
+                                  size_t iMaxProducers = kDefaultMaxProducers) :
+    MPSCSingleElementStorage<T>{std::move(iElement), iIsEmpty, iMaxProducers}
+  {}
+
+  //------------------------------------------------------------------------------------------------------------
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //
+  // All the following methods (pop and last) should be called in a single thread
+  //
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //------------------------------------------------------------------------------------------------------------
+  /**
+   * @return the value popped or nullptr if nothing to pop
+   */
+  T *pop() { return this->load() ? this->consumerElement() : nullptr; }
+
+  /**
+   * Copy the popped value to oElement and return true when there is a new value otherwise do nothing and return false.
+   */
+  bool pop(T &oElement)
+  {
+    auto element = pop();
+    if(element)
+    {
+      oElement = *element;
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * @return returns the last value that was popped (never nullptr). Does NOT check for new value
+   */
+  T const *last() const { return this->consumerElement(); }
+
+  /**
+   * @return if there is a new value to pop, returns it otherwise return the last value that was popped (never nullptr)
+   */
+  T const *popOrLast()
+  {
+    this->load();
+    return this->consumerElement();
+  }
+
+  //------------------------------------------------------------------------------------------------------------
+  // The following methods (push and updateAndPush) can be called from any thread
+  //------------------------------------------------------------------------------------------------------------
+
+  /**
+   * Pushes (a copy of) iElement in the queue.
+   *
+   * @return `false` if too many threads were pushing at the same time (in which case the element is dropped) */
+  bool push(T const &iElement)
+  {
+    return updateAndPushIf([&iElement](T *oElement) { *oElement = iElement; return true; });
+  }
+
+  /**
+   * Use this flavor of push to avoid copy. ElementModifier will be called back with an internal pointer to
+   * update it (which contains whatever value it had the last time it was used).
+   *
+   * @return `false` if too many threads were pushing at the same time (in which case `iElementModifier` is not
+   *         called) */
+  template<class ElementModifier>
+  bool updateAndPush(ElementModifier const &iElementModifier)
+  {
+    return updateAndPushIf([&iElementModifier](T *oElement) { iElementModifier(oElement); return true; });
+  }
+
+  /**
+   * Use this flavor of push to avoid copy. This flavor uses a callback that returns true when the push should
+   * happen and false otherwise.
+   */
+  template<class ElementModifier>
+  bool updateAndPushIf(ElementModifier const &iElementModifier) { return this->store(iElementModifier); }
+};
+
+/**
+ * This is the multi producer version of `AtomicValue`: it is lock free and allocation free, 'set' can be called from
+ * any number of threads (up to `getMaxProducers()` at the exact same time) while 'get' must be called by a single
+ * thread.
+ */
+template<typename T>
+class MPSCAtomicValue : public MPSCSingleElementStorage<T>
+{
+public:
+  // Constructor
+  explicit MPSCAtomicValue(std::unique_ptr<T> iElement, size_t iMaxProducers = kDefaultMaxProducers) :
+    MPSCSingleElementStorage<T>{std::move(iElement), false, iMaxProducers}
+  {}
+
+  // Constructor
+  explicit MPSCAtomicValue(T const &iValue, size_t iMaxProducers = kDefaultMaxProducers) :
+    MPSCAtomicValue{std::make_unique<T>(iValue), iMaxProducers}
+  {}
+
+  //------------------------------------------------------------------------------------------------------------
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //
+  // All the following methods (get) should be called in a single thread
+  //
+  // WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING WARNING
+  //------------------------------------------------------------------------------------------------------------
+
+  /**
+   * @return the latest value set (the pointer remains valid until the next call to `get`)
+   */
+  T const *get()
+  {
+    this->load();
+    return this->consumerElement();
+  }
+
+  /**
+   * @return a copy of the latest value set
+   */
+  T getCopy() { return *get(); }
+
+  /**
+   * Copy the latest value set to oElement
+   */
+  void get(T &oElement) { oElement = *get(); }
+
+  //------------------------------------------------------------------------------------------------------------
+  // The following methods (set and updateAndSet) can be called from any thread
+  //------------------------------------------------------------------------------------------------------------
+
+  /**
+   * Copy iValue into the atomic value.
+   *
+   * @return `false` if too many threads were setting the value at the same time (in which case it is dropped) */
+  bool set(T const &iValue)
+  {
+    return this->store([&iValue](T *oValue) { *oValue = iValue; return true; });
+  }
+
+  /**
+   * Use this flavor of set to avoid copy. ElementModifier will be called back with an internal pointer (which
+   * contains whatever value it had the last time it was used) to fill entirely.
+   *
+   * @return `false` if too many threads were setting the value at the same time */
+  template<class ElementModifier>
+  bool updateAndSet(ElementModifier const &iElementModifier)
+  {
+    return this->store([&iElementModifier](T *oValue) { iElementModifier(oValue); return true; });
+  }
+};
+}
+
+/**
+ * The purpose of this namespace is to emphasize the fact that the implementation is using a spinlock
+ */
+namespace WithSpinLock {
+
+/**
+ * This class implements a queue which has at most 1 element (0 or 1). If there is already an element and the
+ * push method is called again, it will replace the current element. This implementation uses a SpinLock and is
+ * thread safe to be called by any number of threads. This implementation does not allocate any memory and is expecting
+ * the T type to have an empty constructor and operator=.
+ */
+template<typename T>
+class SingleElementQueue
+{
+public:
+  SingleElementQueue() : fSingleElement{std::make_unique<T>()}, fIsEmpty{true}, fSpinLock{}
+  {}
+
+  /**
+   * This constructor can be used to add one element to the queue right away or when there is no empty constructor
+   * (required by the no argument constructor).
+   */
+  explicit SingleElementQueue(std::unique_ptr<T> iFirstElement,
+                              bool iIsEmpty = false) :
+    fSingleElement{std::move(iFirstElement)},
+    fIsEmpty{iIsEmpty},
+    fSpinLock{}
+  {}
+
+  /**
+   * Note that although this api is thread safe, it will only report the state of the queue at the moment it is called.
+   * You should not assume that because isEmpty() returns false, then pop will return true!
+   *
+   * @return true if the queue is empty
+   */
+  bool isEmpty() const
+  {
+    auto lock = fSpinLock.acquire();
+    return fIsEmpty;
+  }
+
+  /**
+   * Returns the single element in the queue if there is one
+   *
+   * @param oElement this will be populated with the value of the element in the queue or left untouched if there
+   *                 isn't one
+   * @return true if there was one element in the queue, false otherwise
+   */
+  bool pop(T &oElement)
+  {
+    auto lock = fSpinLock.acquire();
+    if(fIsEmpty)
+      return false;
+
+    oElement = *fSingleElement;
+    fIsEmpty = true;
+
+    return true;
+  };
+
+  /**
+   * Returns the single element in the queue if there is one
+   *
+   * @param oElement this will be populated with the value of the element in the queue or left untouched if there
+   *                 isn't one
+   * @return true if there was one element in the queue, false otherwise
+   */
+  bool pop(T *oElement)
+  {
+    auto lock = fSpinLock.acquire();
+    if(fIsEmpty)
+      return false;
+
+    *oElement = *fSingleElement;
+    fIsEmpty = true;
+
+    return true;
+  };
+
+
+  /**
+   * Pushes one element in the queue. If the queue already had an element it will be replaced.
+   * @param iElement the element to push (clearly not modified by the call)
+   */
+  void push(T const &iElement)
+  {
+    auto lock = fSpinLock.acquire();
+    *fSingleElement = iElement;
+    fIsEmpty = false;
+  }
+
+  /**
+   * Pushes one element in the queue. If the queue already had an element it will be replaced.
+   * @param iElement the element to push (clearly not modified by the call)
+   */
+  void push(T const *iElement)
+  {
+    auto lock = fSpinLock.acquire();
+    *fSingleElement = *iElement;
+    fIsEmpty = false;
+  }
+
+  /**
+   * Same as `pop` except it does not wait if the lock is held by another thread.
+   *
+   * @return true if there was one element in the queue and the lock could be acquired, false otherwise
+   */
+  bool tryPop(T &oElement)
+  {
+    auto lock = fSpinLock.tryAcquire();
+    if(!lock || fIsEmpty)
+      return false;
+
+    oElement = *fSingleElement;
+    fIsEmpty = true;
+
+    return true;
+  }
+
+  /**
+   * Same as `push` except it does not wait if the lock is held by another thread (for example the real time thread
+   * can skip the update and try again later).
+   *
+   * @return `true` if the element was pushed, `false` if the lock could not be acquired
+   */
+  bool tryPush(T const &iElement)
+  {
+    auto lock = fSpinLock.tryAcquire();
+    if(!lock)
+      return false;
+
+    *fSingleElement = iElement;
+    fIsEmpty = false;
+
+    return true;
+  }
+
+  //! @return how many times the lock was contended (for diagnostics)
+  uint32_t getLockContentionCount() const { return fSpinLock.getContentionCount(); }
+
+private:
+  std::unique_ptr<T> fSingleElement;
+  bool fIsEmpty;
+  mutable SpinLock fSpinLock;
+};
+
+/**
+ * This class encapsulates a single atomic value. This implementation uses a SpinLock and is
+ * thread safe to be called by any number of threads. This implementation does not allocate any memory and is
+ * expecting the T type to have an empty constructor, copy constructor and operator=.
+ */
+template<typename T>
+class AtomicValue
+{
+public:
+  explicit AtomicValue(std::unique_ptr<T> iValue) : fValue{std::move(iValue)}, fSpinLock{} {}
+
+  explicit AtomicValue(T const &iValue) : fValue{std::make_unique<T>(iValue)}, fSpinLock{} {}
+
+  /**
+   * Returns the "current" value. Note that this method should be called by one thread at a time (it is ok to call
+   * "set" at the same time with another thread). The return value is copied in the oElement (copy vs creation).
+   */
+  T get()
+  {
+    auto lock = fSpinLock.acquire();
+    return *fValue;
+  };
+
+  /**
+ * Returns the "current" value. Note that this method should be called by one thread at a time (it is ok to call
+ * "set" at the same time with another thread). The return value is copied in the oElement (copy vs creation).
+ */
+  void get(T &oElement)
+  {
+    auto lock = fSpinLock.acquire();
+    oElement = *fValue;
+  };
+
+  /**
+   * Returns the "current" value. Note that this method should be called by one thread at a time (it is ok to call
+   * "set" at the same time with another thread). The return value is copied in the oElement (copy vs creation).
+   */
+  void get(T *oElement)
+  {
+    auto lock = fSpinLock.acquire();
+    *oElement = *fValue;
+  };
+
+  /**
+   * Updates the current value with the provided one.
+   */
+  void set(T const &iValue)
+  {
+    auto lock = fSpinLock.acquire();
+    *fValue = iValue;
+  }
+
+  /**
+   * Updates the current value with the provided one.
+   */
+  void set(T const *iValue)
+  {
+    auto lock = fSpinLock.acquire();
+    *fValue = *iValue;
+  }
+
+  /**
+   * Same as `get` except it does not wait if the lock is held by another thread.
+   *
+   * @return `true` if the value was copied to oElement, `false` if the lock could not be acquired (in which case
+   *         oElement is left untouched)
+   */
+  bool tryGet(T &oElement)
+  {
+    auto lock = fSpinLock.tryAcquire();
+    if(!lock)
+      return false;
+
+    oElement = *fValue;
+    return true;
+  }
+
+  /**
+   * Same as `set` except it does not wait if the lock is held by another thread (for example the real time thread
+   * can skip the update and try again later).
+   *
+   * @return `true` if the value was updated, `false` if the lock could not be acquired
+   */
+  bool trySet(T const &iValue)
+  {
+    auto lock = fSpinLock.tryAcquire();
+    if(!lock)
+      return false;
+
+    *fValue = iValue;
+    return true;
+  }
+
+  //! @return how many times the lock was contended (for diagnostics)
+  uint32_t getLockContentionCount() const { return fSpinLock.getContentionCount(); }
+
 private:
   std::unique_ptr<T> fValue;
   SpinLock fSpinLock;
@@ -19,15 +19,26 @@
 #pragma once
 
 #include <atomic>
+#include <thread>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 /**
- * A simple implementation of a spin lock using the std::atomic_flag which is guaranteed to be atomic and lock free.
+ * A simple implementation of a spin lock using an atomic boolean which is guaranteed to be lock free.
  * The usage is the following:
  *
  * auto lock = spinLock.acquire();
  * ...
  *
  * the lock is released automatically when it exits the scope.
+ *
+ * While waiting for the lock, `acquire` spins (reading only, so that the cache line is not bounced between cores)
+ * with a cpu pause hint and an exponential backoff, and ends up yielding the thread if the lock is held for a
+ * long time. Real time code which cannot afford to wait should use `tryAcquire` instead (and skip the update when
+ * the lock is not available).
  */
 class SpinLock
 {
@@ -53,6 +64,13 @@ public:
     Lock(Lock const &) = delete;
     Lock& operator=(Lock const &) = delete;
 
+    /**
+     * @return `true` if the lock is held (always the case with `acquire`, not necessarily with `tryAcquire`) */
+    inline bool isLocked() const { return fSpinLock != nullptr; }
+
+    // operator bool (same as isLocked)
+    inline explicit operator bool() const { return isLocked(); }
+
   private:
     friend class SpinLock;
 
@@ -64,7 +82,7 @@ public:
     SpinLock *fSpinLock;
   };
 
-  SpinLock() : fFlag{false}
+  SpinLock() : fLocked{false}, fContentionCount{0}
   {
   }
 
@@ -73,14 +91,51 @@ public:
    */
   inline Lock acquire()
   {
-    while(fFlag.test_and_set(std::memory_order_acquire))
+    if(!tryLock())
     {
-      // nothing to do => spin
+      fContentionCount.fetch_add(1, std::memory_order_relaxed);
+
+      int spinCount = 1;
+      do
+      {
+        // wait for the lock to be released before trying to grab it again
+        while(fLocked.load(std::memory_order_relaxed))
+        {
+          if(spinCount <= kMaxSpinCount)
+          {
+            for(int i = 0; i < spinCount; i++)
+              pause();
+            spinCount *= 2;
+          }
+          else
+            std::this_thread::yield();
+        }
+      }
+      while(!tryLock());
     }
 
     return Lock(this);
   }
 
+  /**
+   * Tries to acquire the lock without waiting.
+   *
+   * @return the lock that will be released when it goes out of scope. Use `Lock::isLocked()` (or `operator bool`) to
+   *         check whether the lock was acquired
+   */
+  inline Lock tryAcquire()
+  {
+    if(tryLock())
+      return Lock(this);
+
+    fContentionCount.fetch_add(1, std::memory_order_relaxed);
+    return Lock(nullptr);
+  }
+
+  /**
+   * @return the number of times the lock was already held when `acquire` or `tryAcquire` was called (for
+   *         diagnostics) */
+  inline uint32_t getContentionCount() const { return fContentionCount.load(std::memory_order_relaxed); }
 
   SpinLock(SpinLock const &) = delete;
 
@@ -89,10 +144,33 @@ public:
 private:
   friend class Lock;
 
+  // max number of pauses before yielding (the number of pauses doubles at each iteration)
+  static constexpr int kMaxSpinCount = 64;
+
+  inline bool tryLock()
+  {
+    return !fLocked.load(std::memory_order_relaxed) && !fLocked.exchange(true, std::memory_order_acquire);
+  }
+
   inline void unlock()
   {
-    fFlag.clear(std::memory_order_release);
+    fLocked.store(false, std::memory_order_release);
+  }
+
+  // hint to the cpu that this is a spin loop
+  static inline void pause()
+  {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(_MSC_VER) && (defined(_M_ARM64) || defined(_M_ARM))
+    __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
   }
 
-  std::atomic_flag fFlag;
+  std::atomic<bool> fLocked;
+  std::atomic<uint32_t> fContentionCount;
 };
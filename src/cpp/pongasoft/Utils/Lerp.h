@@ -19,8 +19,143 @@
 
 #include "Misc.h"
 
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JAMBA_LERP_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define JAMBA_LERP_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace pongasoft::Utils {
 
+namespace Impl {
+
+/**
+ * Array kernels used by the array versions of `Lerp::computeY`, `Lerp::mapValues` and `clampRange`. The baseline
+ * instruction set of the platform is used (SSE2 on x86_64, NEON on arm64), the remaining elements (or all of them on
+ * other platforms) being processed one at a time.
+ */
+struct LerpKernels
+{
+  // oY[i] = iX[i] * iA + iB (iX clamped to [iLower, iUpper] first when Clamp is true)
+  template<bool Clamp>
+  static inline void lerp(float const *iX, float *oY, int iCount, float iA, float iB, float iLower, float iUpper)
+  {
+    int i = 0;
+#if JAMBA_LERP_SSE2
+    auto const a = _mm_set1_ps(iA), b = _mm_set1_ps(iB), lower = _mm_set1_ps(iLower), upper = _mm_set1_ps(iUpper);
+    for(; i + 4 <= iCount; i += 4)
+    {
+      auto x = _mm_loadu_ps(iX + i);
+      if constexpr(Clamp)
+        x = _mm_min_ps(_mm_max_ps(x, lower), upper);
+      _mm_storeu_ps(oY + i, _mm_add_ps(_mm_mul_ps(x, a), b));
+    }
+#elif JAMBA_LERP_NEON
+    auto const a = vdupq_n_f32(iA), b = vdupq_n_f32(iB), lower = vdupq_n_f32(iLower), upper = vdupq_n_f32(iUpper);
+    for(; i + 4 <= iCount; i += 4)
+    {
+      auto x = vld1q_f32(iX + i);
+      if constexpr(Clamp)
+        x = vminq_f32(vmaxq_f32(x, lower), upper);
+      vst1q_f32(oY + i, vaddq_f32(vmulq_f32(x, a), b));
+    }
+#endif
+    for(; i < iCount; i++)
+      oY[i] = (Clamp ? Utils::clamp(iX[i], iLower, iUpper) : iX[i]) * iA + iB;
+  }
+
+  // oY[i] = iX[i] * iA + iB (iX clamped to [iLower, iUpper] first when Clamp is true)
+  template<bool Clamp>
+  static inline void lerp(double const *iX, double *oY, int iCount, double iA, double iB, double iLower, double iUpper)
+  {
+    int i = 0;
+#if JAMBA_LERP_SSE2
+    auto const a = _mm_set1_pd(iA), b = _mm_set1_pd(iB), lower = _mm_set1_pd(iLower), upper = _mm_set1_pd(iUpper);
+    for(; i + 2 <= iCount; i += 2)
+    {
+      auto x = _mm_loadu_pd(iX + i);
+      if constexpr(Clamp)
+        x = _mm_min_pd(_mm_max_pd(x, lower), upper);
+      _mm_storeu_pd(oY + i, _mm_add_pd(_mm_mul_pd(x, a), b));
+    }
+#elif JAMBA_LERP_NEON
+    auto const a = vdupq_n_f64(iA), b = vdupq_n_f64(iB), lower = vdupq_n_f64(iLower), upper = vdupq_n_f64(iUpper);
+    for(; i + 2 <= iCount; i += 2)
+    {
+      auto x = vld1q_f64(iX + i);
+      if constexpr(Clamp)
+        x = vminq_f64(vmaxq_f64(x, lower), upper);
+      vst1q_f64(oY + i, vaddq_f64(vmulq_f64(x, a), b));
+    }
+#endif
+    for(; i < iCount; i++)
+      oY[i] = (Clamp ? Utils::clamp(iX[i], iLower, iUpper) : iX[i]) * iA + iB;
+  }
+
+  // oY[i] = clamp(iX[i], iLower, iUpper)
+  static inline void clamp(float const *iX, float *oY, int iCount, float iLower, float iUpper)
+  {
+    int i = 0;
+#if JAMBA_LERP_SSE2
+    auto const lower = _mm_set1_ps(iLower), upper = _mm_set1_ps(iUpper);
+    for(; i + 4 <= iCount; i += 4)
+      _mm_storeu_ps(oY + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(iX + i), lower), upper));
+#elif JAMBA_LERP_NEON
+    auto const lower = vdupq_n_f32(iLower), upper = vdupq_n_f32(iUpper);
+    for(; i + 4 <= iCount; i += 4)
+      vst1q_f32(oY + i, vminq_f32(vmaxq_f32(vld1q_f32(iX + i), lower), upper));
+#endif
+    for(; i < iCount; i++)
+      oY[i] = Utils::clamp(iX[i], iLower, iUpper);
+  }
+
+  // oY[i] = clamp(iX[i], iLower, iUpper)
+  static inline void clamp(double const *iX, double *oY, int iCount, double iLower, double iUpper)
+  {
+    int i = 0;
+#if JAMBA_LERP_SSE2
+    auto const lower = _mm_set1_pd(iLower), upper = _mm_set1_pd(iUpper);
+    for(; i + 2 <= iCount; i += 2)
+      _mm_storeu_pd(oY + i, _mm_min_pd(_mm_max_pd(_mm_loadu_pd(iX + i), lower), upper));
+#elif JAMBA_LERP_NEON
+    auto const lower = vdupq_n_f64(iLower), upper = vdupq_n_f64(iUpper);
+    for(; i + 2 <= iCount; i += 2)
+      vst1q_f64(oY + i, vminq_f64(vmaxq_f64(vld1q_f64(iX + i), lower), upper));
+#endif
+    for(; i < iCount; i++)
+      oY[i] = Utils::clamp(iX[i], iLower, iUpper);
+  }
+
+};
+
+}
+
+/**
+ * Array version of `clampRange`: `oValues[i] = clampRange(iValues[i], iFrom, iTo)` for `i` in `[0, iCount[`
+ * (`iValues` and `oValues` can be the same array). Vectorized for `float` and `double`.
+ */
+template <typename T>
+inline static void clampRange(T const *iValues, T *oValues, int iCount, T iFrom, T iTo)
+{
+  auto lower = std::min(iFrom, iTo);
+  auto upper = std::max(iFrom, iTo);
+
+  if constexpr(std::is_same_v<T, float> || std::is_same_v<T, double>)
+  {
+    Impl::LerpKernels::clamp(iValues, oValues, iCount, lower, upper);
+  }
+  else
+  {
+    for(int i = 0; i < iCount; i++)
+      oValues[i] = clamp(iValues[i], lower, upper);
+  }
+}
+
 /**
  * Util class to compute linear interpolation. Use SPLerp/DPLerp and mapValueSP/mapRangeSP (resp mapValueDP/mapRangeDP)
  * for convenience.
@@ -51,6 +186,23 @@ public:
     return static_cast<X>((static_cast<TFloat>(iY) - fB) / fA);
   }
 
+  /**
+   * Array version of `computeY`: `oY[i] = computeY(iX[i])` for `i` in `[0, iCount[` (`iX` and `oY` can be the same
+   * array). Vectorized when `TFloat`, `X` and `Y` are all `float` or all `double` (ex: `SPLerp` or `DPLerp`).
+   */
+  inline void computeY(X const *iX, Y *oY, int iCount) const
+  {
+    if constexpr(kVectorized)
+    {
+      Impl::LerpKernels::lerp<false>(iX, oY, iCount, fA, fB, TFloat{}, TFloat{});
+    }
+    else
+    {
+      for(int i = 0; i < iCount; i++)
+        oY[i] = computeY(iX[i]);
+    }
+  }
+
   /**
    * Inspired by the `map` function in Processing language, another way to look at Lerp is to map a range of values
    * into another range: `[iFromLow, iFromHigh] -> [iToLow, iToHigh]`. Note that low can be greater than high: for
@@ -94,6 +246,56 @@ public:
     return Lerp(iFromLow, iToLow, iFromHigh, iToHigh).computeY(iValue);
   }
 
+  /**
+   * Array version of `mapValue`: `oValues[i] = mapValue(iValues[i], ...)` for `i` in `[0, iCount[` (`iValues` and
+   * `oValues` can be the same array). The lerp is computed only once and the computation is vectorized when `TFloat`,
+   * `X` and `Y` are all `float` or all `double` (ex: mapping a whole buffer of samples into display coordinates).
+   */
+  static void mapValues(X const *iValues, Y *oValues, int iCount,
+                        X iFromLow, X iFromHigh, Y iToLow, Y iToHigh, bool iClamp = true)
+  {
+    // if the first range is empty (computation would be dividing by 0)
+    if(iFromLow == iFromHigh)
+    {
+      for(int i = 0; i < iCount; i++)
+        oValues[i] = iValues[i] <= iFromLow ? iToLow : iToHigh;
+      return;
+    }
+
+    // if the second range is empty, no need for computation
+    if(iToLow == iToHigh)
+    {
+      std::fill(oValues, oValues + iCount, iToLow);
+      return;
+    }
+
+    Lerp const lerp(iFromLow, iToLow, iFromHigh, iToHigh);
+
+    if(!iClamp)
+    {
+      lerp.computeY(iValues, oValues, iCount);
+      return;
+    }
+
+    auto lower = std::min(iFromLow, iFromHigh);
+    auto upper = std::max(iFromLow, iFromHigh);
+
+    if constexpr(kVectorized)
+    {
+      Impl::LerpKernels::lerp<true>(iValues, oValues, iCount, lerp.fA, lerp.fB, lower, upper);
+    }
+    else
+    {
+      for(int i = 0; i < iCount; i++)
+        oValues[i] = lerp.computeY(clamp(iValues[i], lower, upper));
+    }
+  }
+
+private:
+  // true when the array versions can use the vectorized kernels
+  static constexpr bool kVectorized = (std::is_same_v<TFloat, float> || std::is_same_v<TFloat, double>) &&
+                                      std::is_same_v<TFloat, X> && std::is_same_v<TFloat, Y>;
+
 private:
   const TFloat fA;
   const TFloat fB;
@@ -160,6 +362,14 @@ inline static float mapValueSP(float iValue, float iFromLow, float iFromHigh, fl
   return SPLerp::mapValue(iValue, iFromLow, iFromHigh, iToLow, iToHigh, iClamp);
 }
 
+/**
+ * Convenient shortcut for single precision (vectorized). See Lerp::mapValues */
+inline static void mapValuesSP(float const *iValues, float *oValues, int iCount,
+                               float iFromLow, float iFromHigh, float iToLow, float iToHigh, bool iClamp = true)
+{
+  SPLerp::mapValues(iValues, oValues, iCount, iFromLow, iFromHigh, iToLow, iToHigh, iClamp);
+}
+
 
 //------------------------------------------------------------------------
 // DPLerp - Double Precision Lerp (double)
@@ -222,6 +432,14 @@ inline static double mapValueDP(double iValue, double iFromLow, double iFromHigh
   return DPLerp::mapValue(iValue, iFromLow, iFromHigh, iToLow, iToHigh, iClamp);
 }
 
+/**
+ * Convenient shortcut for double precision (vectorized). See Lerp::mapValues */
+inline static void mapValuesDP(double const *iValues, double *oValues, int iCount,
+                               double iFromLow, double iFromHigh, double iToLow, double iToHigh, bool iClamp = true)
+{
+  DPLerp::mapValues(iValues, oValues, iCount, iFromLow, iFromHigh, iToLow, iToHigh, iClamp);
+}
+
 /**
  * Defines a range of values.
  */
@@ -20,8 +20,12 @@
 #include <pluginterfaces/vst/ivstaudioprocessor.h>
 #include <pongasoft/logging/logging.h>
 #include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 #include "AudioUtils.h"
+#include "AudioKernels.h"
 
 namespace pongasoft {
 namespace VST {
@@ -159,7 +163,76 @@ public:
      */
     inline SampleType absoluteMax() const
     {
-      return forEachSample(AbsoluteMaxOp()).fAbsoluteMax;
+      auto buffer = getBuffer();
+      return buffer ? AudioKernels::absoluteMax(buffer, getNumSamples()) : 0;
+    }
+
+    /**
+     * @return the root mean square of the samples of this channel
+     */
+    inline SampleType rms() const
+    {
+      auto buffer = getBuffer();
+      return buffer ? AudioKernels::rms(buffer, getNumSamples()) : 0;
+    }
+
+    /**
+     * Computes whether this channel is silent by looking at the samples (and not the silence flag) and adjusts the
+     * silence flag accordingly.
+     *
+     * @return true if the channel is silent
+     */
+    inline bool adjustSilenceFlag()
+    {
+      auto buffer = getBuffer();
+      bool silent = !buffer || AudioKernels::isSilent(buffer, getNumSamples());
+      setSilenceFlag(silent);
+      return silent;
+    }
+
+    /**
+     * Multiplies every sample of this channel by `iGain`
+     */
+    inline void applyGain(SampleType iGain)
+    {
+      auto buffer = getBuffer();
+      if(buffer)
+        AudioKernels::applyGain(buffer, getNumSamples(), iGain);
+    }
+
+    /**
+     * Copy the content of the provided channel to THIS channel (up to num samples) multiplying each sample by
+     * `iGain`
+     */
+    tresult copyFromWithGain(Channel const &iFromChannel, SampleType iGain)
+    {
+      auto ptrFrom = iFromChannel.getBuffer();
+      auto ptrTo = getBuffer();
+
+      // sanity check
+      if(!ptrFrom || !ptrTo)
+        return kResultFalse;
+
+      AudioKernels::copyWithGain(ptrFrom, ptrTo, std::min(getNumSamples(), iFromChannel.getNumSamples()), iGain);
+
+      return kResultOk;
+    }
+
+    /**
+     * Adds the content of the provided channel (multiplied by `iGain`) to THIS channel (up to num samples)
+     */
+    tresult mixFrom(Channel const &iFromChannel, SampleType iGain = 1)
+    {
+      auto ptrFrom = iFromChannel.getBuffer();
+      auto ptrTo = getBuffer();
+
+      // sanity check
+      if(!ptrFrom || !ptrTo)
+        return kResultFalse;
+
+      AudioKernels::mix(ptrFrom, ptrTo, std::min(getNumSamples(), iFromChannel.getNumSamples()), iGain);
+
+      return kResultOk;
     }
 
     /**
@@ -304,22 +377,12 @@ public:
 
     for(int32 channel = 0; channel < getNumChannels(); channel++)
     {
-      bool silent = true;
-
       auto ptr = buffer[channel];
 
       if(!ptr)
         continue;
 
-      for(int j = 0; j < getNumSamples(); ++j, ptr++)
-      {
-        auto sample = *ptr;
-
-        if(silent && !pongasoft::VST::isSilent(sample))
-          silent = false;
-      }
-
-      if(silent)
+      if(AudioKernels::isSilent(ptr, getNumSamples()))
         BIT_SET(silenceFlags, channel);
     }
 
@@ -546,7 +609,53 @@ public:
    */
   inline SampleType absoluteMax() const
   {
-    return forEachSample(AbsoluteMaxOp()).fAbsoluteMax;
+    SampleType res = 0;
+    for(int32 channel = 0; channel < getNumChannels(); channel++)
+    {
+      res = std::max(res, getAudioChannel(channel).absoluteMax());
+    }
+    return res;
+  }
+
+  /**
+   * Multiplies every sample of every channel by `iGain`
+   */
+  inline void applyGain(SampleType iGain)
+  {
+    for(int32 channel = 0; channel < getNumChannels(); channel++)
+    {
+      getAudioChannel(channel).applyGain(iGain);
+    }
+  }
+
+  /**
+   * Copy the content of the provided buffer to THIS buffer (up to num samples) multiplying each sample by `iGain`
+   */
+  tresult copyFromWithGain(class_type const &iFromBuffer, SampleType iGain)
+  {
+    int32 numChannels = std::min(getNumChannels(), iFromBuffer.getNumChannels());
+
+    for(int32 channel = 0; channel < numChannels; channel++)
+    {
+      getAudioChannel(channel).copyFromWithGain(iFromBuffer.getAudioChannel(channel), iGain);
+    }
+
+    return kResultOk;
+  }
+
+  /**
+   * Adds the content of the provided buffer (multiplied by `iGain`) to THIS buffer (up to num samples)
+   */
+  tresult mixFrom(class_type const &iFromBuffer, SampleType iGain = 1)
+  {
+    int32 numChannels = std::min(getNumChannels(), iFromBuffer.getNumChannels());
+
+    for(int32 channel = 0; channel < numChannels; channel++)
+    {
+      getAudioChannel(channel).mixFrom(iFromBuffer.getAudioChannel(channel), iGain);
+    }
+
+    return kResultOk;
   }
 
   /**
@@ -581,5 +690,95 @@ inline Sample64 **AudioBuffers<Sample64>::getBuffer() { return fBuffer.channelBu
 typedef AudioBuffers<Sample32> AudioBuffers32;
 typedef AudioBuffers<Sample64> AudioBuffers64;
 
+namespace Impl {
+
+/**
+ * (Internal) storage for `OwnedAudioBuffers`: it is a separate (base) class so that it is fully constructed before
+ * the `AudioBuffers` part (which keeps a reference to `fBus`) */
+template<typename SampleType>
+class AudioBuffersStorage
+{
+public:
+  static constexpr size_t kAlignment = 64;
+
+  AudioBuffersStorage(int32 iNumChannels, int32 iNumSamples) :
+    fChannels(static_cast<size_t>(std::max(iNumChannels, 0)))
+  {
+    // each channel starts on an aligned boundary (its size is rounded up to a multiple of kAlignment)
+    constexpr size_t kSamplesPerAlignment = kAlignment / sizeof(SampleType);
+    auto numSamplesPerChannel = static_cast<size_t>(std::max(iNumSamples, 0));
+    fChannelStride = (numSamplesPerChannel + kSamplesPerAlignment - 1) / kSamplesPerAlignment * kSamplesPerAlignment;
+
+    auto numSamples = fChannelStride * fChannels.size();
+    fMemory = std::make_unique<SampleType[]>(numSamples + kSamplesPerAlignment);
+    void *memory = fMemory.get();
+    auto space = (numSamples + kSamplesPerAlignment) * sizeof(SampleType);
+    auto aligned = static_cast<SampleType *>(std::align(kAlignment, numSamples * sizeof(SampleType), memory, space));
+
+    for(size_t c = 0; c < fChannels.size(); c++)
+      fChannels[c] = aligned + c * fChannelStride;
+
+    fBus.numChannels = static_cast<int32>(fChannels.size());
+    fBus.silenceFlags = fChannels.size() >= 64 ? ~static_cast<uint64>(0) :
+                        (static_cast<uint64>(1) << fChannels.size()) - 1;
+    if constexpr(std::is_same_v<SampleType, Sample32>)
+      fBus.channelBuffers32 = fChannels.data();
+    else
+      fBus.channelBuffers64 = fChannels.data();
+  }
+
+protected:
+  AudioBusBuffers fBus{};
+  std::vector<SampleType *> fChannels;
+  size_t fChannelStride{};
+  std::unique_ptr<SampleType[]> fMemory{};
+};
+
+}
+
+/**
+ * Contrary to `AudioBuffers` which wraps buffers provided by the host, this class owns its memory: all the channels
+ * are allocated (and cleared) in the constructor, in one block, and each channel is aligned on a 64 bytes boundary
+ * (which lets the compiler and the simd kernels use their aligned fast paths). Since it is an `AudioBuffers`, the
+ * exact same api is available (`getAudioChannel`, `forEachSample`, `copyFrom`...) and it can be passed wherever an
+ * `AudioBuffers` is expected.
+ *
+ * The number of channels and samples is fixed at construction (which allocates memory and as a result should not
+ * happen in the RT thread: typically the buffers are created in `setupProcessing`, based on `maxSamplesPerBlock`).
+ * Use `view` to work with fewer samples (for example the number of samples of the current frame).
+ *
+ * @tparam SampleType
+ */
+template<typename SampleType>
+class OwnedAudioBuffers : private Impl::AudioBuffersStorage<SampleType>, public AudioBuffers<SampleType>
+{
+  using storage_type = Impl::AudioBuffersStorage<SampleType>;
+
+public:
+  using storage_type::kAlignment;
+
+  OwnedAudioBuffers(int32 iNumChannels, int32 iNumSamples) :
+    storage_type(iNumChannels, iNumSamples),
+    AudioBuffers<SampleType>(storage_type::fBus, std::max(iNumSamples, 0))
+  {
+    this->clear();
+  }
+
+  // the AudioBuffers part refers to the storage part so it cannot be copied or moved
+  OwnedAudioBuffers(OwnedAudioBuffers const &) = delete;
+  OwnedAudioBuffers &operator=(OwnedAudioBuffers const &) = delete;
+
+  /**
+   * @return a view over the first `iNumSamples` samples (clamped to `getNumSamples()`) of these buffers (which
+   *         shares the same silence flags) */
+  inline AudioBuffers<SampleType> view(int32 iNumSamples)
+  {
+    return AudioBuffers<SampleType>(storage_type::fBus, std::clamp(iNumSamples, 0, this->getNumSamples()));
+  }
+};
+
+typedef OwnedAudioBuffers<Sample32> OwnedAudioBuffers32;
+typedef OwnedAudioBuffers<Sample64> OwnedAudioBuffers64;
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,769 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#include "AudioKernels.h"
+#include "AudioUtils.h"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JAMBA_KERNELS_SSE2 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define JAMBA_KERNELS_AVX2_TARGET
+#else
+#define JAMBA_KERNELS_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define JAMBA_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace pongasoft::VST::AudioKernels {
+
+namespace {
+
+//------------------------------------------------------------------------
+// Scalar implementation (also used for the tail of the vectorized versions)
+//------------------------------------------------------------------------
+struct Scalar
+{
+  template<typename T>
+  static bool isSilent(T const *iBuffer, int32 iNumSamples)
+  {
+    for(int32 i = 0; i < iNumSamples; i++)
+    {
+      if(!pongasoft::VST::isSilent(iBuffer[i]))
+        return false;
+    }
+    return true;
+  }
+
+  template<typename T>
+  static T absoluteMax(T const *iBuffer, int32 iNumSamples)
+  {
+    T res = 0;
+    for(int32 i = 0; i < iNumSamples; i++)
+      res = std::max(res, std::abs(iBuffer[i]));
+    return res;
+  }
+
+  template<typename T>
+  static T sumOfSquares(T const *iBuffer, int32 iNumSamples)
+  {
+    T res = 0;
+    for(int32 i = 0; i < iNumSamples; i++)
+      res += iBuffer[i] * iBuffer[i];
+    return res;
+  }
+
+  template<typename T>
+  static void applyGain(T *ioBuffer, int32 iNumSamples, T iGain)
+  {
+    for(int32 i = 0; i < iNumSamples; i++)
+      ioBuffer[i] *= iGain;
+  }
+
+  template<typename T>
+  static void copyWithGain(T const *iBuffer, T *oBuffer, int32 iNumSamples, T iGain)
+  {
+    for(int32 i = 0; i < iNumSamples; i++)
+      oBuffer[i] = iBuffer[i] * iGain;
+  }
+
+  template<typename T>
+  static void mix(T const *iBuffer, T *ioBuffer, int32 iNumSamples, T iGain)
+  {
+    for(int32 i = 0; i < iNumSamples; i++)
+      ioBuffer[i] += iBuffer[i] * iGain;
+  }
+
+  template<typename T>
+  static void dbToSample(T const *iBuffer, T *oBuffer, int32 iNumSamples)
+  {
+    for(int32 i = 0; i < iNumSamples; i++)
+      oBuffer[i] = pongasoft::VST::dbToSample<T>(iBuffer[i]);
+  }
+
+  template<typename T>
+  static void sampleToDb(T const *iBuffer, T *oBuffer, int32 iNumSamples)
+  {
+    for(int32 i = 0; i < iNumSamples; i++)
+    {
+      auto sample = std::max(iBuffer[i], std::numeric_limits<T>::min());
+      oBuffer[i] = static_cast<T>(pongasoft::VST::sampleToDb<T>(sample));
+    }
+  }
+};
+
+//------------------------------------------------------------------------
+// Polynomial approximations used by the vectorized versions of dbToSample / sampleToDb (V provides the primitives)
+//------------------------------------------------------------------------
+namespace FastMath {
+
+constexpr double kLog2Of10 = 3.32192809488736234787;
+constexpr double kLog10Of2 = 0.30102999566398119521;
+constexpr double kSqrt2 = 1.41421356237309504880;
+
+// 2^f for f in [-0.5, 0.5]: Taylor series of e^(f * ln(2)) (degree 7, relative error < 1e-8)
+template<typename V, typename Vec>
+inline Vec exp2Polynomial(Vec f)
+{
+  auto p = V::set1(static_cast<typename V::T>(1.525273380405984e-05));
+  p = V::add(V::mul(p, f), V::set1(static_cast<typename V::T>(1.5403530393381608e-04)));
+  p = V::add(V::mul(p, f), V::set1(static_cast<typename V::T>(1.3333558146428443e-03)));
+  p = V::add(V::mul(p, f), V::set1(static_cast<typename V::T>(9.618129107628477e-03)));
+  p = V::add(V::mul(p, f), V::set1(static_cast<typename V::T>(5.550410866482158e-02)));
+  p = V::add(V::mul(p, f), V::set1(static_cast<typename V::T>(2.402265069591007e-01)));
+  p = V::add(V::mul(p, f), V::set1(static_cast<typename V::T>(6.931471805599453e-01)));
+  return V::add(V::mul(p, f), V::set1(static_cast<typename V::T>(1)));
+}
+
+// log2(m) for m in [sqrt(1/2), sqrt(2)]: 2/ln(2) * atanh(t) with t = (m - 1) / (m + 1) in [-0.172, 0.172]
+// (degree 9, absolute error < 1e-9)
+template<typename V, typename Vec>
+inline Vec log2Polynomial(Vec m)
+{
+  auto const one = V::set1(static_cast<typename V::T>(1));
+  auto t = V::div(V::sub(m, one), V::add(m, one));
+  auto t2 = V::mul(t, t);
+  auto p = V::set1(static_cast<typename V::T>(0.32059889797774194));  // 2 / (9 * ln(2))
+  p = V::add(V::mul(p, t2), V::set1(static_cast<typename V::T>(0.41219858311423964))); // 2 / (7 * ln(2))
+  p = V::add(V::mul(p, t2), V::set1(static_cast<typename V::T>(0.57707801635993550))); // 2 / (5 * ln(2))
+  p = V::add(V::mul(p, t2), V::set1(static_cast<typename V::T>(0.96179669392655917))); // 2 / (3 * ln(2))
+  p = V::add(V::mul(p, t2), V::set1(static_cast<typename V::T>(2.88539008177792681))); // 2 / ln(2)
+  return V::mul(p, t);
+}
+
+}
+
+//------------------------------------------------------------------------
+// Generic vectorized implementation for the baseline instruction sets (SSE2 / NEON) where V provides the
+// primitives for a given vector type
+//------------------------------------------------------------------------
+template<typename V>
+struct Vectorized
+{
+  using T = typename V::T;
+  static constexpr int32 W = V::kWidth;
+
+  static bool isSilent(T const *iBuffer, int32 iNumSamples)
+  {
+    auto const threshold = V::set1(getSampleSilentThreshold<T>());
+    int32 i = 0;
+    for(; i + W <= iNumSamples; i += W)
+    {
+      // implementation note: using <= (and not >) so that NaN is not considered silent (same as scalar)
+      if(!V::allLessEqual(V::abs(V::load(iBuffer + i)), threshold))
+        return false;
+    }
+    return Scalar::isSilent(iBuffer + i, iNumSamples - i);
+  }
+
+  static T absoluteMax(T const *iBuffer, int32 iNumSamples)
+  {
+    auto max = V::zero();
+    int32 i = 0;
+    for(; i + W <= iNumSamples; i += W)
+      max = V::max(max, V::abs(V::load(iBuffer + i)));
+    return std::max(V::horizontalMax(max), Scalar::absoluteMax(iBuffer + i, iNumSamples - i));
+  }
+
+  static T sumOfSquares(T const *iBuffer, int32 iNumSamples)
+  {
+    auto sum = V::zero();
+    int32 i = 0;
+    for(; i + W <= iNumSamples; i += W)
+    {
+      auto v = V::load(iBuffer + i);
+      sum = V::add(sum, V::mul(v, v));
+    }
+    return V::horizontalSum(sum) + Scalar::sumOfSquares(iBuffer + i, iNumSamples - i);
+  }
+
+  static void applyGain(T *ioBuffer, int32 iNumSamples, T iGain)
+  {
+    auto const gain = V::set1(iGain);
+    int32 i = 0;
+    for(; i + W <= iNumSamples; i += W)
+      V::store(ioBuffer + i, V::mul(V::load(ioBuffer + i), gain));
+    Scalar::applyGain(ioBuffer + i, iNumSamples - i, iGain);
+  }
+
+  static void copyWithGain(T const *iBuffer, T *oBuffer, int32 iNumSamples, T iGain)
+  {
+    auto const gain = V::set1(iGain);
+    int32 i = 0;
+    for(; i + W <= iNumSamples; i += W)
+      V::store(oBuffer + i, V::mul(V::load(iBuffer + i), gain));
+    Scalar::copyWithGain(iBuffer + i, oBuffer + i, iNumSamples - i, iGain);
+  }
+
+  static void mix(T const *iBuffer, T *ioBuffer, int32 iNumSamples, T iGain)
+  {
+    auto const gain = V::set1(iGain);
+    int32 i = 0;
+    for(; i + W <= iNumSamples; i += W)
+      V::store(ioBuffer + i, V::add(V::load(ioBuffer + i), V::mul(V::load(iBuffer + i), gain)));
+    Scalar::mix(iBuffer + i, ioBuffer + i, iNumSamples - i, iGain);
+  }
+
+  static void dbToSample(T const *iBuffer, T *oBuffer, int32 iNumSamples)
+  {
+    // 10^(x/20) = 2^(x * log2(10) / 20)
+    auto const scale = V::set1(static_cast<T>(FastMath::kLog2Of10 / 20.0));
+    int32 i = 0;
+    for(; i + W <= iNumSamples; i += W)
+      V::store(oBuffer + i, V::exp2(V::mul(V::load(iBuffer + i), scale)));
+    Scalar::dbToSample(iBuffer + i, oBuffer + i, iNumSamples - i);
+  }
+
+  static void sampleToDb(T const *iBuffer, T *oBuffer, int32 iNumSamples)
+  {
+    // 20 * log10(x) = 20 * log10(2) * log2(x)
+    auto const scale = V::set1(static_cast<T>(20.0 * FastMath::kLog10Of2));
+    auto const min = V::set1(std::numeric_limits<T>::min());
+    int32 i = 0;
+    for(; i + W <= iNumSamples; i += W)
+      V::store(oBuffer + i, V::mul(V::log2(V::max(V::load(iBuffer + i), min)), scale));
+    Scalar::sampleToDb(iBuffer + i, oBuffer + i, iNumSamples - i);
+  }
+};
+
+#if JAMBA_KERNELS_SSE2
+//------------------------------------------------------------------------
+// SSE2 primitives
+//------------------------------------------------------------------------
+struct SSE2Float
+{
+  using T = Sample32;
+  static constexpr int32 kWidth = 4;
+  static inline __m128 load(T const *p) { return _mm_loadu_ps(p); }
+  static inline void store(T *p, __m128 v) { _mm_storeu_ps(p, v); }
+  static inline __m128 set1(T v) { return _mm_set1_ps(v); }
+  static inline __m128 zero() { return _mm_setzero_ps(); }
+  static inline __m128 abs(__m128 v) { return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff))); }
+  static inline __m128 add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+  static inline __m128 mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+  static inline __m128 sub(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+  static inline __m128 div(__m128 a, __m128 b) { return _mm_div_ps(a, b); }
+  static inline __m128 max(__m128 a, __m128 b) { return _mm_max_ps(a, b); }
+  static inline bool allLessEqual(__m128 a, __m128 b) { return _mm_movemask_ps(_mm_cmple_ps(a, b)) == 0xF; }
+  static inline T horizontalMax(__m128 v)
+  {
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(v);
+  }
+  static inline T horizontalSum(__m128 v)
+  {
+    v = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(v);
+  }
+  // 2^x = 2^n * 2^f with n = round(x) (built directly in the exponent bits) and f in [-0.5, 0.5]
+  // implementation note: _mm_min_ps/_mm_max_ps return their second operand when one is NaN, so the clamp turns NaN
+  // into 127 => NaN lanes are restored at the end (NaN in, NaN out like std::exp2)
+  static inline __m128 exp2(__m128 x)
+  {
+    auto nan = _mm_cmpunord_ps(x, x);
+    auto c = _mm_max_ps(_mm_min_ps(x, _mm_set1_ps(127.0f)), _mm_set1_ps(-126.0f));
+    auto n = _mm_cvtps_epi32(c);
+    auto f = _mm_sub_ps(c, _mm_cvtepi32_ps(n));
+    auto pow2n = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+    auto res = _mm_mul_ps(FastMath::exp2Polynomial<SSE2Float>(f), pow2n);
+    return _mm_or_ps(_mm_andnot_ps(nan, res), _mm_and_ps(nan, x));
+  }
+  // log2(x) = e + log2(m) with x = 2^e * m (x must be a positive normal number)
+  static inline __m128 log2(__m128 x)
+  {
+    auto bits = _mm_castps_si128(x);
+    auto e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+    auto m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)),
+                                           _mm_set1_epi32(0x3f800000)));
+    // m in [1, 2[ => [sqrt(1/2), sqrt(2)[ (where the polynomial is the most accurate)
+    auto big = _mm_cmpgt_ps(m, _mm_set1_ps(static_cast<T>(FastMath::kSqrt2)));
+    m = _mm_mul_ps(m, _mm_sub_ps(_mm_set1_ps(1.0f), _mm_and_ps(big, _mm_set1_ps(0.5f))));
+    auto ef = _mm_add_ps(_mm_cvtepi32_ps(e), _mm_and_ps(big, _mm_set1_ps(1.0f)));
+    return _mm_add_ps(ef, FastMath::log2Polynomial<SSE2Float>(m));
+  }
+};
+
+struct SSE2Double
+{
+  using T = Sample64;
+  static constexpr int32 kWidth = 2;
+  static inline __m128d load(T const *p) { return _mm_loadu_pd(p); }
+  static inline void store(T *p, __m128d v) { _mm_storeu_pd(p, v); }
+  static inline __m128d set1(T v) { return _mm_set1_pd(v); }
+  static inline __m128d zero() { return _mm_setzero_pd(); }
+  static inline __m128d abs(__m128d v) { return _mm_and_pd(v, _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL))); }
+  static inline __m128d add(__m128d a, __m128d b) { return _mm_add_pd(a, b); }
+  static inline __m128d mul(__m128d a, __m128d b) { return _mm_mul_pd(a, b); }
+  static inline __m128d max(__m128d a, __m128d b) { return _mm_max_pd(a, b); }
+  static inline bool allLessEqual(__m128d a, __m128d b) { return _mm_movemask_pd(_mm_cmple_pd(a, b)) == 0x3; }
+  static inline T horizontalMax(__m128d v) { return _mm_cvtsd_f64(_mm_max_pd(v, _mm_unpackhi_pd(v, v))); }
+  static inline T horizontalSum(__m128d v) { return _mm_cvtsd_f64(_mm_add_pd(v, _mm_unpackhi_pd(v, v))); }
+  // no approximation in double precision (lane by lane)
+  static inline __m128d exp2(__m128d v)
+  {
+    return _mm_set_pd(std::exp2(_mm_cvtsd_f64(_mm_unpackhi_pd(v, v))), std::exp2(_mm_cvtsd_f64(v)));
+  }
+  static inline __m128d log2(__m128d v)
+  {
+    return _mm_set_pd(std::log2(_mm_cvtsd_f64(_mm_unpackhi_pd(v, v))), std::log2(_mm_cvtsd_f64(v)));
+  }
+};
+
+//------------------------------------------------------------------------
+// AVX2 implementation (compiled for AVX2 but only used when the cpu supports it)
+//------------------------------------------------------------------------
+struct AVX2
+{
+  JAMBA_KERNELS_AVX2_TARGET static bool isSilent(Sample32 const *iBuffer, int32 iNumSamples)
+  {
+    auto const mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    auto const threshold = _mm256_set1_ps(Sample32SilentThreshold);
+    int32 i = 0;
+    for(; i + 8 <= iNumSamples; i += 8)
+    {
+      auto v = _mm256_and_ps(_mm256_loadu_ps(iBuffer + i), mask);
+      if(_mm256_movemask_ps(_mm256_cmp_ps(v, threshold, _CMP_LE_OQ)) != 0xFF)
+        return false;
+    }
+    return Scalar::isSilent(iBuffer + i, iNumSamples - i);
+  }
+
+  JAMBA_KERNELS_AVX2_TARGET static bool isSilent(Sample64 const *iBuffer, int32 iNumSamples)
+  {
+    auto const mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    auto const threshold = _mm256_set1_pd(Sample64SilentThreshold);
+    int32 i = 0;
+    for(; i + 4 <= iNumSamples; i += 4)
+    {
+      auto v = _mm256_and_pd(_mm256_loadu_pd(iBuffer + i), mask);
+      if(_mm256_movemask_pd(_mm256_cmp_pd(v, threshold, _CMP_LE_OQ)) != 0xF)
+        return false;
+    }
+    return Scalar::isSilent(iBuffer + i, iNumSamples - i);
+  }
+
+  JAMBA_KERNELS_AVX2_TARGET static Sample32 absoluteMax(Sample32 const *iBuffer, int32 iNumSamples)
+  {
+    auto const mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    auto max = _mm256_setzero_ps();
+    int32 i = 0;
+    for(; i + 8 <= iNumSamples; i += 8)
+      max = _mm256_max_ps(max, _mm256_and_ps(_mm256_loadu_ps(iBuffer + i), mask));
+    auto max128 = _mm_max_ps(_mm256_castps256_ps128(max), _mm256_extractf128_ps(max, 1));
+    return std::max(SSE2Float::horizontalMax(max128), Scalar::absoluteMax(iBuffer + i, iNumSamples - i));
+  }
+
+  JAMBA_KERNELS_AVX2_TARGET static Sample64 absoluteMax(Sample64 const *iBuffer, int32 iNumSamples)
+  {
+    auto const mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    auto max = _mm256_setzero_pd();
+    int32 i = 0;
+    for(; i + 4 <= iNumSamples; i += 4)
+      max = _mm256_max_pd(max, _mm256_and_pd(_mm256_loadu_pd(iBuffer + i), mask));
+    auto max128 = _mm_max_pd(_mm256_castpd256_pd128(max), _mm256_extractf128_pd(max, 1));
+    return std::max(SSE2Double::horizontalMax(max128), Scalar::absoluteMax(iBuffer + i, iNumSamples - i));
+  }
+
+  JAMBA_KERNELS_AVX2_TARGET static Sample32 sumOfSquares(Sample32 const *iBuffer, int32 iNumSamples)
+  {
+    auto sum = _mm256_setzero_ps();
+    int32 i = 0;
+    for(; i + 8 <= iNumSamples; i += 8)
+    {
+      auto v = _mm256_loadu_ps(iBuffer + i);
+      sum = _mm256_add_ps(sum, _mm256_mul_ps(v, v));
+    }
+    auto sum128 = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    return SSE2Float::horizontalSum(sum128) + Scalar::sumOfSquares(iBuffer + i, iNumSamples - i);
+  }
+
+  JAMBA_KERNELS_AVX2_TARGET static Sample64 sumOfSquares(Sample64 const *iBuffer, int32 iNumSamples)
+  {
+    auto sum = _mm256_setzero_pd();
+    int32 i = 0;
+    for(; i + 4 <= iNumSamples; i += 4)
+    {
+      auto v = _mm256_loadu_pd(iBuffer + i);
+      sum = _mm256_add_pd(sum, _mm256_mul_pd(v, v));
+    }
+    auto sum128 = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+    return SSE2Double::horizontalSum(sum128) + Scalar::sumOfSquares(iBuffer + i, iNumSamples - i);
+  }
+
+  JAMBA_KERNELS_AVX2_TARGET static void applyGain(Sample32 *ioBuffer, int32 iNumSamples, Sample32 iGain)
+  {
+    auto const gain = _mm256_set1_ps(iGain);
+    int32 i = 0;
+    for(; i + 8 <= iNumSamples; i += 8)
+      _mm256_storeu_ps(ioBuffer + i, _mm256_mul_ps(_mm256_loadu_ps(ioBuffer + i), gain));
+    Scalar::applyGain(ioBuffer + i, iNumSamples - i, iGain);
+  }
+
+  JAMBA_KERNELS_AVX2_TARGET static void applyGain(Sample64 *ioBuffer, int32 iNumSamples, Sample64 iGain)
+  {
+    auto const gain = _mm256_set1_pd(iGain);
+    int32 i = 0;
+    for(; i + 4 <= iNumSamples; i += 4)
+      _mm256_storeu_pd(ioBuffer + i, _mm256_mul_pd(_mm256_loadu_pd(ioBuffer + i), gain));
+    Scalar::applyGain(ioBuffer + i, iNumSamples - i, iGain);
+  }
+
+  JAMBA_KERNELS_AVX2_TARGET static void copyWithGain(Sample32 const *iBuffer, Sample32 *oBuffer, int32 iNumSamples, Sample32 iGain)
+  {
+    auto const gain = _mm256_set1_ps(iGain);
+    int32 i = 0;
+    for(; i + 8 <= iNumSamples; i += 8)
+      _mm256_storeu_ps(oBuffer + i, _mm256_mul_ps(_mm256_loadu_ps(iBuffer + i), gain));
+    Scalar::copyWithGain(iBuffer + i, oBuffer + i, iNumSamples - i, iGain);
+  }
+
+  JAMBA_KERNELS_AVX2_TARGET static void copyWithGain(Sample64 const *iBuffer, Sample64 *oBuffer, int32 iNumSamples, Sample64 iGain)
+  {
+    auto const gain = _mm256_set1_pd(iGain);
+    int32 i = 0;
+    for(; i + 4 <= iNumSamples; i += 4)
+      _mm256_storeu_pd(oBuffer + i, _mm256_mul_pd(_mm256_loadu_pd(iBuffer + i), gain));
+    Scalar::copyWithGain(iBuffer + i, oBuffer + i, iNumSamples - i, iGain);
+  }
+
+  JAMBA_KERNELS_AVX2_TARGET static void mix(Sample32 const *iBuffer, Sample32 *ioBuffer, int32 iNumSamples, Sample32 iGain)
+  {
+    auto const gain = _mm256_set1_ps(iGain);
+    int32 i = 0;
+    for(; i + 8 <= iNumSamples; i += 8)
+    {
+      auto v = _mm256_mul_ps(_mm256_loadu_ps(iBuffer + i), gain);
+      _mm256_storeu_ps(ioBuffer + i, _mm256_add_ps(_mm256_loadu_ps(ioBuffer + i), v));
+    }
+    Scalar::mix(iBuffer + i, ioBuffer + i, iNumSamples - i, iGain);
+  }
+
+  JAMBA_KERNELS_AVX2_TARGET static void mix(Sample64 const *iBuffer, Sample64 *ioBuffer, int32 iNumSamples, Sample64 iGain)
+  {
+    auto const gain = _mm256_set1_pd(iGain);
+    int32 i = 0;
+    for(; i + 4 <= iNumSamples; i += 4)
+    {
+      auto v = _mm256_mul_pd(_mm256_loadu_pd(iBuffer + i), gain);
+      _mm256_storeu_pd(ioBuffer + i, _mm256_add_pd(_mm256_loadu_pd(ioBuffer + i), v));
+    }
+    Scalar::mix(iBuffer + i, ioBuffer + i, iNumSamples - i, iGain);
+  }
+};
+
+//------------------------------------------------------------------------
+// cpuSupportsAVX2
+//------------------------------------------------------------------------
+bool cpuSupportsAVX2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if(info[0] < 7)
+    return false;
+
+  // AVX + OS support for saving the ymm registers
+  __cpuid(info, 1);
+  if((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+    return false;
+  if((_xgetbv(0) & 0x6) != 0x6)
+    return false;
+
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif // JAMBA_KERNELS_SSE2
+
+#if JAMBA_KERNELS_NEON
+//------------------------------------------------------------------------
+// NEON primitives (arm64)
+//------------------------------------------------------------------------
+struct NEONFloat
+{
+  using T = Sample32;
+  static constexpr int32 kWidth = 4;
+  static inline float32x4_t load(T const *p) { return vld1q_f32(p); }
+  static inline void store(T *p, float32x4_t v) { vst1q_f32(p, v); }
+  static inline float32x4_t set1(T v) { return vdupq_n_f32(v); }
+  static inline float32x4_t zero() { return vdupq_n_f32(0); }
+  static inline float32x4_t abs(float32x4_t v) { return vabsq_f32(v); }
+  static inline float32x4_t add(float32x4_t a, float32x4_t b) { return vaddq_f32(a, b); }
+  static inline float32x4_t mul(float32x4_t a, float32x4_t b) { return vmulq_f32(a, b); }
+  static inline float32x4_t sub(float32x4_t a, float32x4_t b) { return vsubq_f32(a, b); }
+  static inline float32x4_t div(float32x4_t a, float32x4_t b) { return vdivq_f32(a, b); }
+  static inline float32x4_t max(float32x4_t a, float32x4_t b) { return vmaxq_f32(a, b); }
+  static inline bool allLessEqual(float32x4_t a, float32x4_t b) { return vminvq_u32(vcleq_f32(a, b)) != 0; }
+  static inline T horizontalMax(float32x4_t v) { return vmaxvq_f32(v); }
+  static inline T horizontalSum(float32x4_t v) { return vaddvq_f32(v); }
+  // see SSE2Float::exp2 (vminq_f32/vmaxq_f32 propagate NaN so there is no need to restore the NaN lanes)
+  static inline float32x4_t exp2(float32x4_t x)
+  {
+    x = vmaxq_f32(vminq_f32(x, vdupq_n_f32(127.0f)), vdupq_n_f32(-126.0f));
+    auto n = vcvtnq_s32_f32(x);
+    auto f = vsubq_f32(x, vcvtq_f32_s32(n));
+    auto pow2n = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(n, vdupq_n_s32(127)), 23));
+    return vmulq_f32(FastMath::exp2Polynomial<NEONFloat>(f), pow2n);
+  }
+  // see SSE2Float::log2
+  static inline float32x4_t log2(float32x4_t x)
+  {
+    auto bits = vreinterpretq_s32_f32(x);
+    auto e = vsubq_s32(vshrq_n_s32(bits, 23), vdupq_n_s32(127));
+    auto m = vreinterpretq_f32_s32(vorrq_s32(vandq_s32(bits, vdupq_n_s32(0x007fffff)), vdupq_n_s32(0x3f800000)));
+    auto big = vcgtq_f32(m, vdupq_n_f32(static_cast<T>(FastMath::kSqrt2)));
+    m = vbslq_f32(big, vmulq_f32(m, vdupq_n_f32(0.5f)), m);
+    auto ef = vaddq_f32(vcvtq_f32_s32(e), vbslq_f32(big, vdupq_n_f32(1.0f), vdupq_n_f32(0.0f)));
+    return vaddq_f32(ef, FastMath::log2Polynomial<NEONFloat>(m));
+  }
+};
+
+struct NEONDouble
+{
+  using T = Sample64;
+  static constexpr int32 kWidth = 2;
+  static inline float64x2_t load(T const *p) { return vld1q_f64(p); }
+  static inline void store(T *p, float64x2_t v) { vst1q_f64(p, v); }
+  static inline float64x2_t set1(T v) { return vdupq_n_f64(v); }
+  static inline float64x2_t zero() { return vdupq_n_f64(0); }
+  static inline float64x2_t abs(float64x2_t v) { return vabsq_f64(v); }
+  static inline float64x2_t add(float64x2_t a, float64x2_t b) { return vaddq_f64(a, b); }
+  static inline float64x2_t mul(float64x2_t a, float64x2_t b) { return vmulq_f64(a, b); }
+  static inline float64x2_t max(float64x2_t a, float64x2_t b) { return vmaxq_f64(a, b); }
+  static inline bool allLessEqual(float64x2_t a, float64x2_t b)
+  {
+    auto res = vcleq_f64(a, b);
+    return (vgetq_lane_u64(res, 0) & vgetq_lane_u64(res, 1)) != 0;
+  }
+  static inline T horizontalMax(float64x2_t v) { return vmaxvq_f64(v); }
+  static inline T horizontalSum(float64x2_t v) { return vaddvq_f64(v); }
+  // no approximation in double precision (lane by lane)
+  static inline float64x2_t exp2(float64x2_t v)
+  {
+    return vsetq_lane_f64(std::exp2(vgetq_lane_f64(v, 1)), vdupq_n_f64(std::exp2(vgetq_lane_f64(v, 0))), 1);
+  }
+  static inline float64x2_t log2(float64x2_t v)
+  {
+    return vsetq_lane_f64(std::log2(vgetq_lane_f64(v, 1)), vdupq_n_f64(std::log2(vgetq_lane_f64(v, 0))), 1);
+  }
+};
+#endif // JAMBA_KERNELS_NEON
+
+//------------------------------------------------------------------------
+// Kernels - dispatch table for a given sample type
+//------------------------------------------------------------------------
+template<typename T>
+struct Kernels
+{
+  bool (*fIsSilent)(T const *, int32);
+  T (*fAbsoluteMax)(T const *, int32);
+  T (*fSumOfSquares)(T const *, int32);
+  void (*fApplyGain)(T *, int32, T);
+  void (*fCopyWithGain)(T const *, T *, int32, T);
+  void (*fMix)(T const *, T *, int32, T);
+  void (*fDbToSample)(T const *, T *, int32);
+  void (*fSampleToDb)(T const *, T *, int32);
+
+  template<typename Impl>
+  static Kernels create()
+  {
+    return {
+      &Impl::isSilent,
+      &Impl::absoluteMax,
+      &Impl::sumOfSquares,
+      &Impl::applyGain,
+      &Impl::copyWithGain,
+      &Impl::mix,
+      &Impl::dbToSample,
+      &Impl::sampleToDb
+    };
+  }
+};
+
+// Scalar dispatch (the functions need to be instantiated for a given type)
+template<typename T>
+struct ScalarT
+{
+  static bool isSilent(T const *b, int32 n) { return Scalar::isSilent(b, n); }
+  static T absoluteMax(T const *b, int32 n) { return Scalar::absoluteMax(b, n); }
+  static T sumOfSquares(T const *b, int32 n) { return Scalar::sumOfSquares(b, n); }
+  static void applyGain(T *b, int32 n, T g) { Scalar::applyGain(b, n, g); }
+  static void copyWithGain(T const *i, T *o, int32 n, T g) { Scalar::copyWithGain(i, o, n, g); }
+  static void mix(T const *i, T *o, int32 n, T g) { Scalar::mix(i, o, n, g); }
+  static void dbToSample(T const *i, T *o, int32 n) { Scalar::dbToSample(i, o, n); }
+  static void sampleToDb(T const *i, T *o, int32 n) { Scalar::sampleToDb(i, o, n); }
+};
+
+#if JAMBA_KERNELS_SSE2
+// AVX2 dispatch (resolves the overloads for a given type)
+template<typename T>
+struct AVX2T
+{
+  static bool isSilent(T const *b, int32 n) { return AVX2::isSilent(b, n); }
+  static T absoluteMax(T const *b, int32 n) { return AVX2::absoluteMax(b, n); }
+  static T sumOfSquares(T const *b, int32 n) { return AVX2::sumOfSquares(b, n); }
+  static void applyGain(T *b, int32 n, T g) { AVX2::applyGain(b, n, g); }
+  static void copyWithGain(T const *i, T *o, int32 n, T g) { AVX2::copyWithGain(i, o, n, g); }
+  static void mix(T const *i, T *o, int32 n, T g) { AVX2::mix(i, o, n, g); }
+
+  // no AVX2 specific version: uses SSE2
+  using SSE2 = Vectorized<std::conditional_t<std::is_same_v<T, Sample32>, SSE2Float, SSE2Double>>;
+  static void dbToSample(T const *i, T *o, int32 n) { SSE2::dbToSample(i, o, n); }
+  static void sampleToDb(T const *i, T *o, int32 n) { SSE2::sampleToDb(i, o, n); }
+};
+#endif
+
+//------------------------------------------------------------------------
+// Dispatch
+//------------------------------------------------------------------------
+struct Dispatch
+{
+  InstructionSet fInstructionSet{InstructionSet::kScalar};
+  Kernels<Sample32> f32{Kernels<Sample32>::create<ScalarT<Sample32>>()};
+  Kernels<Sample64> f64{Kernels<Sample64>::create<ScalarT<Sample64>>()};
+
+  InstructionSet select(InstructionSet iInstructionSet)
+  {
+    auto const best = getBestInstructionSet();
+
+    // AVX2 implies SSE2
+    bool supported = iInstructionSet == InstructionSet::kScalar ||
+                     iInstructionSet == best ||
+                     (iInstructionSet == InstructionSet::kSSE2 && best == InstructionSet::kAVX2);
+
+    fInstructionSet = supported ? iInstructionSet : InstructionSet::kScalar;
+
+    switch(fInstructionSet)
+    {
+#if JAMBA_KERNELS_SSE2
+      case InstructionSet::kSSE2:
+        f32 = Kernels<Sample32>::create<Vectorized<SSE2Float>>();
+        f64 = Kernels<Sample64>::create<Vectorized<SSE2Double>>();
+        break;
+
+      case InstructionSet::kAVX2:
+        f32 = Kernels<Sample32>::create<AVX2T<Sample32>>();
+        f64 = Kernels<Sample64>::create<AVX2T<Sample64>>();
+        break;
+#endif
+
+#if JAMBA_KERNELS_NEON
+      case InstructionSet::kNEON:
+        f32 = Kernels<Sample32>::create<Vectorized<NEONFloat>>();
+        f64 = Kernels<Sample64>::create<Vectorized<NEONDouble>>();
+        break;
+#endif
+
+      default:
+        fInstructionSet = InstructionSet::kScalar;
+        f32 = Kernels<Sample32>::create<ScalarT<Sample32>>();
+        f64 = Kernels<Sample64>::create<ScalarT<Sample64>>();
+        break;
+    }
+
+    return fInstructionSet;
+  }
+};
+
+//------------------------------------------------------------------------
+// dispatch - selects the best instruction set the first time it is called
+//------------------------------------------------------------------------
+Dispatch &dispatch()
+{
+  static Dispatch kDispatch = []() { Dispatch d{}; d.select(getBestInstructionSet()); return d; }();
+  return kDispatch;
+}
+
+// forces the selection (cpuid) when the library is loaded so that it does not happen in the RT thread (the function
+// local static above still protects against being called from another static initializer)
+[[maybe_unused]] Dispatch &kEagerDispatch = dispatch();
+
+inline Kernels<Sample32> const &kernels(Sample32 const *) { return dispatch().f32; }
+inline Kernels<Sample64> const &kernels(Sample64 const *) { return dispatch().f64; }
+
+}
+
+//------------------------------------------------------------------------
+// getBestInstructionSet
+//------------------------------------------------------------------------
+InstructionSet getBestInstructionSet()
+{
+#if JAMBA_KERNELS_SSE2
+  static const bool kAVX2 = cpuSupportsAVX2();
+  return kAVX2 ? InstructionSet::kAVX2 : InstructionSet::kSSE2;
+#elif JAMBA_KERNELS_NEON
+  return InstructionSet::kNEON;
+#else
+  return InstructionSet::kScalar;
+#endif
+}
+
+//------------------------------------------------------------------------
+// getInstructionSet
+//------------------------------------------------------------------------
+InstructionSet getInstructionSet()
+{
+  return dispatch().fInstructionSet;
+}
+
+//------------------------------------------------------------------------
+// setInstructionSet
+//------------------------------------------------------------------------
+InstructionSet setInstructionSet(InstructionSet iInstructionSet)
+{
+  return dispatch().select(iInstructionSet);
+}
+
+//------------------------------------------------------------------------
+// Kernels entry points
+//------------------------------------------------------------------------
+bool isSilent(Sample32 const *iBuffer, int32 iNumSamples) { return kernels(iBuffer).fIsSilent(iBuffer, iNumSamples); }
+bool isSilent(Sample64 const *iBuffer, int32 iNumSamples) { return kernels(iBuffer).fIsSilent(iBuffer, iNumSamples); }
+
+Sample32 absoluteMax(Sample32 const *iBuffer, int32 iNumSamples) { return kernels(iBuffer).fAbsoluteMax(iBuffer, iNumSamples); }
+Sample64 absoluteMax(Sample64 const *iBuffer, int32 iNumSamples) { return kernels(iBuffer).fAbsoluteMax(iBuffer, iNumSamples); }
+
+Sample32 sumOfSquares(Sample32 const *iBuffer, int32 iNumSamples) { return kernels(iBuffer).fSumOfSquares(iBuffer, iNumSamples); }
+Sample64 sumOfSquares(Sample64 const *iBuffer, int32 iNumSamples) { return kernels(iBuffer).fSumOfSquares(iBuffer, iNumSamples); }
+
+void applyGain(Sample32 *ioBuffer, int32 iNumSamples, Sample32 iGain) { kernels(ioBuffer).fApplyGain(ioBuffer, iNumSamples, iGain); }
+void applyGain(Sample64 *ioBuffer, int32 iNumSamples, Sample64 iGain) { kernels(ioBuffer).fApplyGain(ioBuffer, iNumSamples, iGain); }
+
+void copyWithGain(Sample32 const *iBuffer, Sample32 *oBuffer, int32 iNumSamples, Sample32 iGain) { kernels(iBuffer).fCopyWithGain(iBuffer, oBuffer, iNumSamples, iGain); }
+void copyWithGain(Sample64 const *iBuffer, Sample64 *oBuffer, int32 iNumSamples, Sample64 iGain) { kernels(iBuffer).fCopyWithGain(iBuffer, oBuffer, iNumSamples, iGain); }
+
+void mix(Sample32 const *iBuffer, Sample32 *ioBuffer, int32 iNumSamples, Sample32 iGain) { kernels(iBuffer).fMix(iBuffer, ioBuffer, iNumSamples, iGain); }
+void mix(Sample64 const *iBuffer, Sample64 *ioBuffer, int32 iNumSamples, Sample64 iGain) { kernels(iBuffer).fMix(iBuffer, ioBuffer, iNumSamples, iGain); }
+
+void dbToSample(Sample32 const *iBuffer, Sample32 *oBuffer, int32 iNumSamples) { kernels(iBuffer).fDbToSample(iBuffer, oBuffer, iNumSamples); }
+void dbToSample(Sample64 const *iBuffer, Sample64 *oBuffer, int32 iNumSamples) { kernels(iBuffer).fDbToSample(iBuffer, oBuffer, iNumSamples); }
+
+void sampleToDb(Sample32 const *iBuffer, Sample32 *oBuffer, int32 iNumSamples) { kernels(iBuffer).fSampleToDb(iBuffer, oBuffer, iNumSamples); }
+void sampleToDb(Sample64 const *iBuffer, Sample64 *oBuffer, int32 iNumSamples) { kernels(iBuffer).fSampleToDb(iBuffer, oBuffer, iNumSamples); }
+
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include <pluginterfaces/vst/ivstaudioprocessor.h>
+
+#include <cmath>
+
+namespace pongasoft::VST::AudioKernels {
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+/**
+ * The instruction set used by the kernels. The best one available on the cpu is selected at runtime when the library
+ * is loaded (SSE2 being the baseline on x86_64 and NEON the baseline on arm64). */
+enum class InstructionSet
+{
+  kScalar,
+  kSSE2,
+  kAVX2,
+  kNEON
+};
+
+//! @return the instruction set currently used by the kernels
+InstructionSet getInstructionSet();
+
+/**
+ * Forces the kernels to use the provided instruction set (mostly useful for testing and benchmarking). If the
+ * instruction set is not supported by the cpu, the scalar implementation is used instead. Not thread safe: should
+ * not be called while the kernels are in use.
+ *
+ * @return the instruction set actually used */
+InstructionSet setInstructionSet(InstructionSet iInstructionSet);
+
+//! @return the best instruction set supported by this cpu (and this build)
+InstructionSet getBestInstructionSet();
+
+/**
+ * @return `true` if every sample in the buffer is silent (see `pongasoft::VST::isSilent`). Stops as soon as a
+ *         non silent sample is found. */
+bool isSilent(Sample32 const *iBuffer, int32 iNumSamples);
+bool isSilent(Sample64 const *iBuffer, int32 iNumSamples);
+
+//! @return the max absolute value of the samples in the buffer (`0` if empty)
+Sample32 absoluteMax(Sample32 const *iBuffer, int32 iNumSamples);
+Sample64 absoluteMax(Sample64 const *iBuffer, int32 iNumSamples);
+
+//! @return the sum of the square of each sample (use `rms` for the root mean square)
+Sample32 sumOfSquares(Sample32 const *iBuffer, int32 iNumSamples);
+Sample64 sumOfSquares(Sample64 const *iBuffer, int32 iNumSamples);
+
+//! `ioBuffer[i] *= iGain` for each sample
+void applyGain(Sample32 *ioBuffer, int32 iNumSamples, Sample32 iGain);
+void applyGain(Sample64 *ioBuffer, int32 iNumSamples, Sample64 iGain);
+
+//! `oBuffer[i] = iBuffer[i] * iGain` for each sample
+void copyWithGain(Sample32 const *iBuffer, Sample32 *oBuffer, int32 iNumSamples, Sample32 iGain);
+void copyWithGain(Sample64 const *iBuffer, Sample64 *oBuffer, int32 iNumSamples, Sample64 iGain);
+
+//! `ioBuffer[i] += iBuffer[i] * iGain` for each sample
+void mix(Sample32 const *iBuffer, Sample32 *ioBuffer, int32 iNumSamples, Sample32 iGain);
+void mix(Sample64 const *iBuffer, Sample64 *ioBuffer, int32 iNumSamples, Sample64 iGain);
+
+/**
+ * `oBuffer[i] = dbToSample(iBuffer[i])` for each sample (array version of `pongasoft::VST::dbToSample`, `iBuffer` and
+ * `oBuffer` can be the same buffer). The `Sample32` version uses a polynomial approximation of `std::pow` (relative
+ * error in the order of `1e-6`, the output being clamped to `[2^-126, 2^127]`, NaN being propagated) while the
+ * `Sample64` version is exact. */
+void dbToSample(Sample32 const *iBuffer, Sample32 *oBuffer, int32 iNumSamples);
+void dbToSample(Sample64 const *iBuffer, Sample64 *oBuffer, int32 iNumSamples);
+
+/**
+ * `oBuffer[i] = sampleToDb(iBuffer[i])` for each sample (array version of `pongasoft::VST::sampleToDb`, `iBuffer` and
+ * `oBuffer` can be the same buffer). Values which are `<= 0` are treated as the smallest positive (normal) value so
+ * that the output is always finite. The `Sample32` version uses a polynomial approximation of `std::log10`
+ * (absolute error in the order of `1e-5` dB) while the `Sample64` version is exact. */
+void sampleToDb(Sample32 const *iBuffer, Sample32 *oBuffer, int32 iNumSamples);
+void sampleToDb(Sample64 const *iBuffer, Sample64 *oBuffer, int32 iNumSamples);
+
+//! @return the root mean square of the samples in the buffer (`0` if empty)
+template<typename SampleType>
+inline SampleType rms(SampleType const *iBuffer, int32 iNumSamples)
+{
+  if(iNumSamples <= 0)
+    return 0;
+
+  return std::sqrt(sumOfSquares(iBuffer, iNumSamples) / static_cast<SampleType>(iNumSamples));
+}
+
+}
@@ -76,7 +76,7 @@ inline bool isSilent(Sample64 value)
 }
 
 //------------------------------------------------------------------------
-// dbToSample
+// dbToSample (see AudioKernels::dbToSample for the (vectorized) array version)
 //------------------------------------------------------------------------
 template<typename SampleType>
 inline SampleType dbToSample(double valueInDb)
@@ -85,7 +85,7 @@ inline SampleType dbToSample(double valueInDb)
 }
 
 //------------------------------------------------------------------------
-// sampleToDb
+// sampleToDb (see AudioKernels::sampleToDb for the (vectorized) array version)
 //------------------------------------------------------------------------
 template<typename SampleType>
 inline double sampleToDb(SampleType valueInSample)
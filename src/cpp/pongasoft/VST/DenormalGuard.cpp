@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#include "DenormalGuard.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JAMBA_DENORMAL_GUARD_SSE 1
+#include <immintrin.h>
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && !defined(_MSC_VER)
+#define JAMBA_DENORMAL_GUARD_ARM64 1
+#endif
+
+namespace pongasoft::VST {
+
+namespace {
+
+#if JAMBA_DENORMAL_GUARD_SSE
+// MXCSR: FTZ (bit 15) and DAZ (bit 6)
+constexpr uint64 kFlushDenormalsMask = 0x8040;
+
+inline uint64 getFloatingPointMode() { return _mm_getcsr(); }
+inline void setFloatingPointMode(uint64 iMode) { _mm_setcsr(static_cast<unsigned int>(iMode)); }
+#elif JAMBA_DENORMAL_GUARD_ARM64
+// FPCR: FZ (bit 24)
+constexpr uint64 kFlushDenormalsMask = 1ull << 24;
+
+inline uint64 getFloatingPointMode()
+{
+  uint64 mode;
+  asm volatile("mrs %0, fpcr" : "=r"(mode));
+  return mode;
+}
+
+inline void setFloatingPointMode(uint64 iMode)
+{
+  asm volatile("msr fpcr, %0" : : "r"(iMode));
+}
+#else
+constexpr uint64 kFlushDenormalsMask = 0;
+
+inline uint64 getFloatingPointMode() { return 0; }
+inline void setFloatingPointMode(uint64) {}
+#endif
+
+}
+
+//------------------------------------------------------------------------
+// DenormalGuard::DenormalGuard
+//------------------------------------------------------------------------
+DenormalGuard::DenormalGuard(bool iEnable) : fEnabled{iEnable && isSupported()}
+{
+  if(fEnabled)
+  {
+    fPreviousMode = getFloatingPointMode();
+    if((fPreviousMode & kFlushDenormalsMask) != kFlushDenormalsMask)
+      setFloatingPointMode(fPreviousMode | kFlushDenormalsMask);
+    else
+      fEnabled = false; // already flushing denormals => nothing to restore
+  }
+}
+
+//------------------------------------------------------------------------
+// DenormalGuard::~DenormalGuard
+//------------------------------------------------------------------------
+DenormalGuard::~DenormalGuard()
+{
+  if(fEnabled)
+    setFloatingPointMode(fPreviousMode);
+}
+
+//------------------------------------------------------------------------
+// DenormalGuard::isSupported
+//------------------------------------------------------------------------
+bool DenormalGuard::isSupported()
+{
+  return kFlushDenormalsMask != 0;
+}
+
+//------------------------------------------------------------------------
+// DenormalGuard::isFlushingDenormals
+//------------------------------------------------------------------------
+bool DenormalGuard::isFlushingDenormals()
+{
+  return isSupported() && (getFloatingPointMode() & kFlushDenormalsMask) == kFlushDenormalsMask;
+}
+
+}
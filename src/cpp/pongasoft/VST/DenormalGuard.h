@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include <pluginterfaces/base/ftypes.h>
+
+namespace pongasoft::VST {
+
+using namespace Steinberg;
+
+/**
+ * Denormal (aka subnormal) numbers are extremely small floating point numbers which some cpus (x86 in particular)
+ * process 10 to 100 times more slowly than regular numbers. They typically appear in the tail of feedback based
+ * processing (filters, reverbs, delays...) when the input becomes silent.
+ *
+ * This class (RAII) changes the floating point mode of the current thread for the duration of its scope so that
+ * denormals are flushed to zero: on x86 the FTZ (flush to zero) and DAZ (denormals are zero) bits of the MXCSR
+ * register, on arm64 the FZ bit of the FPCR register. The previous mode (the one set by the host) is restored on
+ * destruction. Does nothing on other platforms (see `isSupported`).
+ *
+ * `RTProcessor::process` uses it when enabled with `RTProcessor::enableDenormalsFlushing`.
+ */
+class DenormalGuard
+{
+public:
+  /**
+   * @param iEnable when `false` the guard does nothing (which lets the caller decide at runtime without having to
+   *                allocate the guard conditionally) */
+  explicit DenormalGuard(bool iEnable = true);
+
+  //! Restores the previous floating point mode
+  ~DenormalGuard();
+
+  DenormalGuard(DenormalGuard const &) = delete;
+  DenormalGuard &operator=(DenormalGuard const &) = delete;
+
+  //! @return `true` if the platform supports flushing denormals to zero
+  static bool isSupported();
+
+  //! @return `true` if the current thread is flushing denormals to zero
+  static bool isFlushingDenormals();
+
+private:
+  bool fEnabled;
+  uint64 fPreviousMode{};
+};
+
+}
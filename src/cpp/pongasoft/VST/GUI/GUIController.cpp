@@ -198,6 +198,14 @@ tresult GUIController::notify(IMessage *message)
 
   Message m{message};
 
+  // the latency of the processor has changed => the host needs to query it again
+  if(m.getInt(ATTR_MSG_LATENCY, -1) >= 0)
+  {
+    if(componentHandler)
+      componentHandler->restartComponent(kLatencyChanged);
+    return kResultOk;
+  }
+
   return getGUIState()->handleMessage(m);
 }
 
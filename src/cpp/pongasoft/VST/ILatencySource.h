@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include <pluginterfaces/base/ftypes.h>
+#include <atomic>
+
+namespace pongasoft::VST {
+
+using namespace Steinberg;
+
+/**
+ * Implemented by the processing stages which delay the signal (ex: `STFTProcessor`) so that their latency can be
+ * reported to the host automatically (see `RT::RTProcessor::addLatencySource`).
+ */
+class ILatencySource
+{
+public:
+  virtual ~ILatencySource() = default;
+
+  //! @return the number of samples by which this stage delays the signal
+  virtual uint32 getLatencySamples() const = 0;
+};
+
+/**
+ * Latency source whose latency is simply a value which can be changed while processing (ex: the lookahead of a
+ * limiter driven by a parameter). The value is atomic as the host may query the latency outside the RT thread.
+ */
+class LatencySource : public ILatencySource
+{
+public:
+  explicit LatencySource(uint32 iLatencySamples = 0) : fLatencySamples{iLatencySamples} {}
+
+  //! @return the latency last set
+  uint32 getLatencySamples() const override { return fLatencySamples.load(); }
+
+  //! Changes the latency (the host is notified by `RT::RTProcessor` when registered with `addLatencySource`)
+  void setLatencySamples(uint32 iLatencySamples) { fLatencySamples = iLatencySamples; }
+
+private:
+  std::atomic<uint32> fLatencySamples;
+};
+
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#include "MessageBatch.h"
+
+#include <pongasoft/logging/logging.h>
+#include <pongasoft/VST/VstUtils/ReadOnlyMemoryStream.h>
+
+#include <cstring>
+
+namespace pongasoft::VST {
+
+namespace {
+
+/**
+ * Exposes an entry of the batch as a (read only) message: the MessageID is the entry MessageID and every binary
+ * attribute (except ATTR_MSG_BATCH) is the payload. Lives on the stack (no reference counting). */
+class MessageBatchEntry : public IMessage, public IAttributeList
+{
+public:
+  MessageBatchEntry(MessageID iMessageID, void const *iPayload, uint32 iPayloadSize) :
+    fMessageID{iMessageID}, fPayload{iPayload}, fPayloadSize{iPayloadSize}
+  {}
+
+  // FUnknown
+  tresult PLUGIN_API queryInterface(const TUID /* _iid */, void ** /* obj */) override { return kNoInterface; }
+  uint32 PLUGIN_API addRef() override { return 1; }
+  uint32 PLUGIN_API release() override { return 1; }
+
+  // IMessage
+  FIDString PLUGIN_API getMessageID() override { return nullptr; }
+  void PLUGIN_API setMessageID(FIDString /* id */) override {}
+  IAttributeList *PLUGIN_API getAttributes() override { return this; }
+
+  // IAttributeList
+  tresult PLUGIN_API getInt(AttrID id, int64 &value) override
+  {
+    if(std::strcmp(id, ATTR_MSG_ID) != 0)
+      return kResultFalse;
+    value = fMessageID;
+    return kResultOk;
+  }
+
+  tresult PLUGIN_API getBinary(AttrID id, const void *&data, uint32 &sizeInBytes) override
+  {
+    if(std::strcmp(id, ATTR_MSG_BATCH) == 0)
+      return kResultFalse;
+    data = fPayload;
+    sizeInBytes = fPayloadSize;
+    return kResultOk;
+  }
+
+  tresult PLUGIN_API getFloat(AttrID /* id */, double & /* value */) override { return kResultFalse; }
+  tresult PLUGIN_API getString(AttrID /* id */, TChar * /* string */, uint32 /* sizeInBytes */) override { return kResultFalse; }
+
+  // read only
+  tresult PLUGIN_API setInt(AttrID /* id */, int64 /* value */) override { return kNotImplemented; }
+  tresult PLUGIN_API setFloat(AttrID /* id */, double /* value */) override { return kNotImplemented; }
+  tresult PLUGIN_API setString(AttrID /* id */, const TChar * /* string */) override { return kNotImplemented; }
+  tresult PLUGIN_API setBinary(AttrID /* id */, const void * /* data */, uint32 /* sizeInBytes */) override { return kNotImplemented; }
+
+private:
+  MessageID fMessageID;
+  void const *fPayload;
+  uint32 fPayloadSize;
+};
+
+}
+
+//------------------------------------------------------------------------
+// MessageBatchReader::isBatch
+//------------------------------------------------------------------------
+bool MessageBatchReader::isBatch(Message const &iMessage)
+{
+  void const *data;
+  uint32 size;
+  return iMessage.getBinaryData(ATTR_MSG_BATCH, data, size) == kResultOk;
+}
+
+//------------------------------------------------------------------------
+// MessageBatchReader::forEachEntry
+//------------------------------------------------------------------------
+tresult MessageBatchReader::forEachEntry(Message const &iMessage, IMessageHandler &iEntryHandler)
+{
+  void const *data;
+  uint32 size;
+
+  if(iMessage.getBinaryData(ATTR_MSG_BATCH, data, size) != kResultOk)
+    return kResultFalse;
+
+  auto frame = static_cast<char const *>(data);
+  constexpr uint32 kHeaderSize = sizeof(int32) + sizeof(uint32);
+
+  tresult res = kResultOk;
+
+  uint32 offset = 0;
+  while(offset + kHeaderSize <= size)
+  {
+    VstUtils::ReadOnlyMemoryStream stream{frame + offset, kHeaderSize};
+    IBStreamer streamer{&stream, kLittleEndian};
+
+    int32 messageID;
+    uint32 payloadSize;
+    if(!streamer.readInt32(messageID) || !streamer.readInt32u(payloadSize))
+      return kResultFalse;
+
+    offset += kHeaderSize;
+
+    if(payloadSize > size - offset)
+    {
+      DLOG_F(ERROR, "MessageBatchReader::forEachEntry - invalid frame");
+      return kResultFalse;
+    }
+
+    MessageBatchEntry entry{messageID, frame + offset, payloadSize};
+    Message m{&entry};
+    res |= iEntryHandler.handleMessage(m);
+
+    offset += payloadSize;
+  }
+
+  return res;
+}
+
+}
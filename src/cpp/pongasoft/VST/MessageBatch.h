@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include "MessageHandler.h"
+
+#include <base/source/fstreamer.h>
+#include <pongasoft/VST/VstUtils/FastWriteMemoryStream.h>
+
+namespace pongasoft::VST {
+
+static const auto ATTR_MSG_BATCH = "ATTR_MSG_BATCH";
+
+/**
+ * Packs several messages into a single frame so that they can be delivered with a single `IMessage` (the cost of
+ * `sendMessage` varies widely from one host to another). Each entry in the frame is:
+ *
+ *     MessageID (int32) | payload size in bytes (uint32) | payload
+ *
+ * where the payload is what would have been stored as the (single) binary attribute of the message. The memory used
+ * by the frame is reused from one batch to the next. See `MessageBatchReader` for the other side.
+ */
+class MessageBatchWriter
+{
+public:
+  /**
+   * Starts a new batch (the memory is kept) */
+  void clear()
+  {
+    fFrame.rewind();
+    fCount = 0;
+  }
+
+  // getCount
+  inline int32 getCount() const { return fCount; }
+
+  // isEmpty
+  inline bool isEmpty() const { return fCount == 0; }
+
+  /**
+   * Adds an entry to the batch. `iPayloadWriter` is called back with an `IBStreamer &` to write the payload and
+   * must return `kResultOk` for the entry to be added (otherwise the entry is discarded).
+   */
+  template<class PayloadWriter>
+  tresult add(MessageID iMessageID, PayloadWriter const &iPayloadWriter);
+
+  /**
+   * Writes the batch (as a single binary attribute) to the message */
+  tresult writeToMessage(Message &oMessage) const
+  {
+    return oMessage.setBinary(ATTR_MSG_BATCH, fFrame.getData(), static_cast<uint32>(fFrame.getSize()));
+  }
+
+private:
+  VstUtils::FastWriteMemoryStream fFrame{};
+  int32 fCount{0};
+};
+
+/**
+ * Reads a frame written by `MessageBatchWriter`.
+ */
+class MessageBatchReader
+{
+public:
+  /**
+   * @return `true` if the message is a batch */
+  static bool isBatch(Message const &iMessage);
+
+  /**
+   * Calls `iEntryHandler` for each entry in the batch. The message provided to the handler has the entry MessageID
+   * and exposes the payload as its binary attribute (and is never itself a batch). It is only valid during the call.
+   * No memory is allocated.
+   *
+   * @return `kResultOk` if every entry was handled successfully */
+  static tresult forEachEntry(Message const &iMessage, IMessageHandler &iEntryHandler);
+};
+
+//------------------------------------------------------------------------
+// MessageBatchWriter::add
+//------------------------------------------------------------------------
+template<class PayloadWriter>
+tresult MessageBatchWriter::add(MessageID iMessageID, PayloadWriter const &iPayloadWriter)
+{
+  auto entryStart = fFrame.pos();
+
+  IBStreamer streamer{&fFrame, kLittleEndian};
+
+  streamer.writeInt32(iMessageID);
+  streamer.writeInt32u(0); // placeholder for the payload size
+
+  auto payloadStart = fFrame.pos();
+
+  tresult res = iPayloadWriter(streamer);
+
+  if(res != kResultOk)
+  {
+    fFrame.rewind(entryStart);
+    return res;
+  }
+
+  auto payloadEnd = fFrame.pos();
+
+  fFrame.seek(payloadStart - static_cast<int64>(sizeof(uint32)), IBStream::kIBSeekSet, nullptr);
+  streamer.writeInt32u(static_cast<uint32>(payloadEnd - payloadStart));
+  fFrame.seek(payloadEnd, IBStream::kIBSeekSet, nullptr);
+
+  fCount++;
+
+  return kResultOk;
+}
+
+}
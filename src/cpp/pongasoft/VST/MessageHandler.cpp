@@ -19,6 +19,7 @@
 #include <pongasoft/logging/logging.h>
 
 #include "MessageHandler.h"
+#include "MessageBatch.h"
 
 namespace pongasoft {
 namespace VST {
@@ -28,6 +29,10 @@ namespace VST {
 //------------------------------------------------------------------------
 tresult MessageHandler::handleMessage(Message const &iMessage)
 {
+  // a batch is handled as if each entry had been sent separately
+  if(MessageBatchReader::isBatch(iMessage))
+    return MessageBatchReader::forEachEntry(iMessage, *this);
+
   auto iter = fHandlers.find(iMessage.getMessageID());
 
   if(iter == fHandlers.cend())
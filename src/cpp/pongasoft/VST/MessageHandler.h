@@ -35,7 +35,8 @@ public:
 };
 
 /**
- * Simple implementation of IMessageHandler which will delegate the message handling based on MessageID */
+ * Simple implementation of IMessageHandler which will delegate the message handling based on MessageID. Messages
+ * sent as a batch (see `MessageBatchWriter`) are demultiplexed (each entry is delegated separately). */
 class MessageHandler : public IMessageHandler
 {
 public:
@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <pluginterfaces/vst/ivstmessage.h>
+#include "RecyclableMessage.h"
 
 namespace pongasoft {
 namespace VST {
@@ -40,6 +41,22 @@ public:
 
   /** Sends the given message to the peer. */
   virtual tresult sendMessage(IPtr<IMessage> iMessage) = 0;
+
+  /**
+   * Reuses `ioMessage` (after clearing it) when nobody else holds a reference to it anymore (which is the case once
+   * the peer has processed it), otherwise replaces it with a new message. Contrary to `allocateMessage`, the message
+   * is a jamba implementation (`RecyclableMessage`) so that its reference count is known for sure.
+   *
+   * @return the message to use */
+  IMessage *recycleMessage(IPtr<RecyclableMessage> &ioMessage)
+  {
+    if(ioMessage && !ioMessage->isShared())
+      ioMessage->clear();
+    else
+      ioMessage = RecyclableMessage::create();
+
+    return ioMessage.get();
+  }
 };
 
 }
@@ -36,6 +36,9 @@ using namespace Steinberg::Vst;
 
 static const auto ATTR_MSG_ID = "ATTR_MSG_ID";
 
+// sent by the processor when its latency changes (see RT::RTProcessor::notifyLatencyChanged)
+static const auto ATTR_MSG_LATENCY = "ATTR_MSG_LATENCY";
+
 using MessageID = int;
 
 /**
@@ -106,6 +109,15 @@ public:
   template<typename T>
   inline int32 getBinary(IAttributeList::AttrID id, T *iData, uint32 iSize) const;
 
+  /**
+   * Gives access to the binary data without copying it (only valid as long as the message is)
+   *
+   * @return kResultOk if there is such an attribute */
+  inline tresult getBinaryData(IAttributeList::AttrID id, void const *&oData, uint32 &oSize) const
+  {
+    return fMessage->getAttributes()->getBinary(id, oData, oSize);
+  }
+
   /**
    * Serializes the parameter value as an entry in the message
    *
@@ -113,6 +125,17 @@ public:
   template<typename T>
   tresult setSerializableValue(IAttributeList::AttrID id, IParamSerializer<T> const &iSerializer, T const &iValue);
 
+  /**
+   * Same as `setSerializableValue` but uses `ioBuffer` to serialize the value (instead of allocating a new one every
+   * time) so that the memory can be reused from one call to the next.
+   *
+   * @return kResultOk if successful */
+  template<typename T>
+  tresult setSerializableValue(IAttributeList::AttrID id,
+                               IParamSerializer<T> const &iSerializer,
+                               T const &iValue,
+                               VstUtils::FastWriteMemoryStream &ioBuffer);
+
   /**
    * Deserializes the parameter value from an entry in the message
    *
@@ -151,13 +174,26 @@ template<typename T>
 tresult Message::setSerializableValue(IAttributeList::AttrID id, const IParamSerializer<T> &iSerializer, const T &iValue)
 {
   VstUtils::FastWriteMemoryStream stream{};
+  return setSerializableValue(id, iSerializer, iValue, stream);
+}
 
-  IBStreamer streamer{&stream};
+//------------------------------------------------------------------------
+// Message::setSerializableValue
+//------------------------------------------------------------------------
+template<typename T>
+tresult Message::setSerializableValue(IAttributeList::AttrID id,
+                                      IParamSerializer<T> const &iSerializer,
+                                      T const &iValue,
+                                      VstUtils::FastWriteMemoryStream &ioBuffer)
+{
+  ioBuffer.rewind();
+
+  IBStreamer streamer{&ioBuffer};
 
   tresult res = iSerializer.writeToStream(iValue, streamer);
   if(res == kResultOk)
   {
-    return setBinary(id, stream.getData(), stream.getSize());
+    return setBinary(id, ioBuffer.getData(), static_cast<uint32>(ioBuffer.getSize()));
   }
   return res;
 }
@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include "AudioBuffer.h"
+#include "ILatencySource.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace pongasoft::VST {
+
+namespace Impl {
+
+constexpr double kPi = 3.14159265358979323846264338327950288;
+
+// cos usable at compile time (std::cos is not constexpr)
+constexpr double constexprCos(double x)
+{
+  // reduce to [-pi, pi]
+  auto turns = static_cast<long long>(x / (2 * kPi));
+  x -= static_cast<double>(turns) * 2 * kPi;
+  if(x > kPi) x -= 2 * kPi;
+  if(x < -kPi) x += 2 * kPi;
+
+  // taylor series
+  double res = 1, term = 1;
+  for(int i = 1; i < 30; i++)
+  {
+    term *= -x * x / ((2 * i - 1) * (2 * i));
+    res += term;
+  }
+  return res;
+}
+
+/**
+ * Computes (at compile time) the non trivial coefficients of a half-band low pass filter with `4 * K - 1` taps: the
+ * center tap is `0.5`, every other even tap is `0` and the odd taps are symmetric, so only `h[1], h[3], ...
+ * h[2K - 1]` are returned. Windowed sinc (4-term Blackman-Harris window, ~90dB rejection) normalized for unity gain.
+ */
+template<typename SampleType, int K>
+constexpr std::array<SampleType, K> computeHalfBandCoefficients()
+{
+  std::array<double, K> coefficients{};
+  double sum = 0;
+  for(int k = 0; k < K; k++)
+  {
+    auto n = 2 * k + 1;
+    auto sinc = ((k % 2 == 0) ? 1.0 : -1.0) / (kPi * n); // sin(pi.n/2) / (pi.n)
+    auto x = kPi * n / (2 * K);
+    auto window = 0.35875 + 0.48829 * constexprCos(x) + 0.14128 * constexprCos(2 * x) + 0.01168 * constexprCos(3 * x);
+    coefficients[k] = sinc * window;
+    sum += coefficients[k];
+  }
+  // the side taps (both sides) must sum to 0.5 (unity gain at DC)
+  std::array<SampleType, K> res{};
+  for(int k = 0; k < K; k++)
+    res[k] = static_cast<SampleType>(coefficients[k] * 0.25 / sum);
+  return res;
+}
+
+template<typename SampleType, int K>
+constexpr std::array<SampleType, K> kHalfBandCoefficients = computeHalfBandCoefficients<SampleType, K>();
+
+/**
+ * Number of (side) coefficients of each 2x stage for a given oversampling factor: the first stage (lowest rate) needs
+ * a steep filter (the signal occupies the full band), the following stages can be much shorter since the signal
+ * only occupies a fraction of the band. */
+template<int Factor>
+struct OversamplerStages;
+
+template<>
+struct OversamplerStages<2> { static constexpr std::array<int, 1> kSideTaps{24}; };
+
+template<>
+struct OversamplerStages<4> { static constexpr std::array<int, 2> kSideTaps{24, 8}; };
+
+template<>
+struct OversamplerStages<8> { static constexpr std::array<int, 3> kSideTaps{24, 8, 4}; };
+
+// runtime access to the coefficients of the stages (only the sizes used in OversamplerStages are instantiated)
+template<typename SampleType>
+constexpr SampleType const *getHalfBandCoefficients(int iSideTaps)
+{
+  switch(iSideTaps)
+  {
+    case 24: return kHalfBandCoefficients<SampleType, 24>.data();
+    case 8: return kHalfBandCoefficients<SampleType, 8>.data();
+    case 4: return kHalfBandCoefficients<SampleType, 4>.data();
+    default: return nullptr;
+  }
+}
+
+}
+
+/**
+ * Oversampling (by `Factor` = 2, 4 or 8) meant for nonlinear processing (saturation, waveshaping...) in order to
+ * reduce aliasing: the input is upsampled into internal (owned) buffers, a kernel provided by the caller processes
+ * the buffers at the high sample rate, and the result is downsampled back into the output.
+ *
+ * The resampling is a cascade of 2x stages, each one being a polyphase half-band FIR filter (only half the
+ * coefficients of a half-band filter are non zero and the center one is 0.5, so each output sample costs about a
+ * quarter of the taps). The coefficients of each stage are computed at compile time (per factor).
+ *
+ * All the memory is allocated in the constructor: `process` does not allocate and is meant to be called from
+ * `RTProcessor::processInputs` (after registering the oversampler with `RTProcessor::addLatencySource` so that the
+ * latency of the filters is reported to the host). Typical usage:
+ *
+ * ```
+ * // in setupProcessing
+ * fOversampler = std::make_unique<Oversampler<Sample32, 4>>(2, setup.maxSamplesPerBlock);
+ *
+ * // in genericProcessInputs
+ * fOversampler->process(in, out, [](AudioBuffers32 &ioBuffers) {
+ *   ioBuffers.forEachSample([](Sample32 &s) { s = std::tanh(s); });
+ * });
+ * ```
+ *
+ * @tparam SampleType `float` or `double` (`Sample32` or `Sample64`)
+ * @tparam Factor the oversampling factor (2, 4 or 8)
+ */
+template<typename SampleType, int32 Factor>
+class Oversampler : public ILatencySource
+{
+  using stages_type = Impl::OversamplerStages<Factor>;
+
+public:
+  //! Number of 2x stages
+  static constexpr int32 kNumStages = static_cast<int32>(stages_type::kSideTaps.size());
+
+  static_assert((1 << kNumStages) == Factor, "Factor must be 2, 4 or 8");
+
+  /**
+   * The exact latency (in samples at the original rate) introduced by upsampling then downsampling (each stage
+   * delays by `2K - 1` samples at its rate, on the way up and on the way down). Note that it may not be an integer.
+   */
+  static constexpr double kLatency = []() {
+    double latency = 0;
+    for(int32 s = 0; s < kNumStages; s++)
+      latency += 2.0 * (2 * stages_type::kSideTaps[s] - 1) / (2 << s);
+    return latency;
+  }();
+
+  /**
+   * @param iNumChannels the (maximum) number of channels processed
+   * @param iMaxSamplesPerBlock the maximum number of samples processed at once (bigger blocks are split, meaning the
+   *                            kernel is called several times)
+   */
+  Oversampler(int32 iNumChannels, int32 iMaxSamplesPerBlock);
+
+  //! @return the oversampling factor
+  static constexpr int32 getFactor() { return Factor; }
+
+  //! @return the number of channels processed
+  inline int32 getNumChannels() const { return static_cast<int32>(fChannels.size()); }
+
+  //! @return the latency rounded to the nearest sample (see `kLatency`)
+  uint32 getLatencySamples() const override { return static_cast<uint32>(std::lround(kLatency)); }
+
+  /**
+   * Upsamples `iIn`, calls `iKernel` with the upsampled buffers and downsamples the result into `oOut` (which can be
+   * the same buffers as `iIn`). The kernel has the following signature (the buffers contain `Factor` times the
+   * number of samples of the block):
+   *
+   * ```
+   * void kernel(AudioBuffers<SampleType> &ioBuffers);
+   * ```
+   *
+   * The silence flags of `oOut` are adjusted. */
+  template<typename Kernel>
+  void process(AudioBuffers<SampleType> const &iIn, AudioBuffers<SampleType> &oOut, Kernel &&iKernel);
+
+  //! Clears the internal state (filters history)
+  void reset();
+
+private:
+  // upsamples iNumSamples samples of iIn (starting at iOffset) into fOversampled
+  void upsample(AudioBuffers<SampleType> const &iIn, int32 iOffset, int32 iNumSamples);
+
+  // downsamples fOversampled into iNumSamples samples of oOut (starting at iOffset)
+  void downsample(AudioBuffers<SampleType> &oOut, int32 iOffset, int32 iNumSamples);
+
+  // y[2m] = 2 * sum(c[k] * (x[m-K-k+1] + x[m-K+k])), y[2m+1] = x[m-K+1] (iInput[-(2K-1)] must be valid)
+  static void upsample2x(SampleType const *iCoefficients, int32 K,
+                         SampleType const *iInput, int32 iNumSamples, SampleType *oOutput);
+
+  // z[m] = 0.5 * x[2m-2K+1] + sum(c[k] * (x[2m-2K-2k+2] + x[2m-2K+2k])) (iInput[-(4K-2)] must be valid)
+  static void downsample2x(SampleType const *iCoefficients, int32 K,
+                           SampleType const *iInput, int32 iNumSamples, SampleType *oOutput);
+
+  // the buffers of a stage (each one starts with the history of the filter)
+  struct Stage
+  {
+    std::vector<SampleType> fUp;   // input of the upsampling filter (at the rate of the previous stage)
+    std::vector<SampleType> fDown; // input of the downsampling filter (at the rate of this stage)
+  };
+
+  static constexpr int32 getUpHistory(int32 s) { return 2 * stages_type::kSideTaps[s] - 1; }
+  static constexpr int32 getDownHistory(int32 s) { return 4 * stages_type::kSideTaps[s] - 2; }
+
+private:
+  int32 const fMaxSamplesPerBlock;
+  std::vector<std::array<Stage, kNumStages>> fChannels;
+  OwnedAudioBuffers<SampleType> fOversampled;
+};
+
+//------------------------------------------------------------------------
+// Oversampler::Oversampler
+//------------------------------------------------------------------------
+template<typename SampleType, int32 Factor>
+Oversampler<SampleType, Factor>::Oversampler(int32 iNumChannels, int32 iMaxSamplesPerBlock) :
+  fMaxSamplesPerBlock{std::max(iMaxSamplesPerBlock, 1)},
+  fChannels(static_cast<size_t>(std::max(iNumChannels, 0))),
+  fOversampled{std::max(iNumChannels, 0), std::max(iMaxSamplesPerBlock, 1) * Factor}
+{
+  for(auto &stages: fChannels)
+  {
+    for(int32 s = 0; s < kNumStages; s++)
+    {
+      auto numSamples = static_cast<size_t>(fMaxSamplesPerBlock) << s; // at the rate of the previous stage
+      stages[s].fUp.resize(getUpHistory(s) + numSamples);
+      stages[s].fDown.resize(getDownHistory(s) + 2 * numSamples);
+    }
+  }
+}
+
+//------------------------------------------------------------------------
+// Oversampler::reset
+//------------------------------------------------------------------------
+template<typename SampleType, int32 Factor>
+void Oversampler<SampleType, Factor>::reset()
+{
+  for(auto &stages: fChannels)
+  {
+    for(auto &stage: stages)
+    {
+      std::fill(stage.fUp.begin(), stage.fUp.end(), 0);
+      std::fill(stage.fDown.begin(), stage.fDown.end(), 0);
+    }
+  }
+  fOversampled.clear();
+}
+
+//------------------------------------------------------------------------
+// Oversampler::process
+//------------------------------------------------------------------------
+template<typename SampleType, int32 Factor>
+template<typename Kernel>
+void Oversampler<SampleType, Factor>::process(AudioBuffers<SampleType> const &iIn,
+                                              AudioBuffers<SampleType> &oOut,
+                                              Kernel &&iKernel)
+{
+  auto const numSamples = std::min(iIn.getNumSamples(), oOut.getNumSamples());
+
+  for(int32 offset = 0; offset < numSamples; offset += fMaxSamplesPerBlock)
+  {
+    auto n = std::min(fMaxSamplesPerBlock, numSamples - offset);
+
+    upsample(iIn, offset, n);
+
+    // there is no easy way to know if the upsampled buffers are silent so they are flagged as not silent
+    fOversampled.setSilenceFlags(0);
+    auto oversampled = fOversampled.view(n * Factor);
+    iKernel(oversampled);
+
+    downsample(oOut, offset, n);
+  }
+
+  oOut.adjustSilenceFlags();
+}
+
+//------------------------------------------------------------------------
+// Oversampler::upsample
+//------------------------------------------------------------------------
+template<typename SampleType, int32 Factor>
+void Oversampler<SampleType, Factor>::upsample(AudioBuffers<SampleType> const &iIn, int32 iOffset, int32 iNumSamples)
+{
+  auto inputs = iIn.getBuffer();
+  auto oversampled = fOversampled.getBuffer();
+
+  for(int32 c = 0; c < getNumChannels(); c++)
+  {
+    auto &stages = fChannels[c];
+
+    // copy the input after the history of the first stage
+    auto input = stages[0].fUp.data() + getUpHistory(0);
+    if(inputs && c < iIn.getNumChannels() && inputs[c])
+      std::copy(inputs[c] + iOffset, inputs[c] + iOffset + iNumSamples, input);
+    else
+      std::fill(input, input + iNumSamples, 0);
+
+    // each stage writes directly into the input of the next stage (or the oversampled buffers for the last one)
+    for(int32 s = 0; s < kNumStages; s++)
+    {
+      auto &up = stages[s].fUp;
+      auto history = getUpHistory(s);
+      auto n = iNumSamples << s;
+      auto output = s + 1 < kNumStages ? stages[s + 1].fUp.data() + getUpHistory(s + 1) : oversampled[c];
+
+      upsample2x(Impl::getHalfBandCoefficients<SampleType>(stages_type::kSideTaps[s]), stages_type::kSideTaps[s],
+                 up.data() + history, n, output);
+
+      // keep the history for the next block
+      std::copy(up.begin() + n, up.begin() + n + history, up.begin());
+    }
+  }
+}
+
+//------------------------------------------------------------------------
+// Oversampler::downsample
+//------------------------------------------------------------------------
+template<typename SampleType, int32 Factor>
+void Oversampler<SampleType, Factor>::downsample(AudioBuffers<SampleType> &oOut, int32 iOffset, int32 iNumSamples)
+{
+  auto outputs = oOut.getBuffer();
+  auto oversampled = fOversampled.getBuffer();
+
+  for(int32 c = 0; c < getNumChannels(); c++)
+  {
+    auto &stages = fChannels[c];
+
+    // copy the oversampled buffer after the history of the last stage
+    std::copy(oversampled[c], oversampled[c] + iNumSamples * Factor,
+              stages[kNumStages - 1].fDown.data() + getDownHistory(kNumStages - 1));
+
+    auto output = outputs && c < oOut.getNumChannels() ? outputs[c] : nullptr;
+
+    for(int32 s = kNumStages - 1; s >= 0; s--)
+    {
+      auto &down = stages[s].fDown;
+      auto history = getDownHistory(s);
+      auto n = iNumSamples << s; // number of output samples
+
+      if(s > 0)
+        downsample2x(Impl::getHalfBandCoefficients<SampleType>(stages_type::kSideTaps[s]), stages_type::kSideTaps[s],
+                     down.data() + history, n, stages[s - 1].fDown.data() + getDownHistory(s - 1));
+      else if(output)
+        downsample2x(Impl::getHalfBandCoefficients<SampleType>(stages_type::kSideTaps[s]), stages_type::kSideTaps[s],
+                     down.data() + history, n, output + iOffset);
+
+      // keep the history for the next block
+      std::copy(down.begin() + 2 * n, down.begin() + 2 * n + history, down.begin());
+    }
+  }
+}
+
+//------------------------------------------------------------------------
+// Oversampler::upsample2x
+//------------------------------------------------------------------------
+template<typename SampleType, int32 Factor>
+void Oversampler<SampleType, Factor>::upsample2x(SampleType const *iCoefficients, int32 K,
+                                                 SampleType const *iInput, int32 iNumSamples, SampleType *oOutput)
+{
+  for(int32 m = 0; m < iNumSamples; m++)
+  {
+    // symmetric filter: x[m-K-k+1] and x[m-K+k] share the same coefficient
+    auto center = iInput + m - K;
+    SampleType acc = 0;
+    for(int32 k = 1; k <= K; k++)
+      acc += iCoefficients[k - 1] * (center[1 - k] + center[k]);
+
+    oOutput[2 * m] = 2 * acc;
+    oOutput[2 * m + 1] = center[1];
+  }
+}
+
+//------------------------------------------------------------------------
+// Oversampler::downsample2x
+//------------------------------------------------------------------------
+template<typename SampleType, int32 Factor>
+void Oversampler<SampleType, Factor>::downsample2x(SampleType const *iCoefficients, int32 K,
+                                                   SampleType const *iInput, int32 iNumSamples, SampleType *oOutput)
+{
+  for(int32 m = 0; m < iNumSamples; m++)
+  {
+    // symmetric filter: x[2m-2K-2k+2] and x[2m-2K+2k] share the same coefficient
+    auto center = iInput + 2 * m - 2 * K;
+    SampleType acc = center[1] / 2;
+    for(int32 k = 1; k <= K; k++)
+      acc += iCoefficients[k - 1] * (center[2 - 2 * k] + center[2 * k]);
+
+    oOutput[m] = acc;
+  }
+}
+
+}
@@ -485,5 +485,89 @@ private:
   DiscreteValueParamConverter<MaxValue, IntType> fConverter;
 };
 
+/**
+ * Adapter which makes `denormalize` cheap for a converter whose `denormalize` is expensive (typically a curve using
+ * `std::pow`, `std::log` or `std::exp` for a frequency, a gain or a time): the wrapped converter is sampled once (in
+ * the constructor) on `TableSize + 1` points evenly spaced in `[0, 1]` and `denormalize` interpolates linearly between
+ * the 2 closest points. `normalize`, `getStepCount` and `toString` are delegated to the wrapped converter.
+ *
+ * The constructor also measures the error of the interpolation (in the middle of each interval, which is where it is
+ * the largest for a smooth curve) so that `TableSize` can be adjusted (see `getMaxError()`).
+ *
+ * Example: `vst<LUTParamConverter<FrequencyParamConverter>>(...)` (the arguments are forwarded to the constructor of
+ * the wrapped converter). Using `add<LUTParamConverter<FrequencyParamConverter>>()` to build the parameter also gets
+ * rid of the virtual call (see `VstParamDef<T, Converter>`).
+ *
+ * @tparam Converter the wrapped converter (`Converter::ParamType` must be a floating point type)
+ * @tparam TableSize the number of intervals in the table
+ */
+template<typename Converter, int32 TableSize = 1024>
+class LUTParamConverter : public IParamConverter<typename Converter::ParamType>
+{
+public:
+  using ParamType = typename Converter::ParamType;
+
+  static_assert(std::is_floating_point_v<ParamType>, "LUTParamConverter requires a floating point ParamType");
+  static_assert(TableSize > 0, "TableSize must be positive");
+
+  using IParamConverter<ParamType>::toString;
+
+  // Constructor (the arguments are forwarded to the wrapped converter)
+  template<typename... Args>
+  explicit LUTParamConverter(Args&& ...iArgs) : fConverter(std::forward<Args>(iArgs)...)
+  {
+    for(int32 i = 0; i <= TableSize; i++)
+      fTable[i] = fConverter.denormalize(static_cast<ParamValue>(i) / TableSize);
+
+    for(int32 i = 0; i < TableSize; i++)
+    {
+      auto x = (i + 0.5) / TableSize;
+      auto error = std::abs(static_cast<double>(denormalize(x)) - static_cast<double>(fConverter.denormalize(x)));
+      fMaxError = std::max(fMaxError, error);
+    }
+  }
+
+  //! @return the wrapped converter
+  inline Converter const &getConverter() const { return fConverter; }
+
+  //! @return the max (absolute) error of `denormalize` compared to the wrapped converter
+  inline double getMaxError() const { return fMaxError; }
+
+  // getStepCount
+  inline int32 getStepCount() const override { return fConverter.getStepCount(); }
+
+  // normalize
+  inline ParamValue normalize(ParamType const &iValue) const override
+  {
+    return fConverter.normalize(iValue);
+  }
+
+  // denormalize (table lookup)
+  inline ParamType denormalize(ParamValue iNormalizedValue) const override
+  {
+    auto x = Utils::clamp(iNormalizedValue, 0.0, 1.0) * TableSize;
+    auto index = std::min(static_cast<int32>(x), TableSize - 1);
+    auto fraction = static_cast<ParamType>(x - index);
+    return fTable[index] + (fTable[index + 1] - fTable[index]) * fraction;
+  }
+
+  // toString
+  inline void toString(ParamType const &iValue, String128 oString, int32 iPrecision) const override
+  {
+    fConverter.toString(iValue, oString, iPrecision);
+  }
+
+  // toString
+  inline std::string toString(ParamType const &iValue, int32 iPrecision) const override
+  {
+    return fConverter.toString(iValue, iPrecision);
+  }
+
+private:
+  Converter fConverter;
+  std::array<ParamType, TableSize + 1> fTable{};
+  double fMaxError{0};
+};
+
 
 }
@@ -29,6 +29,8 @@
 
 #include <string>
 #include <memory>
+#include <type_traits>
+#include <typeinfo>
 
 namespace pongasoft::VST {
 
@@ -169,11 +171,16 @@ public:
   const int32 fPrecision;
 };
 
+template<typename T, typename Converter = void>
+class VstParamDef;
+
 /**
- * Typed parameter definition.
+ * Typed parameter definition. The converter is accessed through the `IParamConverter<T>` api (virtual calls). See
+ * `VstParamDef<T, Converter>` for a version where the type of the converter is known at compile time.
+ *
  * @tparam T the underlying type of the param */
 template<typename T>
-class VstParamDef : public RawVstParamDef
+class VstParamDef<T, void> : public RawVstParamDef
 {
 public:
   using ParamType = T;
@@ -273,6 +280,96 @@ public:
   const std::shared_ptr<IParamConverter<ParamType>> fConverter;
 };
 
+/**
+ * Typed parameter definition whose converter type is known at compile time: `normalize` and `denormalize` call the
+ * converter directly (non virtual calls which can be inlined) which makes a difference on the RT path (see
+ * `RT::RTVstParameter<T, Converter>`) where `denormalize` is called for every parameter change (and every automation
+ * point when sample accurate automation is enabled).
+ *
+ * Since this class is a `VstParamDef<T>` (with the very same converter), it can be used wherever a `VstParamDef<T>`
+ * is expected (GUI, debug...).
+ *
+ * The direct call is only possible when the converter is exactly of type `Converter` (always the case when
+ * `Converter` is `final`): when it is a subclass (which may override `normalize` or `denormalize`), the virtual
+ * `IParamConverter<T>` api is used instead so that the result is always the same as `VstParamDef<T>`.
+ *
+ * @tparam T the underlying type of the param
+ * @tparam Converter the (concrete) type of the converter (must be a subclass of `IParamConverter<T>`) */
+template<typename T, typename Converter>
+class VstParamDef : public VstParamDef<T>
+{
+  static_assert(std::is_base_of_v<IParamConverter<T>, Converter>, "Converter must implement IParamConverter<T>");
+
+public:
+  using ParamType = T;
+  using ConverterType = Converter;
+
+  VstParamDef(ParamID const iParamID,
+              VstString16 iTitle,
+              VstString16 iUnits,
+              ParamType const iDefaultValue,
+              int32 const iFlags,
+              UnitID const iUnitID,
+              VstString16 iShortTitle,
+              int32 const iPrecision,
+              IParamDef::Owner const iOwner,
+              bool const iTransient,
+              int16 const iDeprecatedSince,
+              std::shared_ptr<Converter> iConverter) :
+    VstParamDef<T>(iParamID,
+                   std::move(iTitle),
+                   std::move(iUnits),
+                   iDefaultValue,
+                   iFlags,
+                   iUnitID,
+                   std::move(iShortTitle),
+                   iPrecision,
+                   iOwner,
+                   iTransient,
+                   iDeprecatedSince,
+                   iConverter),
+    fStaticConverter{iConverter.get()},
+    fExactConverter{std::is_final_v<Converter> || (iConverter && typeid(*iConverter) == typeid(Converter))}
+  {
+    DCHECK_F(fStaticConverter != nullptr, "Converter is required for parameter [%d]", iParamID);
+  }
+
+  // normalize (non virtual call unless the converter is a subclass of Converter)
+  inline ParamValue normalize(ParamType const &iValue) const
+  {
+    if(isExactConverter())
+      return fStaticConverter->Converter::normalize(iValue);
+    else
+      return VstParamDef<T>::normalize(iValue);
+  }
+
+  // denormalize (non virtual call unless the converter is a subclass of Converter)
+  inline ParamType denormalize(ParamValue iNormalizedValue) const
+  {
+    if(isExactConverter())
+      return fStaticConverter->Converter::denormalize(iNormalizedValue);
+    else
+      return VstParamDef<T>::denormalize(iNormalizedValue);
+  }
+
+  //! @return `true` if the converter is exactly of type `Converter` (meaning the calls are not virtual)
+  inline bool isExactConverter() const
+  {
+    if constexpr(std::is_final_v<Converter>)
+      return true;
+    else
+      return fExactConverter;
+  }
+
+  // getConverter
+  inline Converter const &getConverter() const { return *fStaticConverter; }
+
+private:
+  // same object as fConverter (owned by it)
+  Converter const *fStaticConverter;
+  bool fExactConverter;
+};
+
 /**
  * Base class for jamba parameters (non templated)
  */
@@ -328,7 +425,8 @@ public:
               std::shared_ptr<IParamSerializer<ParamType>> iSerializer) :
     IJmbParamDef(iParamID, std::move(iTitle), iOwner, iTransient, iDeprecatedSince, iShared),
     fDefaultValue{iDefaultValue},
-    fSerializer{std::move(iSerializer)}
+    fSerializer{std::move(iSerializer)},
+    fMessageAttrID{computeMessageAttrID()}
   {}
 
   // readFromStream
@@ -350,6 +448,9 @@ public:
   // writeToMessage
   tresult writeToMessage(ParamType const &iValue, Message &oMessage) const;
 
+  // writeToMessage (using ioBuffer for serialization instead of allocating a new one)
+  tresult writeToMessage(ParamType const &iValue, Message &oMessage, VstUtils::FastWriteMemoryStream &ioBuffer) const;
+
   /**
    * Return the value as a utf-8 string
    *
@@ -410,6 +511,9 @@ public:
 public:
   const ParamType fDefaultValue;
   const std::shared_ptr<IParamSerializer<ParamType>> fSerializer;
+
+  // the attribute used in messages (computed once)
+  const std::string fMessageAttrID;
 };
 
 //------------------------------------------------------------------------
@@ -484,7 +588,7 @@ template<typename T>
 tresult JmbParamDef<T>::readFromMessage(Message const &iMessage, ParamType &oValue) const
 {
   if(fSerializer)
-    return iMessage.getSerializableValue(computeMessageAttrID().c_str(), *this, oValue);
+    return iMessage.getSerializableValue(fMessageAttrID.c_str(), *this, oValue);
   else
     return kResultFalse;
 }
@@ -496,7 +600,21 @@ template<typename T>
 tresult JmbParamDef<T>::writeToMessage(const ParamType &iValue, Message &oMessage) const
 {
   if(fSerializer)
-    return oMessage.setSerializableValue(computeMessageAttrID().c_str(), *this, iValue);
+    return oMessage.setSerializableValue(fMessageAttrID.c_str(), *this, iValue);
+  else
+    return kResultFalse;
+}
+
+//------------------------------------------------------------------------
+// JmbParamDef::writeToMessage
+//------------------------------------------------------------------------
+template<typename T>
+tresult JmbParamDef<T>::writeToMessage(ParamType const &iValue,
+                                       Message &oMessage,
+                                       VstUtils::FastWriteMemoryStream &ioBuffer) const
+{
+  if(fSerializer)
+    return oMessage.setSerializableValue(fMessageAttrID.c_str(), *this, iValue, ioBuffer);
   else
     return kResultFalse;
 }
@@ -506,6 +624,8 @@ tresult JmbParamDef<T>::writeToMessage(const ParamType &iValue, Message &oMessag
 //------------------------------------------------------------------------
 template<typename T>
 using VstParam = std::shared_ptr<VstParamDef<T>>;
+template<typename T, typename Converter>
+using TVstParam = std::shared_ptr<VstParamDef<T, Converter>>;
 using RawVstParam = std::shared_ptr<RawVstParamDef>;
 
 //------------------------------------------------------------------------
@@ -135,6 +135,15 @@ public:
     // parameter factory method
     VstParam<T> add() const;
 
+    /**
+     * Parameter factory method when the type of the converter is known at compile time (ex:
+     * `vst<PercentParamConverter>(...).add<PercentParamConverter>()`): the converter is then accessed without virtual
+     * calls (see `VstParamDef<T, Converter>`). The converter of this builder must be of type `ParamConverter`
+     * (otherwise `nullptr` is returned). A subclass of `ParamConverter` is accepted but is then accessed with
+     * virtual calls (so that its overrides are honored). */
+    template<typename ParamConverter>
+    TVstParam<T, ParamConverter> add() const;
+
     // fields
     ParamID fParamID;
     VstString16 fTitle;
@@ -429,6 +438,10 @@ protected:
   template<typename T>
   VstParam<T> add(VstParamDefBuilder<T> const &iBuilder);
 
+  // internally called by the builder
+  template<typename T, typename ParamConverter>
+  TVstParam<T, ParamConverter> add(VstParamDefBuilder<T> const &iBuilder);
+
   // internally called by the builder
   template<typename T>
   JmbParam<T> add(JmbParamDefBuilder<T> const &iBuilder);
@@ -486,9 +499,11 @@ private:
     return buildParamIDs(iParamIDs, iParamDef->fParamID, std::forward<Args>(args)...);
   }
 
-  // case when VstParamDef
-  template<typename ParamConverver, typename... Args>
-  tresult buildParamIDs(std::vector<ParamID> &iParamIDs, std::shared_ptr<VstParamDef<ParamConverver>> &iParamDef, Args&& ...args)
+  // case when VstParamDef (with or without compile time converter)
+  template<typename T, typename ParamConverter, typename... Args>
+  tresult buildParamIDs(std::vector<ParamID> &iParamIDs,
+                        std::shared_ptr<VstParamDef<T, ParamConverter>> &iParamDef,
+                        Args&& ...args)
   {
     return buildParamIDs(iParamIDs, iParamDef->fParamID, std::forward<Args>(args)...);
   }
@@ -557,6 +572,49 @@ VstParam<T> Parameters::add(VstParamDefBuilder<T> const &iBuilder)
     return nullptr;
 }
 
+//------------------------------------------------------------------------
+// Parameters::VstParamDefBuilder::add
+//------------------------------------------------------------------------
+template<typename T>
+template<typename ParamConverter>
+TVstParam<T, ParamConverter> Parameters::VstParamDefBuilder<T>::add() const
+{
+  return fParameters->template add<T, ParamConverter>(*this);
+}
+
+//------------------------------------------------------------------------
+// Parameters::add (called by the builder)
+//------------------------------------------------------------------------
+template<typename T, typename ParamConverter>
+TVstParam<T, ParamConverter> Parameters::add(VstParamDefBuilder<T> const &iBuilder)
+{
+  auto converter = std::dynamic_pointer_cast<ParamConverter>(iBuilder.fConverter);
+
+  if(!converter)
+  {
+    DLOG_F(ERROR, "Converter for parameter [%d] is missing or is not of the expected type", iBuilder.fParamID);
+    return nullptr;
+  }
+
+  auto param = std::make_shared<VstParamDef<T, ParamConverter>>(iBuilder.fParamID,
+                                                                iBuilder.fTitle,
+                                                                iBuilder.fUnits,
+                                                                iBuilder.fDefaultValue,
+                                                                iBuilder.fFlags,
+                                                                iBuilder.fUnitID,
+                                                                iBuilder.fShortTitle,
+                                                                iBuilder.fPrecision,
+                                                                iBuilder.fOwner,
+                                                                iBuilder.fTransient,
+                                                                iBuilder.fDeprecatedSince,
+                                                                std::move(converter));
+
+  if(addVstParamDef(param) == kResultOk)
+    return param;
+  else
+    return nullptr;
+}
+
 //------------------------------------------------------------------------
 // Parameters::add (called by the builder)
 //------------------------------------------------------------------------
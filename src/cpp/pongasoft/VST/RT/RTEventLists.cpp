@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#include "RTEventLists.h"
+
+#include <pongasoft/logging/logging.h>
+
+#include <algorithm>
+
+namespace pongasoft::VST::RT {
+
+IMPLEMENT_FUNKNOWN_METHODS(RTEventList, IEventList, IEventList::iid)
+IMPLEMENT_FUNKNOWN_METHODS(RTParamValueQueue, IParamValueQueue, IParamValueQueue::iid)
+IMPLEMENT_FUNKNOWN_METHODS(RTParameterChanges, IParameterChanges, IParameterChanges::iid)
+
+namespace {
+
+// true if iOffset is in [iFromOffset, iToOffset[
+inline bool inRange(int32 iOffset, int32 iFromOffset, int32 iToOffset)
+{
+  return iOffset >= iFromOffset && iOffset < iToOffset;
+}
+
+}
+
+//------------------------------------------------------------------------
+// RTEventList::RTEventList
+//------------------------------------------------------------------------
+RTEventList::RTEventList() : IEventList{}
+{
+  FUNKNOWN_CTOR
+}
+
+//------------------------------------------------------------------------
+// RTEventList::setCapacity
+//------------------------------------------------------------------------
+void RTEventList::setCapacity(int32 iCapacity)
+{
+  fEvents.resize(static_cast<size_t>(std::max(iCapacity, 0)));
+  fNumEvents = 0;
+}
+
+//------------------------------------------------------------------------
+// RTEventList::getEvent
+//------------------------------------------------------------------------
+tresult RTEventList::getEvent(int32 index, Event &e)
+{
+  if(index < 0 || index >= fNumEvents)
+    return kInvalidArgument;
+
+  e = fEvents[index];
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RTEventList::addEvent
+//------------------------------------------------------------------------
+tresult RTEventList::addEvent(Event &e)
+{
+  if(fNumEvents == static_cast<int32>(fEvents.size()))
+    return kResultFalse;
+
+  fEvents[fNumEvents++] = e;
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RTEventList::copyFrom
+//------------------------------------------------------------------------
+bool RTEventList::copyFrom(IEventList *iEvents, int32 iFromOffset, int32 iToOffset, int32 iShift)
+{
+  if(!iEvents)
+    return true;
+
+  bool res = true;
+
+  auto count = iEvents->getEventCount();
+  for(int32 i = 0; i < count; i++)
+  {
+    Event e{};
+    if(iEvents->getEvent(i, e) != kResultOk || !inRange(e.sampleOffset, iFromOffset, iToOffset))
+      continue;
+
+    e.sampleOffset += iShift;
+    if(addEvent(e) != kResultOk)
+      res = false;
+  }
+
+  if(!res)
+    DLOG_F(WARNING, "RTEventList::copyFrom - capacity [%d] reached, events dropped",
+           static_cast<int32>(fEvents.size()));
+
+  return res;
+}
+
+//------------------------------------------------------------------------
+// RTEventList::moveTo
+//------------------------------------------------------------------------
+bool RTEventList::moveTo(IEventList *oEvents, int32 iOffset, int32 iShift)
+{
+  bool res = true;
+
+  int32 numRemaining = 0;
+  for(int32 i = 0; i < fNumEvents; i++)
+  {
+    auto e = fEvents[i];
+    if(e.sampleOffset < iOffset)
+    {
+      e.sampleOffset += iShift;
+      if(oEvents && oEvents->addEvent(e) != kResultOk)
+        res = false;
+    }
+    else
+    {
+      e.sampleOffset -= iOffset;
+      fEvents[numRemaining++] = e;
+    }
+  }
+  fNumEvents = numRemaining;
+
+  return res;
+}
+
+//------------------------------------------------------------------------
+// RTParamValueQueue::RTParamValueQueue
+//------------------------------------------------------------------------
+RTParamValueQueue::RTParamValueQueue() : IParamValueQueue{}
+{
+  FUNKNOWN_CTOR
+}
+
+//------------------------------------------------------------------------
+// RTParamValueQueue::setCapacity
+//------------------------------------------------------------------------
+void RTParamValueQueue::setCapacity(int32 iCapacity)
+{
+  fPoints.resize(static_cast<size_t>(std::max(iCapacity, 1)));
+  fNumPoints = 0;
+}
+
+//------------------------------------------------------------------------
+// RTParamValueQueue::getPoint
+//------------------------------------------------------------------------
+tresult RTParamValueQueue::getPoint(int32 index, int32 &sampleOffset, ParamValue &value)
+{
+  if(index < 0 || index >= fNumPoints)
+    return kInvalidArgument;
+
+  sampleOffset = fPoints[index].first;
+  value = fPoints[index].second;
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RTParamValueQueue::addPoint
+//------------------------------------------------------------------------
+tresult RTParamValueQueue::addPoint(int32 sampleOffset, ParamValue value, int32 &index)
+{
+  if(fPoints.empty())
+    return kResultFalse;
+
+  // finds where the point goes (points are usually added in order => starts from the end)
+  auto i = fNumPoints;
+  while(i > 0 && fPoints[i - 1].first > sampleOffset)
+    i--;
+
+  // same offset => replaces the value
+  if(i > 0 && fPoints[i - 1].first == sampleOffset)
+  {
+    fPoints[i - 1].second = value;
+    index = i - 1;
+    return kResultOk;
+  }
+
+  // full => the last point is replaced (a point which is not the last one is dropped)
+  if(fNumPoints == static_cast<int32>(fPoints.size()))
+  {
+    if(i < fNumPoints)
+      return kResultFalse;
+
+    fPoints[fNumPoints - 1] = {sampleOffset, value};
+    index = fNumPoints - 1;
+    return kResultOk;
+  }
+
+  std::move_backward(fPoints.begin() + i, fPoints.begin() + fNumPoints, fPoints.begin() + fNumPoints + 1);
+  fPoints[i] = {sampleOffset, value};
+  fNumPoints++;
+  index = i;
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RTParamValueQueue::swap
+//------------------------------------------------------------------------
+void RTParamValueQueue::swap(RTParamValueQueue &ioOther)
+{
+  std::swap(fParamID, ioOther.fParamID);
+  fPoints.swap(ioOther.fPoints);
+  std::swap(fNumPoints, ioOther.fNumPoints);
+}
+
+//------------------------------------------------------------------------
+// RTParameterChanges::RTParameterChanges
+//------------------------------------------------------------------------
+RTParameterChanges::RTParameterChanges() : IParameterChanges{}
+{
+  FUNKNOWN_CTOR
+}
+
+//------------------------------------------------------------------------
+// RTParameterChanges::setCapacity
+//------------------------------------------------------------------------
+void RTParameterChanges::setCapacity(int32 iMaxParameters, int32 iMaxPointsPerParameter)
+{
+  fQueues.resize(static_cast<size_t>(std::max(iMaxParameters, 0)));
+  for(auto &queue: fQueues)
+    queue.setCapacity(iMaxPointsPerParameter);
+  fNumQueues = 0;
+}
+
+//------------------------------------------------------------------------
+// RTParameterChanges::getTotalPointCount
+//------------------------------------------------------------------------
+int32 RTParameterChanges::getTotalPointCount() const
+{
+  int32 count = 0;
+  for(int32 i = 0; i < fNumQueues; i++)
+    count += fQueues[i].fNumPoints;
+  return count;
+}
+
+//------------------------------------------------------------------------
+// RTParameterChanges::getParameterData
+//------------------------------------------------------------------------
+IParamValueQueue *RTParameterChanges::getParameterData(int32 index)
+{
+  if(index < 0 || index >= fNumQueues)
+    return nullptr;
+
+  return &fQueues[index];
+}
+
+//------------------------------------------------------------------------
+// RTParameterChanges::addParameterData
+//------------------------------------------------------------------------
+IParamValueQueue *RTParameterChanges::addParameterData(const ParamID &id, int32 &index)
+{
+  for(int32 i = 0; i < fNumQueues; i++)
+  {
+    if(fQueues[i].fParamID == id)
+    {
+      index = i;
+      return &fQueues[i];
+    }
+  }
+
+  if(fNumQueues == static_cast<int32>(fQueues.size()))
+    return nullptr;
+
+  index = fNumQueues++;
+  fQueues[index].reset(id);
+  return &fQueues[index];
+}
+
+//------------------------------------------------------------------------
+// RTParameterChanges::copyFrom
+//------------------------------------------------------------------------
+bool RTParameterChanges::copyFrom(IParameterChanges *iChanges, int32 iFromOffset, int32 iToOffset, int32 iShift)
+{
+  if(!iChanges)
+    return true;
+
+  bool res = true;
+
+  auto numParams = iChanges->getParameterCount();
+  for(int32 i = 0; i < numParams; i++)
+  {
+    auto paramQueue = iChanges->getParameterData(i);
+    if(!paramQueue)
+      continue;
+
+    IParamValueQueue *queue = nullptr;
+
+    auto numPoints = paramQueue->getPointCount();
+    for(int32 j = 0; j < numPoints; j++)
+    {
+      int32 sampleOffset;
+      ParamValue value;
+      if(paramQueue->getPoint(j, sampleOffset, value) != kResultOk || !inRange(sampleOffset, iFromOffset, iToOffset))
+        continue;
+
+      // the queue is only added when there is at least one point in range
+      int32 index;
+      if(!queue)
+        queue = addParameterData(paramQueue->getParameterId(), index);
+
+      if(!queue)
+      {
+        res = false;
+        break;
+      }
+
+      queue->addPoint(sampleOffset + iShift, value, index);
+    }
+  }
+
+  if(!res)
+    DLOG_F(WARNING, "RTParameterChanges::copyFrom - capacity [%d] reached, changes dropped",
+           static_cast<int32>(fQueues.size()));
+
+  return res;
+}
+
+//------------------------------------------------------------------------
+// RTParameterChanges::moveTo
+//------------------------------------------------------------------------
+bool RTParameterChanges::moveTo(IParameterChanges *oChanges, int32 iOffset, int32 iShift)
+{
+  bool res = true;
+
+  int32 numRemainingQueues = 0;
+  for(int32 i = 0; i < fNumQueues; i++)
+  {
+    auto &queue = fQueues[i];
+
+    IParamValueQueue *paramQueue = nullptr;
+    int32 index;
+
+    int32 numRemainingPoints = 0;
+    for(int32 j = 0; j < queue.fNumPoints; j++)
+    {
+      auto point = queue.fPoints[j];
+      if(point.first < iOffset)
+      {
+        if(oChanges)
+        {
+          if(!paramQueue)
+            paramQueue = oChanges->addParameterData(queue.fParamID, index);
+          if(!paramQueue || paramQueue->addPoint(point.first + iShift, point.second, index) != kResultOk)
+            res = false;
+        }
+      }
+      else
+      {
+        point.first -= iOffset;
+        queue.fPoints[numRemainingPoints++] = point;
+      }
+    }
+    queue.fNumPoints = numRemainingPoints;
+
+    // keeps the queue only if it still has points (swapping does not allocate)
+    if(numRemainingPoints > 0)
+    {
+      if(numRemainingQueues != i)
+        fQueues[numRemainingQueues].swap(queue);
+      numRemainingQueues++;
+    }
+  }
+  fNumQueues = numRemainingQueues;
+
+  return res;
+}
+
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include <pluginterfaces/vst/ivstevents.h>
+#include <pluginterfaces/vst/ivstparameterchanges.h>
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace pongasoft::VST::RT {
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+//! Sample offsets used to express "no lower bound" / "no upper bound" (see `RTEventList::copyFrom`)
+constexpr int32 kMinSampleOffset = std::numeric_limits<int32>::min();
+constexpr int32 kMaxSampleOffset = std::numeric_limits<int32>::max();
+
+/**
+ * Implementation of `IEventList` backed by storage preallocated with `setCapacity` so that it can be filled and
+ * emptied in the RT thread. `RTProcessor` uses it to hand to `processInputs` the events of a sub-block (see
+ * `RTProcessor::enableSampleAccurateAutomation`) or of a fixed block (see `RTProcessor::enableFixedBlockProcessing`)
+ * with offsets relative to the (sub-)block, as well as to queue events across frames.
+ *
+ * Events added past the capacity are dropped (`addEvent` returns `kResultFalse`). Note that the payload of data
+ * events (bytes) and text events is not copied: it is only valid for the duration of the host frame.
+ */
+class RTEventList : public IEventList
+{
+public:
+  RTEventList();
+  virtual ~RTEventList() = default;
+
+  //! Allocates the storage (NOT RT safe) and removes all events
+  void setCapacity(int32 iCapacity);
+
+  //! Removes all events
+  inline void clear() { fNumEvents = 0; }
+
+  /**
+   * Adds the events of `iEvents` whose sample offset is in `[iFromOffset, iToOffset[` after shifting their sample
+   * offset by `iShift`.
+   *
+   * @return `false` if some events had to be dropped (capacity reached) */
+  bool copyFrom(IEventList *iEvents, int32 iFromOffset, int32 iToOffset, int32 iShift);
+
+  /**
+   * Moves the events whose sample offset is `< iOffset` into `oEvents` (if not `nullptr`) after shifting their
+   * sample offset by `iShift`. The sample offset of the remaining events is shifted by `-iOffset` (meaning they are
+   * now relative to `iOffset`).
+   *
+   * @return `false` if `oEvents` refused some events */
+  bool moveTo(IEventList *oEvents, int32 iOffset, int32 iShift);
+
+  //---IEventList---------------------------------------
+  int32 PLUGIN_API getEventCount() SMTG_OVERRIDE { return fNumEvents; }
+  tresult PLUGIN_API getEvent(int32 index, Event &e) SMTG_OVERRIDE;
+  tresult PLUGIN_API addEvent(Event &e) SMTG_OVERRIDE;
+
+  //------------------------------------------------------------------------
+DECLARE_FUNKNOWN_METHODS
+
+private:
+  std::vector<Event> fEvents{};
+  int32 fNumEvents{0};
+};
+
+/**
+ * Implementation of `IParamValueQueue` backed by preallocated storage (see `RTParameterChanges`). Points are kept
+ * sorted by sample offset. When the capacity is reached, adding a point after the last one replaces it (so that the
+ * final value is always correct).
+ */
+class RTParamValueQueue : public IParamValueQueue
+{
+public:
+  RTParamValueQueue();
+  virtual ~RTParamValueQueue() = default;
+
+  //! Allocates the storage (NOT RT safe) and removes all points
+  void setCapacity(int32 iCapacity);
+
+  //! Removes all points and sets the parameter id
+  inline void reset(ParamID iParamID) { fParamID = iParamID; fNumPoints = 0; }
+
+  //---IParamValueQueue---------------------------------------
+  ParamID PLUGIN_API getParameterId() SMTG_OVERRIDE { return fParamID; }
+  int32 PLUGIN_API getPointCount() SMTG_OVERRIDE { return fNumPoints; }
+  tresult PLUGIN_API getPoint(int32 index, int32 &sampleOffset, ParamValue &value) SMTG_OVERRIDE;
+  tresult PLUGIN_API addPoint(int32 sampleOffset, ParamValue value, int32 &index) SMTG_OVERRIDE;
+
+  //------------------------------------------------------------------------
+DECLARE_FUNKNOWN_METHODS
+
+private:
+  friend class RTParameterChanges;
+
+  // swaps the content with ioOther (does not allocate)
+  void swap(RTParamValueQueue &ioOther);
+
+  ParamID fParamID{};
+  std::vector<std::pair<int32, ParamValue>> fPoints{};
+  int32 fNumPoints{0};
+};
+
+/**
+ * Implementation of `IParameterChanges` backed by storage preallocated with `setCapacity` so that it can be filled
+ * and emptied in the RT thread (see `RTEventList` for the use cases). When the maximum number of parameters is
+ * reached, `addParameterData` returns `nullptr`.
+ */
+class RTParameterChanges : public IParameterChanges
+{
+public:
+  RTParameterChanges();
+  virtual ~RTParameterChanges() = default;
+
+  //! Allocates the storage (NOT RT safe) and removes all changes
+  void setCapacity(int32 iMaxParameters, int32 iMaxPointsPerParameter);
+
+  //! Removes all changes
+  inline void clear() { fNumQueues = 0; }
+
+  //! @return the total number of points (across all parameters)
+  int32 getTotalPointCount() const;
+
+  /**
+   * Adds the points of `iChanges` whose sample offset is in `[iFromOffset, iToOffset[` after shifting their sample
+   * offset by `iShift`.
+   *
+   * @return `false` if some points had to be dropped (capacity reached) */
+  bool copyFrom(IParameterChanges *iChanges, int32 iFromOffset, int32 iToOffset, int32 iShift);
+
+  /**
+   * Moves the points whose sample offset is `< iOffset` into `oChanges` (if not `nullptr`) after shifting their
+   * sample offset by `iShift`. The sample offset of the remaining points is shifted by `-iOffset`.
+   *
+   * @return `false` if `oChanges` refused some points */
+  bool moveTo(IParameterChanges *oChanges, int32 iOffset, int32 iShift);
+
+  //---IParameterChanges---------------------------------------
+  int32 PLUGIN_API getParameterCount() SMTG_OVERRIDE { return fNumQueues; }
+  IParamValueQueue *PLUGIN_API getParameterData(int32 index) SMTG_OVERRIDE;
+  IParamValueQueue *PLUGIN_API addParameterData(const ParamID &id, int32 &index) SMTG_OVERRIDE;
+
+  //------------------------------------------------------------------------
+DECLARE_FUNKNOWN_METHODS
+
+private:
+  std::vector<RTParamValueQueue> fQueues{};
+  int32 fNumQueues{0};
+};
+
+}
@@ -64,6 +64,9 @@ protected:
  * Templated class for RT Jamba Inbound parameter. The GUI thread calls readFromMessage to extract the value
  * and store it in the queue. The RT thread will later extract the value from the queue and store it locally.
  *
+ * By default the messages are expected to be received by a single thread. When it is not the case, the parameter
+ * can be backed by a multi producer queue instead (see `RTState::addJmbIn(JmbParam<T>, size_t)`).
+ *
  * @tparam T
  */
 template<typename T>
@@ -74,7 +77,17 @@ public:
 
   explicit RTJmbInParameter(std::shared_ptr<JmbParamDef<T>> iParamDef) :
     IRTJmbInParameter(iParamDef),
-    fUpdateQueue{std::make_unique<T>(iParamDef->fDefaultValue), true}
+    fUpdateQueue{std::make_unique<Concurrent::LockFree::SingleElementQueue<T>>(
+      std::make_unique<T>(iParamDef->fDefaultValue), true)}
+  {}
+
+  /**
+   * Creates a parameter backed by a multi producer queue (messages can be received by up to `iMaxProducers` threads
+   * at the same time) */
+  RTJmbInParameter(std::shared_ptr<JmbParamDef<T>> iParamDef, size_t iMaxProducers) :
+    IRTJmbInParameter(iParamDef),
+    fMPSCUpdateQueue{std::make_unique<Concurrent::LockFree::MPSCSingleElementQueue<T>>(
+      std::make_unique<T>(iParamDef->fDefaultValue), true, iMaxProducers)}
   {}
 
   // getParamDef
@@ -84,16 +97,19 @@ public:
   }
 
   // pop
-  inline ParamType *pop() { return fUpdateQueue.pop(); }
+  inline ParamType *pop() { return fMPSCUpdateQueue ? fMPSCUpdateQueue->pop() : fUpdateQueue->pop(); }
 
   // last
-  inline ParamType const *last() const { return fUpdateQueue.last(); }
+  inline ParamType const *last() const { return fMPSCUpdateQueue ? fMPSCUpdateQueue->last() : fUpdateQueue->last(); }
 
   // popOrLast
-  inline ParamType const *popOrLast() { return fUpdateQueue.popOrLast(); }
+  inline ParamType const *popOrLast()
+  {
+    return fMPSCUpdateQueue ? fMPSCUpdateQueue->popOrLast() : fUpdateQueue->popOrLast();
+  }
 
   // hasUpdate
-  bool hasUpdate() const override { return !fUpdateQueue.isEmpty(); }
+  bool hasUpdate() const override { return fMPSCUpdateQueue ? !fMPSCUpdateQueue->isEmpty() : !fUpdateQueue->isEmpty(); }
 
   // readFromMessage - called to extract the value from the message
   tresult readFromMessage(Message const &iMessage) override;
@@ -102,7 +118,9 @@ public:
   void writeToStream(std::ostream &oStream) const override;
 
 private:
-  Concurrent::LockFree::SingleElementQueue<T> fUpdateQueue{};
+  // only one of the 2 queues is allocated (depending on the constructor used)
+  std::unique_ptr<Concurrent::LockFree::SingleElementQueue<T>> fUpdateQueue{};
+  std::unique_ptr<Concurrent::LockFree::MPSCSingleElementQueue<T>> fMPSCUpdateQueue{};
 };
 
 //------------------------------------------------------------------------
@@ -111,9 +129,11 @@ private:
 template<typename T>
 tresult RTJmbInParameter<T>::readFromMessage(Message const &iMessage)
 {
-  bool res = fUpdateQueue.updateAndPushIf([this, &iMessage](auto oUpdate) -> bool {
+  auto reader = [this, &iMessage](auto oUpdate) -> bool {
     return getParamDefT()->readFromMessage(iMessage, *oUpdate) == kResultOk;
-  });
+  };
+
+  bool res = fMPSCUpdateQueue ? fMPSCUpdateQueue->updateAndPushIf(reader) : fUpdateQueue->updateAndPushIf(reader);
 
   return res ? kResultOk : kResultFalse;
 }
@@ -22,6 +22,7 @@
 #include <pongasoft/Utils/Disposable.h>
 #include <pongasoft/Utils/Metaprogramming.h>
 #include <pongasoft/VST/ParamDef.h>
+#include <pongasoft/VST/MessageBatch.h>
 
 namespace pongasoft::VST::RT {
 
@@ -48,9 +49,17 @@ public:
   // hasUpdate
   virtual bool hasUpdate() const = 0;
 
+  /**
+   * @return the number of updates ready to be written (each call to `writeToMessage` writes one). Always 0 or 1
+   *         unless the parameter is backed by a queue */
+  virtual size_t getUpdateCount() const { return hasUpdate() ? 1 : 0; }
+
   // writeToMessage
   virtual tresult writeToMessage(Message &oMessage) = 0;
 
+  // writeToBatch (same as writeToMessage but adds the update as an entry of the batch)
+  virtual tresult writeToBatch(MessageBatchWriter &oBatch) = 0;
+
   // writeToStream
   virtual void writeToStream(std::ostream &oStream) const = 0;
 
@@ -63,6 +72,15 @@ protected:
  * to its peer (GUI). A GUI timer will then pop the value from the queue, serialize it, wrap it in a message and
  * send it to the GUI.
  *
+ * By default only the latest value is kept (if the RT code broadcasts more than one value between 2 GUI timer
+ * ticks, only the last one is delivered). When every value matters (ex: a stream of events), the parameter can be
+ * backed by a bounded queue instead (see `RTState::addJmbOut(JmbParam<T>, size_t)`) in which case every value is
+ * delivered in order, as long as the queue does not get full (values broadcast while the queue is full are dropped).
+ *
+ * Large values (sample buffers, spectrum frames...) should be filled in place (`broadcast(ElementModifier)` or
+ * `acquireValue` / `broadcastAcquiredValue`) in which case no copy of `T` happens on the way to the GUI timer: the
+ * queue only hands over pointers to preallocated values which get recycled once serialized.
+ *
  * @tparam T
  */
 template<typename T>
@@ -76,6 +94,15 @@ public:
     fUpdateQueue{std::make_unique<T>(iParamDef->fDefaultValue), true}
   {}
 
+  /**
+   * Creates a parameter backed by a queue of (at least) `iQueueCapacity` elements (allocated here, not in the
+   * RT thread) */
+  RTJmbOutParameter(std::shared_ptr<JmbParamDef<T>> iParamDef, size_t iQueueCapacity) :
+    IRTJmbOutParameter(iParamDef),
+    fUpdateQueue{std::make_unique<T>(iParamDef->fDefaultValue), true},
+    fEventQueue{std::make_unique<Concurrent::LockFree::PooledQueue<T>>(iQueueCapacity, iParamDef->fDefaultValue)}
+  {}
+
   // getParamDef
   inline JmbParamDef<T> const *getParamDefT() const
   {
@@ -89,7 +116,10 @@ public:
    */
   inline void broadcastValue(ParamType const &iValue)
   {
-    fUpdateQueue.push(iValue);
+    if(fEventQueue)
+      fEventQueue->push(iValue);
+    else
+      fUpdateQueue.push(iValue);
   }
 
   /**
@@ -100,7 +130,10 @@ public:
   template<class ElementModifier>
   void broadcast(ElementModifier const &iElementModifier)
   {
-    fUpdateQueue.updateAndPush(iElementModifier);
+    if(fEventQueue)
+      fEventQueue->updateAndPush(iElementModifier);
+    else
+      fUpdateQueue.updateAndPush(iElementModifier);
   }
 
   /**
@@ -112,20 +145,68 @@ public:
   template<class ElementModifier>
   bool broadcastIf(ElementModifier const &iElementModifier)
   {
-    return fUpdateQueue.updateAndPushIf(iElementModifier);
+    if(fEventQueue)
+      return fEventQueue->updateAndPushIf(iElementModifier);
+    else
+      return fUpdateQueue.updateAndPushIf(iElementModifier);
+  }
+
+  /**
+   * Gives direct access to the value that will be broadcast next so that it can be filled in place, possibly over
+   * several processing calls, before calling `broadcastAcquiredValue` (calling this method again before then
+   * returns the same value). The value is "recycled" (it contains whatever it had the last time it was used).
+   * This method is called by RT thread.
+   *
+   * @return the value or `nullptr` when the parameter is backed by a queue which is full */
+  inline T *acquireValue()
+  {
+    return fEventQueue ? fEventQueue->acquire() : fUpdateQueue.acquire();
+  }
+
+  /**
+   * Enqueues the value returned by `acquireValue` to be delivered to the GUI (no copy involved).
+   * This method is called by RT thread.
+   *
+   * @return `false` if there was no value acquired (queue full) */
+  inline bool broadcastAcquiredValue()
+  {
+    if(fEventQueue)
+      return fEventQueue->pushAcquired();
+    fUpdateQueue.pushAcquired();
+    return true;
   }
 
   // hasUpdate
-  bool hasUpdate() const override { return !fUpdateQueue.isEmpty(); }
+  bool hasUpdate() const override { return fEventQueue ? !fEventQueue->isEmpty() : !fUpdateQueue.isEmpty(); }
+
+  // getUpdateCount
+  size_t getUpdateCount() const override
+  {
+    return fEventQueue ? fEventQueue->getSize() : IRTJmbOutParameter::getUpdateCount();
+  }
 
   // writeToMessage - called to package and add the value to the message
   tresult writeToMessage(Message &oMessage) override;
 
+  // writeToBatch - called to package and add the value to the batch
+  tresult writeToBatch(MessageBatchWriter &oBatch) override;
+
   // writeToStream
   void writeToStream(std::ostream &oStream) const override;
 
+private:
+  // pops the next update (if any) and calls iWriter (tresult (T const &)) with it, then releases it
+  template<class UpdateWriter>
+  tresult popAndWriteUpdate(UpdateWriter const &iWriter);
+
 private:
   Concurrent::LockFree::SingleElementQueue<T> fUpdateQueue{};
+
+  // when not null, used instead of fUpdateQueue
+  std::unique_ptr<Concurrent::LockFree::PooledQueue<T>> fEventQueue{};
+
+  // reused from one message to the next (only accessed from the UI thread)
+  VstUtils::FastWriteMemoryStream fSerializationBuffer{};
 };
 
 //------------------------------------------------------------------------
@@ -134,20 +215,45 @@ private:
 template<typename T>
 tresult RTJmbOutParameter<T>::writeToMessage(Message &oMessage)
 {
-  auto update = fUpdateQueue.pop();
-  if(update)
-  {
-    tresult res = getParamDefT()->writeToMessage(*update, oMessage);
+  return popAndWriteUpdate([this, &oMessage](T const &iUpdate) {
+    return getParamDefT()->writeToMessage(iUpdate, oMessage, fSerializationBuffer);
+  });
+}
 
-    // Implementation note: this method is called from the UI thread so releasing resources is OK!
-    auto disposable = Cast<Disposable *>::dynamic(update);
-    if(disposable)
-      disposable->dispose();
+//------------------------------------------------------------------------
+// RTJmbOutParameter::writeToBatch
+//------------------------------------------------------------------------
+template<typename T>
+tresult RTJmbOutParameter<T>::writeToBatch(MessageBatchWriter &oBatch)
+{
+  return popAndWriteUpdate([this, &oBatch](T const &iUpdate) {
+    return oBatch.add(static_cast<MessageID>(getParamID()), [this, &iUpdate](IBStreamer &oStreamer) {
+      return getParamDefT()->writeToStream(iUpdate, oStreamer);
+    });
+  });
+}
 
-    return res;
-  }
+//------------------------------------------------------------------------
+// RTJmbOutParameter::popAndWriteUpdate
+//------------------------------------------------------------------------
+template<typename T>
+template<class UpdateWriter>
+tresult RTJmbOutParameter<T>::popAndWriteUpdate(UpdateWriter const &iWriter)
+{
+  // the value popped remains owned by this thread until the next pop (so it is never copied)
+  T *update = fEventQueue ? fEventQueue->pop() : fUpdateQueue.pop();
+
+  if(!update)
+    return kResultFalse;
+
+  tresult res = iWriter(*update);
 
-  return kResultFalse;
+  // Implementation note: this method is called from the UI thread so releasing resources is OK!
+  auto disposable = Cast<Disposable *>::dynamic(update);
+  if(disposable)
+    disposable->dispose();
+
+  return res;
 }
 
 //------------------------------------------------------------------------
@@ -156,7 +262,7 @@ tresult RTJmbOutParameter<T>::writeToMessage(Message &oMessage)
 template<typename T>
 void RTJmbOutParameter<T>::writeToStream(std::ostream &oStream) const
 {
-  getParamDefT()->writeToStream(*fUpdateQueue.last(), oStream);
+  getParamDefT()->writeToStream(fEventQueue ? *fEventQueue->last() : *fUpdateQueue.last(), oStream);
 }
 
 //------------------------------------------------------------------------
@@ -199,6 +305,20 @@ public:
   template<class ElementModifier>
   bool broadcastIf(ElementModifier const &iElementModifier) { return fPtr->broadcastIf(iElementModifier); }
 
+  /**
+   * Gives direct access to the value that will be broadcast next so that it can be filled in place (possibly over
+   * several processing calls) then delivered with `broadcastAcquired` without any copy. This method is called by
+   * RT thread.
+   *
+   * @return the value or `nullptr` when the parameter is backed by a queue which is full */
+  inline T *acquire() { return fPtr->acquireValue(); }
+
+  /**
+   * Enqueues the value returned by `acquire` to be delivered to the GUI. This method is called by RT thread.
+   *
+   * @return `false` if there was no value acquired (queue full) */
+  inline bool broadcastAcquired() { return fPtr->broadcastAcquiredValue(); }
+
 private:
   RTJmbOutParameter<T> *fPtr;
 };
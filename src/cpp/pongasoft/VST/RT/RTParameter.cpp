@@ -19,6 +19,8 @@
 
 #include <pluginterfaces/vst/ivstaudioprocessor.h>
 
+#include <algorithm>
+
 namespace pongasoft {
 namespace VST {
 namespace RT {
@@ -53,6 +55,7 @@ bool RTRawVstParameter::updateNormalizedValue(ParamValue iNormalizedValue)
   if(fNormalizedValue != iNormalizedValue)
   {
     fNormalizedValue = iNormalizedValue;
+    markDirty();
     return true;
   }
 
@@ -72,6 +75,85 @@ bool RTRawVstParameter::resetPreviousValue()
   return false;
 }
 
+//------------------------------------------------------------------------
+// RTRawVstParameter::enableAutomationPoints
+//------------------------------------------------------------------------
+void RTRawVstParameter::enableAutomationPoints(int32 iMaxPointCount)
+{
+  DCHECK_F(iMaxPointCount > 0);
+  fAutomationPoints.resize(static_cast<size_t>(std::max(iMaxPointCount, 1)));
+  clearAutomationPoints();
+}
+
+//------------------------------------------------------------------------
+// RTRawVstParameter::beginAutomationPoints
+//------------------------------------------------------------------------
+void RTRawVstParameter::beginAutomationPoints()
+{
+  fAutomationStartNormalizedValue = fNormalizedValue;
+  clearAutomationPoints();
+}
+
+//------------------------------------------------------------------------
+// RTRawVstParameter::addAutomationPoint
+//------------------------------------------------------------------------
+void RTRawVstParameter::addAutomationPoint(int32 iSampleOffset, ParamValue iNormalizedValue)
+{
+  auto const maxPointCount = static_cast<int32>(fAutomationPoints.size());
+
+  if(maxPointCount == 0)
+    return;
+
+  // no more room => the last point is replaced (which means the final value is always correct)
+  if(fAutomationPointCount == maxPointCount)
+    fAutomationPointCount--;
+
+  fAutomationPoints[fAutomationPointCount++] = { iSampleOffset, Utils::clamp(iNormalizedValue, 0.0, 1.0) };
+}
+
+//------------------------------------------------------------------------
+// RTRawVstParameter::rewindAutomation
+//------------------------------------------------------------------------
+bool RTRawVstParameter::rewindAutomation()
+{
+  if(fAutomationPointCount == 0)
+    return false;
+
+  fAutomationCursor = 0;
+  return updateNormalizedValue(fAutomationStartNormalizedValue);
+}
+
+//------------------------------------------------------------------------
+// RTRawVstParameter::advanceAutomation
+//------------------------------------------------------------------------
+bool RTRawVstParameter::advanceAutomation(int32 iSampleOffset)
+{
+  auto cursor = fAutomationCursor;
+
+  while(cursor < fAutomationPointCount && fAutomationPoints[cursor].fSampleOffset <= iSampleOffset)
+    cursor++;
+
+  if(cursor == fAutomationCursor)
+    return false;
+
+  fAutomationCursor = cursor;
+  return updateNormalizedValue(fAutomationPoints[cursor - 1].fNormalizedValue);
+}
+
+//------------------------------------------------------------------------
+// RTRawVstParameter::getNextAutomationSampleOffset
+//------------------------------------------------------------------------
+int32 RTRawVstParameter::getNextAutomationSampleOffset(int32 iSampleOffset) const
+{
+  for(auto i = fAutomationCursor; i < fAutomationPointCount; i++)
+  {
+    if(fAutomationPoints[i].fSampleOffset > iSampleOffset)
+      return fAutomationPoints[i].fSampleOffset;
+  }
+
+  return -1;
+}
+
 }
 }
 }
\ No newline at end of file
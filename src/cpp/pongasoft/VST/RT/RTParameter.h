@@ -24,8 +24,59 @@
 #include <pongasoft/logging/logging.h>
 #include <pongasoft/Utils/Operators.h>
 
+#include <type_traits>
+#include <vector>
+
 namespace pongasoft::VST::RT {
 
+/**
+ * Keeps track of the parameters (identified by their slot in `RTState`) which were modified during the current
+ * frame so that only those need to be visited at the end of the frame. Memory is allocated in `resize` (which
+ * should NOT be called from the RT thread): marking, iterating and clearing never allocate.
+ */
+class RTDirtyParameterSet
+{
+public:
+  //! Makes room for `iSlotCount` slots (allocates memory)
+  void resize(int32 iSlotCount)
+  {
+    fDirty.resize(static_cast<size_t>(iSlotCount), false);
+    fSlots.reserve(static_cast<size_t>(iSlotCount));
+  }
+
+  //! Marks the slot as dirty (no op if already dirty)
+  inline void mark(int32 iSlot)
+  {
+    DCHECK_F(iSlot >= 0 && iSlot < static_cast<int32>(fDirty.size()));
+    if(!fDirty[iSlot])
+    {
+      fDirty[iSlot] = true;
+      fSlots.emplace_back(iSlot);
+    }
+  }
+
+  //! @return true if the slot is dirty
+  inline bool isDirty(int32 iSlot) const { return fDirty[iSlot]; }
+
+  //! @return true if no slot is dirty
+  inline bool empty() const { return fSlots.empty(); }
+
+  //! @return the dirty slots (in the order they were marked)
+  inline std::vector<int32> const &getSlots() const { return fSlots; }
+
+  //! Clears all the dirty slots (O(number of dirty slots))
+  inline void clear()
+  {
+    for(auto slot : fSlots)
+      fDirty[slot] = false;
+    fSlots.clear();
+  }
+
+private:
+  std::vector<bool> fDirty{};
+  std::vector<int32> fSlots{};
+};
+
 /**
  * Base class which deals with the "raw"/untyped parameter and keep the normalized value (ParamValue in the
  * range [0.0,1.0]). Also keeps the "previous" value which is the value the param had in the previous frame/call to
@@ -33,6 +84,16 @@ namespace pongasoft::VST::RT {
  */
 class RTRawVstParameter
 {
+public:
+  /**
+   * Represents a single automation point (as provided by the host in `IParamValueQueue`) for the current frame.
+   */
+  struct AutomationPoint
+  {
+    int32 fSampleOffset;
+    ParamValue fNormalizedValue;
+  };
+
 public:
   // Constructor
   explicit RTRawVstParameter(std::shared_ptr<RawVstParamDef> iParamDef) :
@@ -47,6 +108,11 @@ public:
   // getParamDef
   inline RawVstParamDef const *getParamDef() const { return fParamDef.get(); }
 
+  /**
+   * Called by `RTState` when the parameter is added so that every change to this parameter is recorded in the
+   * dirty set under the provided slot. */
+  inline void trackChanges(RTDirtyParameterSet *iDirtySet, int32 iSlot) { fDirtySet = iDirtySet; fSlot = iSlot; }
+
   /**
    * Update the parameter with a new normalized value. This is typically called after the VST parameter managed
    * by the VST sdk changes (for example, moving a knob or loading a previously saved plugin)
@@ -77,18 +143,88 @@ public:
    */
   virtual bool resetPreviousValue();
 
+  /**
+   * Enables sample accurate automation for this parameter by preallocating room for `iMaxPointCount` automation
+   * points per frame. This method allocates memory and as a result should NOT be called from the RT thread.
+   * If the host sends more points than this in a single frame, the extra points are merged into the last one.
+   */
+  void enableAutomationPoints(int32 iMaxPointCount);
+
+  //! @return true if `enableAutomationPoints` has been called
+  inline bool isAutomationPointsEnabled() const { return !fAutomationPoints.empty(); }
+
+  //! @return the number of automation points received during this frame (`0` if none)
+  inline int32 getAutomationPointCount() const { return fAutomationPointCount; }
+
+  //! @return the automation point at the given index (must be in the range `[0, getAutomationPointCount()[`)
+  inline AutomationPoint const &getAutomationPoint(int32 iIndex) const
+  {
+    DCHECK_F(iIndex >= 0 && iIndex < fAutomationPointCount);
+    return fAutomationPoints[iIndex];
+  }
+
+  /**
+   * Called (by `RTState`) before adding the automation points of the current frame. Remembers the current value as
+   * the value in effect at the beginning of the frame. */
+  void beginAutomationPoints();
+
+  //! Called (by `RTState`) for each automation point of the current frame (in increasing sample offset order)
+  void addAutomationPoint(int32 iSampleOffset, ParamValue iNormalizedValue);
+
+  //! Called (by `RTState`) at the end of the frame to discard the automation points
+  inline void clearAutomationPoints() { fAutomationPointCount = 0; fAutomationCursor = 0; }
+
+  /**
+   * Resets the value of this parameter to what it was at the beginning of the frame (before any automation point
+   * was applied). Used when processing the frame in sub-blocks.
+   *
+   * @return true if the value was actually updated */
+  bool rewindAutomation();
+
+  /**
+   * Applies all the automation points whose sample offset is `<= iSampleOffset` (and were not applied yet).
+   *
+   * @return true if the value was actually updated */
+  bool advanceAutomation(int32 iSampleOffset);
+
+  /**
+   * @return the sample offset of the next automation point (not applied yet) which is strictly greater than
+   *         `iSampleOffset` or `-1` if there is none */
+  int32 getNextAutomationSampleOffset(int32 iSampleOffset) const;
+
+protected:
+  // must be called whenever fNormalizedValue is modified
+  inline void markDirty() { if(fDirtySet) fDirtySet->mark(fSlot); }
+
 protected:
   std::shared_ptr<RawVstParamDef> fParamDef;
   ParamValue fNormalizedValue;
   ParamValue fPreviousNormalizedValue;
+
+private:
+  RTDirtyParameterSet *fDirtySet{nullptr};
+  int32 fSlot{-1};
+
+private:
+  // preallocated (see enableAutomationPoints) so that no memory allocation happens in the RT thread
+  std::vector<AutomationPoint> fAutomationPoints{};
+  int32 fAutomationPointCount{0};
+  int32 fAutomationCursor{0};
+  ParamValue fAutomationStartNormalizedValue{0};
 };
 
+template<typename T, typename Converter = void>
+class RTVstParameter;
+
+template<typename T, typename Converter = void>
+class RTVstParam;
+
 /**
  * The typed version. Maintains the denormalized (aka "typed") version of the value and previous value.
  *
  * @tparam T the underlying type of the param */
 template<typename T>
-class RTVstParameter : public RTRawVstParameter
+class RTVstParameter<T, void> : public RTRawVstParameter
 {
 public:
   using ParamType = T;
@@ -117,7 +253,7 @@ public:
    * This method is typically called during the processing method when the plugin needs to update the value. In general
    * the change needs to be propagated to the VST sdk (using addToOutput).
    */
-  void update(ParamType const &iNewValue);
+  virtual void update(ParamType const &iNewValue);
 
   // getValue
   inline ParamType const &getValue() const { return fValue; }
@@ -125,6 +261,14 @@ public:
   // getPreviousValue
   inline ParamType const &getPreviousValue() const { return fPreviousValue; }
 
+  /**
+   * @return the (denormalized) value of the automation point at the given index (must be in the range
+   *         `[0, getAutomationPointCount()[`) */
+  inline ParamType getAutomationPointValue(int32 iIndex) const
+  {
+    return denormalize(getAutomationPoint(iIndex).fNormalizedValue);
+  }
+
 protected:
   // Override the base class to update the denormalized value as well
   bool updateNormalizedValue(ParamValue iNormalizedValue) override;
@@ -175,6 +319,85 @@ void RTVstParameter<T>::update(const ParamType &iNewValue)
 {
   fValue = iNewValue;
   fNormalizedValue = normalize(fValue);
+  markDirty();
+}
+
+/**
+ * The typed version when the type of the converter is known at compile time (see `VstParamDef<T, Converter>`): the
+ * (frequent) conversions triggered by the host (`updateNormalizedValue`) or by the plugin (`update`) do not go
+ * through the virtual `IParamConverter<T>` api. `normalize`, `denormalize` and `getAutomationPointValue` are
+ * shadowed as well (use `RTVstParam<T, Converter>` to access them), the base class versions (through
+ * `RTVstParam<T>`) using the virtual api which yields the same values.
+ *
+ * @tparam T the underlying type of the param
+ * @tparam Converter the (concrete) type of the converter */
+template<typename T, typename Converter>
+class RTVstParameter : public RTVstParameter<T>
+{
+public:
+  using ParamType = T;
+
+  // Constructor
+  explicit RTVstParameter(TVstParam<T, Converter> iParamDef) :
+    RTVstParameter<T>(iParamDef),
+    fStaticParamDef{iParamDef.get()}
+  {
+  }
+
+  // getParamDef
+  inline VstParamDef<T, Converter> const *getParamDefT() const { return fStaticParamDef; }
+
+  // shortcut to normalize (non virtual call)
+  inline ParamValue normalize(ParamType const &iValue) const { return fStaticParamDef->normalize(iValue); }
+
+  // shortcut to denormalize (non virtual call)
+  inline ParamType denormalize(ParamValue iNormalizedValue) const
+  {
+    return fStaticParamDef->denormalize(iNormalizedValue);
+  }
+
+  // getAutomationPointValue (non virtual call)
+  inline ParamType getAutomationPointValue(int32 iIndex) const
+  {
+    return denormalize(this->getAutomationPoint(iIndex).fNormalizedValue);
+  }
+
+  // Override the base class to use the compile time converter
+  void update(ParamType const &iNewValue) override;
+
+protected:
+  // Override the base class to use the compile time converter
+  bool updateNormalizedValue(ParamValue iNormalizedValue) override;
+
+private:
+  // same object as fParamDef (owned by it)
+  VstParamDef<T, Converter> const *fStaticParamDef;
+};
+
+//------------------------------------------------------------------------
+// RTVstParameter<T, Converter>::updateNormalizedValue
+//------------------------------------------------------------------------
+template<typename T, typename Converter>
+bool RTVstParameter<T, Converter>::updateNormalizedValue(ParamValue iNormalizedValue)
+{
+  if(RTRawVstParameter::updateNormalizedValue(iNormalizedValue))
+  {
+    this->fValue = denormalize(iNormalizedValue);
+    return true;
+  }
+
+  return false;
+}
+
+//------------------------------------------------------------------------
+// RTVstParameter<T, Converter>::update
+//------------------------------------------------------------------------
+template<typename T, typename Converter>
+void RTVstParameter<T, Converter>::update(ParamType const &iNewValue)
+{
+  this->fValue = iNewValue;
+  this->fNormalizedValue = normalize(this->fValue);
+  this->markDirty();
 }
 
 //------------------------------------------------------------------------
@@ -185,18 +408,37 @@ void RTVstParameter<T>::update(const ParamType &iNewValue)
  * as well as redefine a couple of operators which helps in writing simpler and natural code (the param
  * behaves like T in many ways).
  *
- * @tparam T the underlying type of the param */
-template<typename T>
-class RTVstParam : public Utils::Operators::Dereferenceable<RTVstParam<T>>
+ * `RTVstParam<T, Converter>` (returned by `RTState::add(TVstParam<T, Converter>)`) converts without virtual calls
+ * and can be assigned to a `RTVstParam<T>`.
+ *
+ * @tparam T the underlying type of the param
+ * @tparam Converter the (concrete) type of the converter when known at compile time (`void` otherwise) */
+template<typename T, typename Converter>
+class RTVstParam : public Utils::Operators::Dereferenceable<RTVstParam<T, Converter>>
 {
   using ParamType = T;
 
 public:
-  RTVstParam(RTVstParameter<T> *iPtr) : fPtr{iPtr} // NOLINT (not marked explicit on purpose)
+  /**
+   * Typed version of `RTRawVstParameter::AutomationPoint` */
+  struct AutomationPoint
+  {
+    int32 fSampleOffset;
+    ParamType fValue;
+  };
+
+public:
+  RTVstParam(RTVstParameter<T, Converter> *iPtr) : fPtr{iPtr} // NOLINT (not marked explicit on purpose)
   {
     DCHECK_F(fPtr != nullptr);
   }
 
+  // RTVstParam<T, Converter> => RTVstParam<T> (not marked explicit on purpose)
+  template<typename C, typename = std::enable_if_t<std::is_void_v<Converter> && !std::is_void_v<C>>>
+  RTVstParam(RTVstParam<T, C> const &iOther) : fPtr{iOther.fPtr} // NOLINT
+  {
+  }
+
   // getParamID
   inline ParamID getParamID() const { return fPtr->getParamID(); }
 
@@ -253,13 +495,29 @@ public:
   constexpr ParamType const *operator->() const { return &fPtr->getValue(); }
 
   //! Allow to write param = 3.0
-  inline RTVstParam<T> &operator=(ParamType const &iValue) { update(iValue); return *this; }
+  inline RTVstParam &operator=(ParamType const &iValue) { update(iValue); return *this; }
 
   // previous
   inline ParamType const &previous() const { return fPtr->getPreviousValue(); }
 
+  /**
+   * @return the number of automation points received for this parameter during this frame. Always `0` unless
+   *         sample accurate automation has been enabled (see `RTState::enableSampleAccurateAutomation`) */
+  inline int32 getAutomationPointCount() const { return fPtr->getAutomationPointCount(); }
+
+  /**
+   * @return the automation point (sample offset and typed value) at the given index (must be in the range
+   *         `[0, getAutomationPointCount()[`) */
+  inline AutomationPoint getAutomationPoint(int32 iIndex) const
+  {
+    return { fPtr->getAutomationPoint(iIndex).fSampleOffset, fPtr->getAutomationPointValue(iIndex) };
+  }
+
 private:
-  RTVstParameter<T> *fPtr;
+  template<typename, typename>
+  friend class RTVstParam;
+
+  RTVstParameter<T, Converter> *fPtr;
 };
 
 //------------------------------------------------------------------------
@@ -331,6 +589,15 @@ public:
   // previous
   inline ParamValue const &previous() const { return fPtr->getPreviousNormalizedValue(); }
 
+  //! @return the number of automation points received for this parameter during this frame (see `RTVstParam`)
+  inline int32 getAutomationPointCount() const { return fPtr->getAutomationPointCount(); }
+
+  //! @return the automation point at the given index (must be in the range `[0, getAutomationPointCount()[`)
+  inline RTRawVstParameter::AutomationPoint const &getAutomationPoint(int32 iIndex) const
+  {
+    return fPtr->getAutomationPoint(iIndex);
+  }
+
 private:
   RTRawVstParameter *fPtr;
 };
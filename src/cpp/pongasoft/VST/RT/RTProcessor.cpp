@@ -17,10 +17,62 @@
  */
 #include "RTProcessor.h"
 
+#include <pluginterfaces/vst/vstspeaker.h>
+#include <pluginterfaces/vst/ivstevents.h>
+#include <pongasoft/VST/AudioBuffer.h>
+#include <pongasoft/VST/DenormalGuard.h>
+
+#include <algorithm>
+
 namespace pongasoft {
 namespace VST {
 namespace RT {
 
+namespace {
+
+// silence flags where every channel is silent
+inline uint64 allChannelsSilent(int32 iNumChannels)
+{
+  return iNumChannels >= 64 ? ~static_cast<uint64>(0) : (static_cast<uint64>(1) << iNumChannels) - 1;
+}
+
+// channelBuffers32 or channelBuffers64 depending on SampleType
+template<typename SampleType>
+inline SampleType **getChannelBuffers(AudioBusBuffers const &iBuffers)
+{
+  if constexpr(std::is_same_v<SampleType, Sample32>)
+    return iBuffers.channelBuffers32;
+  else
+    return iBuffers.channelBuffers64;
+}
+
+// copies iNumSamples samples of each channel (a missing source channel is copied as silence)
+template<typename SampleType>
+void copyChannels(AudioBusBuffers const &iFrom, int32 iFromOffset, AudioBusBuffers const &iTo, int32 iToOffset,
+                  int32 iNumSamples)
+{
+  auto from = getChannelBuffers<SampleType>(iFrom);
+  auto to = getChannelBuffers<SampleType>(iTo);
+
+  if(!to)
+    return;
+
+  for(int32 c = 0; c < iTo.numChannels; c++)
+  {
+    auto toChannel = to[c];
+    if(!toChannel)
+      continue;
+
+    auto fromChannel = from && c < iFrom.numChannels ? from[c] : nullptr;
+    if(fromChannel)
+      std::copy(fromChannel + iFromOffset, fromChannel + iFromOffset + iNumSamples, toChannel + iToOffset);
+    else
+      std::fill(toChannel + iToOffset, toChannel + iToOffset + iNumSamples, 0);
+  }
+}
+
+}
+
 //------------------------------------------------------------------------
 // RTProcessor::RTProcessor
 //------------------------------------------------------------------------
@@ -44,6 +96,9 @@ tresult RTProcessor::setActive(TBool iState)
   fGUITimer = nullptr;
   fGUIMessageTimer = nullptr;
 
+  // fixed block processing gets a new chance with the (new) bus configuration
+  fFixedBlockFallback = false;
+
   // when the processor is activated, start the GUI timer(s)
   if(fActive)
   {
@@ -55,18 +110,126 @@ tresult RTProcessor::setActive(TBool iState)
       fGUITimer = AutoReleaseTimer::create(&fGUITimerCallback, fGUITimerIntervalMs);
     }
 
-    if(getRTState()->isMessagingEnabled())
+    // the messaging timer also notifies the controller when the latency changes
+    if(getRTState()->isMessagingEnabled() || !fLatencySources.empty() || fFixedBlockSize > 0 ||
+       fMaxCompensatedLatency > 0)
     {
 #ifdef JAMBA_DEBUG_LOGGING
       DLOG_F(INFO, "RTProcessor::setActive - Enabling GUI messaging timer - interval [%d]", fGUIMessageTimerIntervalMs);
 #endif
       fGUIMessageTimer = AutoReleaseTimer::create(&fGUIMessageTimerCallback, fGUIMessageTimerIntervalMs);
     }
+
+    // bus arrangements are final at this stage => preallocate the sub-block buffers
+    if(fSampleAccurateAutomation)
+    {
+      fSubBlockInputs.resize(audioInputs);
+      fSubBlockOutputs.resize(audioOutputs);
+
+      auto numParameters = getRTState()->getVstParameterCount();
+      fSubBlockInputEvents.setCapacity(kMaxEventsPerBlock);
+      fSubBlockOutputEvents.setCapacity(kMaxEventsPerBlock);
+      fSubBlockInputParameterChanges.setCapacity(numParameters, fMaxAutomationPointsPerBlock);
+      fSubBlockOutputParameterChanges.setCapacity(numParameters, fMaxAutomationPointsPerBlock);
+    }
+
+    if(fFixedBlockSize > 0)
+    {
+      fFixedBlockInputs.resize(audioInputs, processSetup.symbolicSampleSize, fFixedBlockSize);
+      fFixedBlockOutputs.resize(audioOutputs, processSetup.symbolicSampleSize, fFixedBlockSize);
+
+      auto numParameters = getRTState()->getVstParameterCount();
+      fFixedBlockInputEventsFIFO.setCapacity(kMaxEventsPerBlock);
+      fFixedBlockInputEvents.setCapacity(kMaxEventsPerBlock);
+      fFixedBlockOutputEvents.setCapacity(kMaxEventsPerBlock);
+      fFixedBlockOutputEventsFIFO.setCapacity(kMaxEventsPerBlock);
+      fFixedBlockInputParameterChangesFIFO.setCapacity(numParameters, fFixedBlockMaxPointsPerBlock);
+      fFixedBlockInputParameterChanges.setCapacity(numParameters, fFixedBlockMaxPointsPerBlock);
+      fFixedBlockOutputParameterChanges.setCapacity(numParameters, fFixedBlockMaxPointsPerBlock);
+      fFixedBlockOutputParameterChangesFIFO.setCapacity(numParameters, fFixedBlockMaxPointsPerBlock);
+    }
+
+    // one delay line per channel of the main bus (present in both input and output)
+    fDryDelayLines32.clear();
+    fDryDelayLines64.clear();
+    if(fMaxCompensatedLatency > 0 && !audioInputs.empty() && !audioOutputs.empty())
+    {
+      auto inputBus = static_cast<AudioBus *>(audioInputs[0].get());
+      auto outputBus = static_cast<AudioBus *>(audioOutputs[0].get());
+      if(inputBus && outputBus)
+      {
+        auto numChannels = std::min(SpeakerArr::getChannelCount(inputBus->getArrangement()),
+                                    SpeakerArr::getChannelCount(outputBus->getArrangement()));
+        auto capacity = static_cast<int>(fMaxCompensatedLatency) + std::max(processSetup.maxSamplesPerBlock, 1);
+        for(int32 c = 0; c < numChannels; c++)
+        {
+          // mirrored => the delayed block is always contiguous (no copy)
+          if(processSetup.symbolicSampleSize == kSample64)
+            fDryDelayLines64.emplace_back(std::make_unique<Utils::Collection::RingBuffer<Sample64>>(capacity, true));
+          else
+            fDryDelayLines32.emplace_back(std::make_unique<Utils::Collection::RingBuffer<Sample32>>(capacity, true));
+        }
+      }
+    }
+
+    // the host queries the latency when the processor is activated
+    fReportedLatency = getLatencySamples();
   }
 
+  // the processing always restarts from scratch
+  fBypassingSilence = false;
+  fSilentSampleCount = 0;
+  fFixedBlockOffset = 0;
+  fFixedBlockInputEventsFIFO.clear();
+  fFixedBlockOutputEventsFIFO.clear();
+  fFixedBlockInputParameterChangesFIFO.clear();
+  fFixedBlockOutputParameterChangesFIFO.clear();
+  fLatencyChanged = false;
+  fPreviousDryMix = -1;
+
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::setupProcessing
+//------------------------------------------------------------------------
+tresult RTProcessor::setupProcessing(ProcessSetup &setup)
+{
+  tresult result = AudioEffect::setupProcessing(setup);
+
+  if(result != kResultOk)
+    return result;
+
+  getRTState()->setSampleRate(setup.sampleRate);
+
+  if(fScratchArenaMaxChannels > 0 || fScratchArenaExtraBytes > 0)
+    fScratchArena.reserve(computeScratchArenaSize(setup));
+
   return kResultOk;
 }
 
+//------------------------------------------------------------------------
+// RTProcessor::enableScratchArena
+//------------------------------------------------------------------------
+void RTProcessor::enableScratchArena(int32 iMaxScratchChannels, size_t iExtraBytes)
+{
+  fScratchArenaMaxChannels = std::max(iMaxScratchChannels, 0);
+  fScratchArenaExtraBytes = iExtraBytes;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::computeScratchArenaSize
+//------------------------------------------------------------------------
+size_t RTProcessor::computeScratchArenaSize(ProcessSetup const &setup) const
+{
+  auto sampleSize = setup.symbolicSampleSize == kSample64 ? sizeof(Sample64) : sizeof(Sample32);
+
+  // each channel accounted for as its own bus which is the worst case
+  return fScratchArenaMaxChannels *
+         RTScratchArena::computeAudioBusBuffersSize(1, setup.maxSamplesPerBlock, sampleSize) +
+         fScratchArenaExtraBytes;
+}
+
 //------------------------------------------------------------------------
 // RTProcessor::notify
 //------------------------------------------------------------------------
@@ -85,6 +248,9 @@ tresult RTProcessor::notify(IMessage *message)
 //------------------------------------------------------------------------
 tresult RTProcessor::process(ProcessData &data)
 {
+  // restores the floating point mode of the host when leaving this method
+  DenormalGuard denormalGuard{fFlushDenormals};
+
   auto state = getRTState();
 
   // 1. we check if there was any state update (UI calls setState)
@@ -96,12 +262,42 @@ tresult RTProcessor::process(ProcessData &data)
     state->applyParameterChanges(*data.inputParameterChanges);
   }
 
-  // 3. process inputs
-  tresult res = processInputs(data);
+  // 3. process inputs (the dry signal is saved first as processing may happen in place)
+  if(!fLatencySources.empty() || fFixedBlockSize > 0 || fMaxCompensatedLatency > 0)
+    updateLatency();
+
+  if(fMaxCompensatedLatency > 0 && data.numSamples > 0)
+  {
+    if(data.symbolicSampleSize == kSample32)
+      writeDryDelayLines<Sample32>(data);
+    else if(data.symbolicSampleSize == kSample64)
+      writeDryDelayLines<Sample64>(data);
+  }
+
+  tresult res;
+  if(fSilenceBypass && updateSilenceBypass(data))
+    res = processSilentInputs(data);
+  else if(fFixedBlockSize > 0 && !fFixedBlockFallback && data.numSamples > 0)
+    res = processInputsInFixedBlocks(data);
+  else if(fSampleAccurateAutomation && state->hasAutomationPoints() && data.numSamples > 0)
+    res = processInputsWithAutomation(data);
+  else
+    res = processInputs(data);
+
+  if(fMaxCompensatedLatency > 0 && data.numSamples > 0 && !fBypassingSilence && res == kResultOk)
+  {
+    if(data.symbolicSampleSize == kSample32)
+      mixDelayedDry<Sample32>(data);
+    else if(data.symbolicSampleSize == kSample64)
+      mixDelayedDry<Sample64>(data);
+  }
 
   // 4. update the previous state
   state->afterProcessing();
 
+  // 5. release the scratch memory allocated during this frame
+  fScratchArena.reset();
+
   return res;
 }
 
@@ -137,6 +333,700 @@ tresult RTProcessor::processInputs(ProcessData &data)
   return kResultFalse;
 }
 
+//------------------------------------------------------------------------
+// RTProcessor::areInputsSilent
+//------------------------------------------------------------------------
+bool RTProcessor::areInputsSilent(ProcessData const &data) const
+{
+  if(data.numInputs <= 0 || data.inputs == nullptr)
+    return false;
+
+  if(data.inputEvents && data.inputEvents->getEventCount() > 0)
+    return false;
+
+  // a parameter change may affect what is produced (and restarts the tail)
+  if(data.inputParameterChanges && data.inputParameterChanges->getParameterCount() > 0)
+    return false;
+
+  for(int32 i = 0; i < data.numInputs; i++)
+  {
+    auto const &bus = data.inputs[i];
+    auto mask = allChannelsSilent(bus.numChannels);
+    if((bus.silenceFlags & mask) != mask)
+      return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::updateSilenceBypass
+//------------------------------------------------------------------------
+bool RTProcessor::updateSilenceBypass(ProcessData const &data)
+{
+  if(data.numSamples <= 0 || !areInputsSilent(data))
+  {
+#ifdef JAMBA_DEBUG_LOGGING
+    if(fBypassingSilence)
+      DLOG_F(INFO, "RTProcessor::updateSilenceBypass - resuming processing");
+#endif
+    fBypassingSilence = false;
+    fSilentSampleCount = 0;
+    return false;
+  }
+
+  if(fBypassingSilence)
+    return true;
+
+  auto tailSamples = getTailSamples();
+  if(tailSamples == kInfiniteTail)
+    return false;
+
+  // the audio still buffered by the processor (fixed blocks, latency sources, delayed dry signal...) must be
+  // flushed before bypassing => the latency extends the tail
+  auto silentSamples = static_cast<uint64>(tailSamples) + getLatencySamples();
+
+  // the tail is measured from the first silent sample => the current frame must be processed unless it is
+  // entirely past the tail
+  if(fSilentSampleCount >= silentSamples)
+  {
+#ifdef JAMBA_DEBUG_LOGGING
+    DLOG_F(INFO, "RTProcessor::updateSilenceBypass - bypassing silent inputs");
+#endif
+    fBypassingSilence = true;
+    return true;
+  }
+
+  fSilentSampleCount += static_cast<uint64>(data.numSamples);
+  return false;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::processSilentInputs
+//------------------------------------------------------------------------
+tresult RTProcessor::processSilentInputs(ProcessData &data)
+{
+  if(data.numOutputs <= 0 || data.outputs == nullptr)
+    return kResultOk;
+
+  // the host may hand buffers containing anything (ex: reused from a pool) => always cleared (silent outputs must
+  // contain zeros)
+  for(int32 i = 0; i < data.numOutputs; i++)
+  {
+    auto &bus = data.outputs[i];
+
+    if(data.symbolicSampleSize == kSample32)
+      AudioBuffers32(bus, data.numSamples).clear();
+    else
+      AudioBuffers64(bus, data.numSamples).clear();
+
+    bus.silenceFlags = allChannelsSilent(bus.numChannels);
+  }
+
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::enableSampleAccurateAutomation
+//------------------------------------------------------------------------
+void RTProcessor::enableSampleAccurateAutomation(int32 iMaxPointsPerBlock, int32 iMinSubBlockSize)
+{
+  fSampleAccurateAutomation = true;
+  fMinSubBlockSize = std::max(iMinSubBlockSize, 1);
+  fMaxAutomationPointsPerBlock = std::max(iMaxPointsPerBlock, 1);
+  getRTState()->enableSampleAccurateAutomation(iMaxPointsPerBlock);
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::processInputsWithAutomation
+//------------------------------------------------------------------------
+tresult RTProcessor::processInputsWithAutomation(ProcessData &data)
+{
+  auto state = getRTState();
+
+  ProcessData subBlock = data;
+
+  if(data.processContext)
+  {
+    fSubBlockProcessContext = *data.processContext;
+    subBlock.processContext = &fSubBlockProcessContext;
+  }
+
+  // the output silence flags are computed across all sub-blocks (silent only if silent in every sub-block)
+  auto &outputSilenceFlags = fSubBlockOutputs.fSilenceFlags;
+  auto numOutputs = std::min(data.numOutputs, static_cast<int32>(outputSilenceFlags.size()));
+  for(int32 i = 0; i < numOutputs; i++)
+    outputSilenceFlags[i] = ~static_cast<uint64>(0);
+
+  tresult res = kResultOk;
+
+  state->rewindAutomation();
+
+  int32 offset = 0;
+  while(offset < data.numSamples)
+  {
+    state->advanceAutomation(offset);
+
+    auto next = state->getNextAutomationSampleOffset(offset, data.numSamples);
+    next = std::min(std::max(next, offset + fMinSubBlockSize), data.numSamples);
+
+    // the host provided a configuration that was not preallocated => process the frame in one shot
+    if(!fSubBlockInputs.slice(data.symbolicSampleSize, data.numInputs, data.inputs, offset, subBlock.inputs) ||
+       !fSubBlockOutputs.slice(data.symbolicSampleSize, data.numOutputs, data.outputs, offset, subBlock.outputs))
+    {
+      DLOG_F(WARNING, "RTProcessor::processInputsWithAutomation - unexpected bus configuration");
+      state->advanceAutomation(data.numSamples);
+      return offset == 0 ? processInputs(data) : kResultFalse;
+    }
+
+    subBlock.numSamples = next - offset;
+    if(data.processContext)
+      fSubBlockProcessContext.projectTimeSamples = data.processContext->projectTimeSamples + offset;
+
+    // only the events and parameter changes of the sub-block (the first (resp. last) sub-block also gets the ones
+    // before (resp. after) the frame), relative to the sub-block
+    auto fromOffset = offset == 0 ? kMinSampleOffset : offset;
+    auto toOffset = next == data.numSamples ? kMaxSampleOffset : next;
+
+    if(data.inputEvents)
+    {
+      fSubBlockInputEvents.clear();
+      fSubBlockInputEvents.copyFrom(data.inputEvents, fromOffset, toOffset, -offset);
+      subBlock.inputEvents = &fSubBlockInputEvents;
+    }
+
+    if(data.inputParameterChanges)
+    {
+      fSubBlockInputParameterChanges.clear();
+      fSubBlockInputParameterChanges.copyFrom(data.inputParameterChanges, fromOffset, toOffset, -offset);
+      subBlock.inputParameterChanges = &fSubBlockInputParameterChanges;
+    }
+
+    if(data.outputEvents)
+    {
+      fSubBlockOutputEvents.clear();
+      subBlock.outputEvents = &fSubBlockOutputEvents;
+    }
+
+    if(data.outputParameterChanges)
+    {
+      fSubBlockOutputParameterChanges.clear();
+      subBlock.outputParameterChanges = &fSubBlockOutputParameterChanges;
+    }
+
+    auto subBlockRes = processInputs(subBlock);
+    if(res == kResultOk)
+      res = subBlockRes;
+
+    // what the sub-block produced is relative to the frame for the host
+    fSubBlockOutputEvents.moveTo(data.outputEvents, kMaxSampleOffset, offset);
+    fSubBlockOutputParameterChanges.moveTo(data.outputParameterChanges, kMaxSampleOffset, offset);
+
+    for(int32 i = 0; i < numOutputs; i++)
+      outputSilenceFlags[i] &= subBlock.outputs[i].silenceFlags;
+
+    offset = next;
+  }
+
+  // makes sure that all points have been applied (values are the same as without sample accurate automation)
+  state->advanceAutomation(data.numSamples);
+
+  for(int32 i = 0; i < numOutputs; i++)
+    data.outputs[i].silenceFlags = outputSilenceFlags[i];
+
+  return res;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::SubBlockBusBuffers::resize
+//------------------------------------------------------------------------
+void RTProcessor::SubBlockBusBuffers::resize(BusList const &iBusList)
+{
+  auto numBusses = static_cast<int32>(iBusList.size());
+
+  fBuffers.resize(static_cast<size_t>(numBusses));
+  fSilenceFlags.resize(static_cast<size_t>(numBusses));
+  fChannelBuffers32.resize(static_cast<size_t>(numBusses));
+  fChannelBuffers64.resize(static_cast<size_t>(numBusses));
+
+  for(int32 i = 0; i < numBusses; i++)
+  {
+    auto bus = static_cast<AudioBus *>(iBusList.at(i).get());
+    auto numChannels = bus ? SpeakerArr::getChannelCount(bus->getArrangement()) : 0;
+    fChannelBuffers32[i].resize(static_cast<size_t>(numChannels));
+    fChannelBuffers64[i].resize(static_cast<size_t>(numChannels));
+  }
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::SubBlockBusBuffers::slice
+//------------------------------------------------------------------------
+bool RTProcessor::SubBlockBusBuffers::slice(int32 iSymbolicSampleSize,
+                                            int32 iNumBusses,
+                                            AudioBusBuffers const *iBuffers,
+                                            int32 iSampleOffset,
+                                            AudioBusBuffers *&oBuffers)
+{
+  if(iNumBusses <= 0 || iBuffers == nullptr)
+  {
+    oBuffers = const_cast<AudioBusBuffers *>(iBuffers);
+    return true;
+  }
+
+  if(iNumBusses > static_cast<int32>(fBuffers.size()))
+    return false;
+
+  for(int32 i = 0; i < iNumBusses; i++)
+  {
+    auto const &from = iBuffers[i];
+    auto &to = fBuffers[i];
+
+    to.numChannels = from.numChannels;
+    to.silenceFlags = from.silenceFlags;
+
+    if(iSymbolicSampleSize == kSample32)
+    {
+      auto &channels = fChannelBuffers32[i];
+      if(from.numChannels > static_cast<int32>(channels.size()))
+        return false;
+      for(int32 c = 0; c < from.numChannels; c++)
+      {
+        auto ptr = from.channelBuffers32 ? from.channelBuffers32[c] : nullptr;
+        channels[c] = ptr ? ptr + iSampleOffset : nullptr;
+      }
+      to.channelBuffers32 = from.channelBuffers32 ? channels.data() : nullptr;
+    }
+    else
+    {
+      auto &channels = fChannelBuffers64[i];
+      if(from.numChannels > static_cast<int32>(channels.size()))
+        return false;
+      for(int32 c = 0; c < from.numChannels; c++)
+      {
+        auto ptr = from.channelBuffers64 ? from.channelBuffers64[c] : nullptr;
+        channels[c] = ptr ? ptr + iSampleOffset : nullptr;
+      }
+      to.channelBuffers64 = from.channelBuffers64 ? channels.data() : nullptr;
+    }
+  }
+
+  oBuffers = fBuffers.data();
+  return true;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::enableFixedBlockProcessing
+//------------------------------------------------------------------------
+void RTProcessor::enableFixedBlockProcessing(int32 iBlockSize, int32 iMaxPointsPerBlock)
+{
+  fFixedBlockSize = std::max(iBlockSize, 0);
+  fFixedBlockMaxPointsPerBlock = std::max(iMaxPointsPerBlock, 1);
+  if(fFixedBlockSize > 0)
+    getRTState()->enableSampleAccurateAutomation(iMaxPointsPerBlock);
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::getLatencySamples
+//------------------------------------------------------------------------
+uint32 RTProcessor::getLatencySamples()
+{
+  auto latency = AudioEffect::getLatencySamples();
+  if(!fFixedBlockFallback)
+    latency += static_cast<uint32>(fFixedBlockSize);
+  for(auto source: fLatencySources)
+    latency += source->getLatencySamples();
+  return latency;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::addLatencySource
+//------------------------------------------------------------------------
+void RTProcessor::addLatencySource(ILatencySource const *iLatencySource)
+{
+  DCHECK_F(iLatencySource != nullptr);
+  if(iLatencySource)
+    fLatencySources.emplace_back(iLatencySource);
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::updateLatency
+//------------------------------------------------------------------------
+void RTProcessor::updateLatency()
+{
+  auto latency = getLatencySamples();
+  if(latency != fReportedLatency)
+  {
+    fReportedLatency = latency;
+    fLatencyChanged = true;
+  }
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::onGUIMessageTimer
+//------------------------------------------------------------------------
+void RTProcessor::onGUIMessageTimer()
+{
+  if(fLatencyChanged.exchange(false))
+    notifyLatencyChanged();
+
+  if(getRTState()->isMessagingEnabled())
+    sendPendingMessages();
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::notifyLatencyChanged
+//------------------------------------------------------------------------
+tresult RTProcessor::notifyLatencyChanged()
+{
+  auto message = allocateMessage();
+
+  if(!message)
+    return kResultFalse;
+
+  Message m{message.get()};
+  m.setInt(ATTR_MSG_LATENCY, getLatencySamples());
+
+  return sendMessage(message);
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::enableLatencyCompensation
+//------------------------------------------------------------------------
+void RTProcessor::enableLatencyCompensation(uint32 iMaxLatencySamples)
+{
+  fMaxCompensatedLatency = iMaxLatencySamples;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::getDryDelayLines
+//------------------------------------------------------------------------
+template<typename SampleType>
+std::vector<std::unique_ptr<Utils::Collection::RingBuffer<SampleType>>> &RTProcessor::getDryDelayLines()
+{
+  if constexpr(std::is_same_v<SampleType, Sample32>)
+    return fDryDelayLines32;
+  else
+    return fDryDelayLines64;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::writeDryDelayLines
+//------------------------------------------------------------------------
+template<typename SampleType>
+void RTProcessor::writeDryDelayLines(ProcessData const &data)
+{
+  auto &delayLines = getDryDelayLines<SampleType>();
+  if(delayLines.empty() || data.numInputs < 1)
+    return;
+
+  auto channels = getChannelBuffers<SampleType>(data.inputs[0]);
+  auto numChannels = std::min(static_cast<int32>(delayLines.size()), data.inputs[0].numChannels);
+  for(int32 c = 0; c < numChannels; c++)
+  {
+    if(channels && channels[c])
+      delayLines[c]->write(channels[c], data.numSamples);
+  }
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::mixDelayedDry
+//------------------------------------------------------------------------
+template<typename SampleType>
+void RTProcessor::mixDelayedDry(ProcessData &data)
+{
+  auto &delayLines = getDryDelayLines<SampleType>();
+  if(delayLines.empty() || data.numOutputs < 1)
+    return;
+
+  auto dryMix = isBypassed() ? 1.0 : std::clamp(getDryMix(), 0.0, 1.0);
+  auto previousDryMix = fPreviousDryMix < 0 ? dryMix : fPreviousDryMix;
+  fPreviousDryMix = dryMix;
+
+  // nothing to mix
+  if(dryMix == 0 && previousDryMix == 0)
+    return;
+
+  auto numSamples = data.numSamples;
+  auto delay = static_cast<int>(std::min(fReportedLatency, fMaxCompensatedLatency));
+  if(delay + numSamples > delayLines[0]->getCapacity())
+  {
+    DLOG_F(WARNING, "RTProcessor::mixDelayedDry - frame too big [%d]", numSamples);
+    return;
+  }
+
+  auto &output = data.outputs[0];
+  auto channels = getChannelBuffers<SampleType>(output);
+  if(!channels)
+    return;
+
+  // ramps from the previous value to avoid clicks
+  auto step = (dryMix - previousDryMix) / numSamples;
+
+  for(int32 c = 0; c < output.numChannels; c++)
+  {
+    auto out = channels[c];
+    if(!out)
+      continue;
+
+    // no dry signal for this channel => the dry signal is silence
+    auto dry = c < static_cast<int32>(delayLines.size()) ? delayLines[c]->getSpan(numSamples, delay) : nullptr;
+
+    if(dryMix == 1 && previousDryMix == 1)
+    {
+      if(dry)
+        std::copy(dry, dry + numSamples, out);
+      else
+        std::fill(out, out + numSamples, 0);
+      continue;
+    }
+
+    for(int32 i = 0; i < numSamples; i++)
+    {
+      auto gain = static_cast<SampleType>(previousDryMix + step * (i + 1));
+      out[i] = out[i] + ((dry ? dry[i] : 0) - out[i]) * gain;
+    }
+  }
+
+  output.silenceFlags = 0;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::processInputsInFixedBlocks
+//------------------------------------------------------------------------
+tresult RTProcessor::processInputsInFixedBlocks(ProcessData &data)
+{
+  // the host provided a configuration that was not preallocated => fixed block processing is disabled until the
+  // processor is activated again (so that the latency reported to the host is accurate)
+  if(!fFixedBlockInputs.matches(data.symbolicSampleSize, data.numInputs, data.inputs) ||
+     !fFixedBlockOutputs.matches(data.symbolicSampleSize, data.numOutputs, data.outputs))
+  {
+    DLOG_F(WARNING, "RTProcessor::processInputsInFixedBlocks - unexpected bus configuration");
+    fFixedBlockFallback = true;
+    updateLatency();
+    return processInputs(data);
+  }
+
+  auto state = getRTState();
+  auto hasAutomationPoints = state->hasAutomationPoints();
+
+  ProcessData block = data;
+  block.numSamples = fFixedBlockSize;
+  if(data.numInputs > 0)
+    block.inputs = fFixedBlockInputs.fBuffers.data();
+  if(data.numOutputs > 0)
+    block.outputs = fFixedBlockOutputs.fBuffers.data();
+
+  if(data.processContext)
+  {
+    fFixedBlockProcessContext = *data.processContext;
+    block.processContext = &fFixedBlockProcessContext;
+  }
+
+  // the events and parameter changes are queued relative to the block being accumulated (like the inputs) and each
+  // block gets the ones that fall within it (relative to the block)
+  fFixedBlockInputEventsFIFO.copyFrom(data.inputEvents, kMinSampleOffset, kMaxSampleOffset, fFixedBlockOffset);
+  fFixedBlockInputParameterChangesFIFO.copyFrom(data.inputParameterChanges,
+                                                kMinSampleOffset,
+                                                kMaxSampleOffset,
+                                                fFixedBlockOffset);
+  block.inputEvents = &fFixedBlockInputEvents;
+  block.inputParameterChanges = &fFixedBlockInputParameterChanges;
+  block.outputEvents = data.outputEvents ? &fFixedBlockOutputEvents : nullptr;
+  block.outputParameterChanges = data.outputParameterChanges ? &fFixedBlockOutputParameterChanges : nullptr;
+
+  if(hasAutomationPoints)
+    state->rewindAutomation();
+
+  // the output silence flags are computed across all the blocks delivered in this frame
+  fFixedBlockOutputs.resetSilenceFlags();
+
+  tresult res = kResultOk;
+
+  int32 offset = 0;
+  while(offset < data.numSamples)
+  {
+    auto numSamples = std::min(fFixedBlockSize - fFixedBlockOffset, data.numSamples - offset);
+
+    fFixedBlockInputs.write(data.inputs, data.numInputs, offset, fFixedBlockOffset, numSamples);
+    fFixedBlockOutputs.read(data.outputs, data.numOutputs, offset, fFixedBlockOffset, numSamples);
+
+    offset += numSamples;
+    fFixedBlockOffset += numSamples;
+
+    if(fFixedBlockOffset == fFixedBlockSize)
+    {
+      // the block started fFixedBlockSize samples ago (when it started in a previous frame, the values in effect at
+      // the beginning of this frame are used)
+      auto blockStart = offset - fFixedBlockSize;
+
+      if(hasAutomationPoints)
+        state->advanceAutomation(std::max(blockStart, 0));
+
+      if(data.processContext)
+        fFixedBlockProcessContext.projectTimeSamples = data.processContext->projectTimeSamples + blockStart;
+
+      for(int32 i = 0; i < data.numInputs; i++)
+        fFixedBlockInputs.fBuffers[i].silenceFlags = fFixedBlockInputs.fSilenceFlags[i];
+      fFixedBlockInputs.resetSilenceFlags();
+
+      fFixedBlockInputEvents.clear();
+      fFixedBlockInputEventsFIFO.moveTo(&fFixedBlockInputEvents, fFixedBlockSize, 0);
+      fFixedBlockInputParameterChanges.clear();
+      fFixedBlockInputParameterChangesFIFO.moveTo(&fFixedBlockInputParameterChanges, fFixedBlockSize, 0);
+      fFixedBlockOutputEvents.clear();
+      fFixedBlockOutputParameterChanges.clear();
+
+      auto blockRes = processInputs(block);
+      if(res == kResultOk)
+        res = blockRes;
+
+      // what the block produced is delivered (like its outputs) starting now (relative to the frame)
+      fFixedBlockOutputEvents.moveTo(&fFixedBlockOutputEventsFIFO, kMaxSampleOffset, offset);
+      fFixedBlockOutputParameterChanges.moveTo(&fFixedBlockOutputParameterChangesFIFO, kMaxSampleOffset, offset);
+
+      fFixedBlockOffset = 0;
+    }
+  }
+
+  // hands over what falls within this frame (the rest becomes relative to the next frame)
+  fFixedBlockOutputEventsFIFO.moveTo(data.outputEvents, data.numSamples, 0);
+  fFixedBlockOutputParameterChangesFIFO.moveTo(data.outputParameterChanges, data.numSamples, 0);
+
+  // makes sure that all points have been applied (values are the same as without fixed block processing)
+  if(hasAutomationPoints)
+    state->advanceAutomation(data.numSamples);
+
+  for(int32 i = 0; i < data.numOutputs; i++)
+    data.outputs[i].silenceFlags = fFixedBlockOutputs.fSilenceFlags[i];
+
+  return res;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::FixedBlockBusBuffers::resize
+//------------------------------------------------------------------------
+void RTProcessor::FixedBlockBusBuffers::resize(BusList const &iBusList, int32 iSymbolicSampleSize, int32 iBlockSize)
+{
+  auto numBusses = iBusList.size();
+
+  fSymbolicSampleSize = iSymbolicSampleSize;
+  fBuffers.resize(numBusses);
+  fSilenceFlags.resize(numBusses);
+  fStorage32.clear();
+  fStorage64.clear();
+
+  for(size_t i = 0; i < numBusses; i++)
+  {
+    auto bus = static_cast<AudioBus *>(iBusList.at(i).get());
+    auto numChannels = bus ? SpeakerArr::getChannelCount(bus->getArrangement()) : 0;
+
+    fBuffers[i] = {};
+    fBuffers[i].numChannels = numChannels;
+
+    if(iSymbolicSampleSize == kSample32)
+    {
+      fStorage32.emplace_back(std::make_unique<OwnedAudioBuffers32>(numChannels, iBlockSize));
+      fBuffers[i].channelBuffers32 = fStorage32.back()->getBuffer();
+    }
+    else
+    {
+      fStorage64.emplace_back(std::make_unique<OwnedAudioBuffers64>(numChannels, iBlockSize));
+      fBuffers[i].channelBuffers64 = fStorage64.back()->getBuffer();
+    }
+  }
+
+  clear();
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::FixedBlockBusBuffers::clear
+//------------------------------------------------------------------------
+void RTProcessor::FixedBlockBusBuffers::clear()
+{
+  for(auto &storage: fStorage32)
+    storage->clear();
+
+  for(auto &storage: fStorage64)
+    storage->clear();
+
+  for(auto &buffers: fBuffers)
+    buffers.silenceFlags = allChannelsSilent(buffers.numChannels);
+
+  resetSilenceFlags();
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::FixedBlockBusBuffers::resetSilenceFlags
+//------------------------------------------------------------------------
+void RTProcessor::FixedBlockBusBuffers::resetSilenceFlags()
+{
+  for(size_t i = 0; i < fBuffers.size(); i++)
+    fSilenceFlags[i] = allChannelsSilent(fBuffers[i].numChannels);
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::FixedBlockBusBuffers::matches
+//------------------------------------------------------------------------
+bool RTProcessor::FixedBlockBusBuffers::matches(int32 iSymbolicSampleSize,
+                                                int32 iNumBusses,
+                                                AudioBusBuffers const *iBuffers) const
+{
+  if(iNumBusses <= 0)
+    return true;
+
+  if(iSymbolicSampleSize != fSymbolicSampleSize || iBuffers == nullptr ||
+     iNumBusses > static_cast<int32>(fBuffers.size()))
+    return false;
+
+  for(int32 i = 0; i < iNumBusses; i++)
+  {
+    if(iBuffers[i].numChannels != fBuffers[i].numChannels)
+      return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::FixedBlockBusBuffers::write
+//------------------------------------------------------------------------
+void RTProcessor::FixedBlockBusBuffers::write(AudioBusBuffers const *iBuffers,
+                                              int32 iNumBusses,
+                                              int32 iOffset,
+                                              int32 iBlockOffset,
+                                              int32 iNumSamples)
+{
+  for(int32 i = 0; i < iNumBusses; i++)
+  {
+    if(fSymbolicSampleSize == kSample32)
+      copyChannels<Sample32>(iBuffers[i], iOffset, fBuffers[i], iBlockOffset, iNumSamples);
+    else
+      copyChannels<Sample64>(iBuffers[i], iOffset, fBuffers[i], iBlockOffset, iNumSamples);
+
+    fSilenceFlags[i] &= iBuffers[i].silenceFlags;
+  }
+}
+
+//------------------------------------------------------------------------
+// RTProcessor::FixedBlockBusBuffers::read
+//------------------------------------------------------------------------
+void RTProcessor::FixedBlockBusBuffers::read(AudioBusBuffers *oBuffers,
+                                             int32 iNumBusses,
+                                             int32 iOffset,
+                                             int32 iBlockOffset,
+                                             int32 iNumSamples)
+{
+  for(int32 i = 0; i < iNumBusses; i++)
+  {
+    if(fSymbolicSampleSize == kSample32)
+      copyChannels<Sample32>(fBuffers[i], iBlockOffset, oBuffers[i], iOffset, iNumSamples);
+    else
+      copyChannels<Sample64>(fBuffers[i], iBlockOffset, oBuffers[i], iOffset, iNumSamples);
+
+    fSilenceFlags[i] &= fBuffers[i].silenceFlags;
+  }
+}
+
 //------------------------------------------------------------------------
 // RTProcessor::canProcessSampleSize
 //------------------------------------------------------------------------
@@ -21,6 +21,12 @@
 #include <public.sdk/source/vst/vstaudioeffect.h>
 #include <pongasoft/VST/Timer.h>
 #include "RTState.h"
+#include "RTScratchArena.h"
+#include "RTEventLists.h"
+#include <pongasoft/VST/AudioBuffer.h>
+#include <pongasoft/VST/ILatencySource.h>
+#include <pongasoft/Utils/Collection/RingBuffer.h>
+#include <atomic>
 
 namespace pongasoft {
 namespace VST {
@@ -52,9 +58,15 @@ public:
   /** Switch the Plug-in on/off */
   tresult PLUGIN_API setActive(TBool state) override;
 
+  /** Called by the host to set the processing parameters (sample rate, max block size...) */
+  tresult PLUGIN_API setupProcessing(ProcessSetup &setup) override;
+
   /** Here we go...the process call */
   tresult PLUGIN_API process(ProcessData &data) override;
 
+  /** Returns the latency introduced by the processor (see `enableFixedBlockProcessing` and `addLatencySource`) */
+  uint32 PLUGIN_API getLatencySamples() override;
+
   /** Asks if a given sample size is supported see `SymbolicSampleSizes`. */
   tresult PLUGIN_API canProcessSampleSize(int32 symbolicSampleSize) override;
 
@@ -110,6 +122,198 @@ protected:
    * Called (from a GUI timer) to send the messages to the GUI (JmbParam for the moment) */
    virtual void sendPendingMessages() { getRTState()->sendPendingMessages(this); }
 
+  /**
+   * Call this method to enable sample accurate automation: every automation point sent by the host is recorded
+   * and, when there are any, `processInputs` is called once per sub-block (delimited by the automation points) with
+   * a `ProcessData` whose buffers and `numSamples` cover only the sub-block. The parameters (`RTVstParam`) reflect
+   * the value in effect at the beginning of each sub-block. The events (`inputEvents` / `outputEvents`) and the
+   * parameter changes (`inputParameterChanges` / `outputParameterChanges`) only cover the sub-block and their sample
+   * offsets are relative to the beginning of the sub-block (at most `kMaxEventsPerBlock` events per sub-block).
+   *
+   * Should be called in the `initialize` method (after calling `RTProcessor::initialize`) as it allocates memory.
+   *
+   * @param iMaxPointsPerBlock the maximum number of automation points recorded per parameter per frame
+   * @param iMinSubBlockSize sub-blocks are never smaller than this (except for the last one): automation points
+   *                         closer than this are applied together, trading resolution for efficiency
+   */
+  void enableSampleAccurateAutomation(int32 iMaxPointsPerBlock = 64, int32 iMinSubBlockSize = 1);
+
+  /**
+   * Called by `process` instead of `processInputs` when sample accurate automation is enabled and there are
+   * automation points in this frame. Splits the frame into sub-blocks and calls `processInputs` for each of them.
+   *
+   * @return the result of the first call to `processInputs` which did not return `kResultOk` (all the sub-blocks
+   *         are processed regardless)
+   */
+  virtual tresult processInputsWithAutomation(ProcessData &data);
+
+  //! Maximum number of events handed to `processInputs` per sub-block or fixed block (extra events are dropped)
+  static constexpr int32 kMaxEventsPerBlock = 1024;
+
+  /**
+   * Call this method to enable the silence bypass: when every input bus is flagged as silent by the host (and
+   * there are no input events or parameter changes), the processor keeps calling `processInputs` until the tail (as
+   * returned by `getTailSamples`) followed by the latency (as returned by `getLatencySamples`, so that the buffered
+   * audio and the delayed dry signal are flushed) has elapsed, after which `processInputs` is no longer called: the
+   * outputs are cleared (on every frame, as the host may reuse the buffers) and flagged as silent. Processing resumes
+   * as soon as any input is not silent anymore or a parameter changes (see `areInputsSilent`).
+   *
+   * Only makes sense for effects: plugins that generate sound without input (or with an infinite tail) should not
+   * enable it. Should be called in the `initialize` method (after calling `RTProcessor::initialize`).
+   */
+  void enableSilenceBypass(bool iEnable = true) { fSilenceBypass = iEnable; }
+
+  /**
+   * Call this method to flush denormals to zero for the duration of each `process` call (see `DenormalGuard`): the
+   * floating point mode of the host is restored when `process` returns. Disabled by default. Can be called anytime.
+   */
+  void enableDenormalsFlushing(bool iEnable = true) { fFlushDenormals = iEnable; }
+
+  //! @return `true` if denormals are flushed to zero during `process`
+  bool isFlushingDenormals() const { return fFlushDenormals; }
+
+  /**
+   * @return `true` when `process` simply calls `processInputs` once per frame, meaning that none of the options
+   *         changing how it is called (silence bypass, fixed block processing, sample accurate automation) or what
+   *         happens around it (latency sources, latency compensation) is enabled
+   */
+  bool isPlainProcessing() const
+  {
+    return !fSilenceBypass && fFixedBlockSize == 0 && !fSampleAccurateAutomation && fLatencySources.empty() &&
+           fMaxCompensatedLatency == 0;
+  }
+
+  /**
+   * @return `true` if every input bus is flagged as silent and there are no input events nor parameter changes
+   *         (note that it returns `false` when there is no input at all) */
+  virtual bool areInputsSilent(ProcessData const &data) const;
+
+  //! @return `true` if the silence bypass is enabled and the tail has elapsed (meaning `processInputs` is skipped)
+  bool isBypassingSilence() const { return fBypassingSilence; }
+
+  /**
+   * Called by `process` instead of `processInputs` when bypassing silence: clears the outputs and sets the
+   * silence flags */
+  virtual tresult processSilentInputs(ProcessData &data);
+
+  /**
+   * Call this method to enable fixed block processing: whatever the number of samples the host provides in each
+   * `process` call (which can be anything between 1 and `maxSamplesPerBlock`), `processInputs` is always called with
+   * exactly `iBlockSize` samples. The inputs are accumulated in internal buffers (and the outputs delivered from
+   * internal buffers) which adds a latency of `iBlockSize` samples, reported to the host via `getLatencySamples`
+   * (make sure to call `RTProcessor::getLatencySamples` if you override it).
+   *
+   * The parameter changes are kept aligned with the re-blocked timeline: each block sees the parameter values in
+   * effect at the (host) sample where the block starts (the automation points are recorded for this purpose, see
+   * `RTState::enableSampleAccurateAutomation`). The `processContext` is adjusted accordingly. Fixed block processing
+   * takes precedence over sample accurate automation (the block is never split).
+   *
+   * The input events and parameter changes are queued along with the inputs: each block receives the ones that fall
+   * within it, exactly once, with offsets relative to the block (at most `kMaxEventsPerBlock` events per block).
+   * What a block produces (output events and parameter changes) is delayed like its outputs and handed to the host
+   * with offsets relative to the frame in which it falls.
+   *
+   * If the host calls `process` with a bus configuration which differs from the one the buffers were allocated for,
+   * `processInputs` is called directly with the frame and fixed block processing remains disabled (which is
+   * reflected in the reported latency) until the processor is activated again.
+   *
+   * Should be called in the `initialize` method (after calling `RTProcessor::initialize`) as it allocates memory.
+   *
+   * @param iBlockSize the number of samples `processInputs` is always called with
+   * @param iMaxPointsPerBlock the maximum number of automation points recorded per parameter per frame
+   */
+  void enableFixedBlockProcessing(int32 iBlockSize, int32 iMaxPointsPerBlock = 64);
+
+  //! @return the size of the blocks when fixed block processing is enabled, `0` otherwise
+  inline int32 getFixedBlockSize() const { return fFixedBlockSize; }
+
+  /**
+   * Called by `process` instead of `processInputs` when fixed block processing is enabled: accumulates the inputs
+   * and calls `processInputs` every time a full block is available. */
+  virtual tresult processInputsInFixedBlocks(ProcessData &data);
+
+  /**
+   * Registers a processing stage which delays the signal (ex: `STFTProcessor`) so that its latency is added to the
+   * latency reported to the host (see `getLatencySamples`). The stages are assumed to be in series (the latencies are
+   * summed). The source is not owned and must outlive this processor.
+   *
+   * The latency is checked at the beginning of every `process` call: when it changes (ex: the lookahead of a limiter
+   * is a parameter), the controller is notified (from the GUI message timer) and calls
+   * `restartComponent(kLatencyChanged)` so that the host queries `getLatencySamples` again (see
+   * `notifyLatencyChanged`).
+   *
+   * Should be called in the `initialize` method (after calling `RTProcessor::initialize`) as it allocates memory.
+   */
+  void addLatencySource(ILatencySource const *iLatencySource);
+
+  /**
+   * Call this method to enable latency compensation: the main input bus is delayed by the latency of the processor
+   * (as returned by `getLatencySamples`) so that the dry signal can be mixed into the main output bus in sync with
+   * the (delayed) processed signal, after `processInputs` returns. The latency is checked at the beginning of every
+   * `process` call (even without latency sources, ex: `getLatencySamples` is overridden) and the controller is
+   * notified when it changes (see `addLatencySource`):
+   *
+   * - when `isBypassed()` returns `true`, the outputs are replaced by the delayed inputs (`processInputs` is still
+   *   called so that the processing stages stay primed and un-bypassing is seamless)
+   * - otherwise `getDryMix()` of the delayed inputs is mixed in: `out = (1 - dryMix) * wet + dryMix * dry`
+   *
+   * Changes of bypass or dry mix are ramped over one frame to avoid clicks. The compensation is skipped while
+   * bypassing silence (see `enableSilenceBypass`) which only happens once the delayed dry signal has been flushed.
+   *
+   * Should be called in the `initialize` method (after calling `RTProcessor::initialize`). The memory is allocated
+   * in `setActive`.
+   *
+   * @param iMaxLatencySamples the maximum latency which can be compensated (a bigger latency is capped)
+   */
+  void enableLatencyCompensation(uint32 iMaxLatencySamples);
+
+  /**
+   * Subclasses override this method to return the state of their bypass parameter (only used when latency
+   * compensation is enabled, see `enableLatencyCompensation`). */
+  virtual bool isBypassed() const { return false; }
+
+  /**
+   * Subclasses override this method to return the proportion (in the range `[0, 1]`) of the (delay compensated)
+   * dry signal mixed into the outputs (only used when latency compensation is enabled, see
+   * `enableLatencyCompensation`). */
+  virtual double getDryMix() const { return 0; }
+
+  /**
+   * Called from the GUI message timer when the latency has changed during processing. The default implementation
+   * sends a message to the controller which calls `restartComponent(kLatencyChanged)` (see `GUIController::notify`).
+   * /////// WARNING !!!!! this method WILL be called from the UI thread !!!!! //////
+   */
+  virtual tresult notifyLatencyChanged();
+
+  /**
+   * Called by the GUI message timer: notifies the controller if the latency has changed and sends the pending
+   * messages (see `sendPendingMessages`) */
+  void onGUIMessageTimer();
+
+  /**
+   * Call this method to enable the scratch arena: temporary memory that the processing code can allocate (via
+   * `getScratchArena()`) without any heap allocation. The memory is reserved in `setupProcessing` based on
+   * `ProcessSetup::maxSamplesPerBlock` (see `computeScratchArenaSize`) and everything allocated is released at the
+   * end of each `process` call.
+   *
+   * Should be called in the constructor or `initialize` method (before `setupProcessing`).
+   *
+   * @param iMaxScratchChannels the maximum number of channels (of `maxSamplesPerBlock` samples) allocated during a
+   *                            single `process` call (see `RTScratchArena::allocateAudioBusBuffers`)
+   * @param iExtraBytes additional memory for anything else
+   */
+  void enableScratchArena(int32 iMaxScratchChannels, size_t iExtraBytes = 0);
+
+  /**
+   * @return the scratch arena (empty until `enableScratchArena` is called and `setupProcessing` happens). Must only
+   *         be used from the RT thread and what is allocated is only valid until the end of the `process` call. */
+  inline RTScratchArena &getScratchArena() { return fScratchArena; }
+
+  /**
+   * Called from `setupProcessing` to compute the number of bytes reserved for the scratch arena. The default
+   * implementation reserves enough for the number of channels and extra bytes provided in `enableScratchArena`. */
+  virtual size_t computeScratchArenaSize(ProcessSetup const &setup) const;
+
 protected:
   // interval for gui message timer (can be changed by subclass BEFORE calling initialize)
   uint32 fGUIMessageTimerIntervalMs;
@@ -124,6 +328,76 @@ public:
 private:
   using RTProcessorCallback = void (RTProcessor::*)();
 
+  // updates the silence bypass state for this frame and returns `true` if the frame should be bypassed
+  bool updateSilenceBypass(ProcessData const &data);
+
+  // checks if the latency has changed since it was last reported (RT thread)
+  void updateLatency();
+
+  // returns the dry delay lines for the given sample type
+  template<typename SampleType>
+  std::vector<std::unique_ptr<Utils::Collection::RingBuffer<SampleType>>> &getDryDelayLines();
+
+  // writes the main input bus into the dry delay lines (before processing)
+  template<typename SampleType>
+  void writeDryDelayLines(ProcessData const &data);
+
+  // mixes the delayed dry signal into the main output bus (after processing)
+  template<typename SampleType>
+  void mixDelayedDry(ProcessData &data);
+
+  /**
+   * Preallocated storage to represent a sub-block of a set of busses (same channel pointers but shifted) */
+  struct SubBlockBusBuffers
+  {
+    // resizes the storage (not RT safe)
+    void resize(BusList const &iBusList);
+
+    // populates oData with the slice [iSampleOffset, iSampleOffset + iNumSamples[ of iBuffers
+    bool slice(int32 iSymbolicSampleSize,
+               int32 iNumBusses,
+               AudioBusBuffers const *iBuffers,
+               int32 iSampleOffset,
+               AudioBusBuffers *&oBuffers);
+
+    std::vector<AudioBusBuffers> fBuffers{};
+    std::vector<std::vector<Sample32 *>> fChannelBuffers32{};
+    std::vector<std::vector<Sample64 *>> fChannelBuffers64{};
+    std::vector<uint64> fSilenceFlags{};
+  };
+
+  /**
+   * Preallocated (internal) buffers used for fixed block processing (the content of the inputs (resp. outputs) of
+   * the block being accumulated (resp. delivered)) */
+  struct FixedBlockBusBuffers
+  {
+    // allocates the storage (not RT safe)
+    void resize(BusList const &iBusList, int32 iSymbolicSampleSize, int32 iBlockSize);
+
+    // clears the buffers and sets the silence flags
+    void clear();
+
+    // returns true if iBuffers has the same layout as the internal buffers
+    bool matches(int32 iSymbolicSampleSize, int32 iNumBusses, AudioBusBuffers const *iBuffers) const;
+
+    // copies iNumSamples samples from iBuffers (starting at iOffset) into the internal buffers (starting at
+    // iBlockOffset) and accumulates the silence flags into fSilenceFlags
+    void write(AudioBusBuffers const *iBuffers, int32 iNumBusses, int32 iOffset, int32 iBlockOffset, int32 iNumSamples);
+
+    // copies iNumSamples samples from the internal buffers (starting at iBlockOffset) into oBuffers (starting at
+    // iOffset) and accumulates the silence flags into fSilenceFlags
+    void read(AudioBusBuffers *oBuffers, int32 iNumBusses, int32 iOffset, int32 iBlockOffset, int32 iNumSamples);
+
+    // sets all the flags of fSilenceFlags (silent)
+    void resetSilenceFlags();
+
+    int32 fSymbolicSampleSize{-1};
+    std::vector<AudioBusBuffers> fBuffers{};
+    std::vector<std::unique_ptr<OwnedAudioBuffers32>> fStorage32{};
+    std::vector<std::unique_ptr<OwnedAudioBuffers64>> fStorage64{};
+    std::vector<uint64> fSilenceFlags{};
+  };
+
   // wrapper class to dispatch the callback
   class GUITimerCallback : public ITimerCallback
   {
@@ -149,11 +423,64 @@ private:
   std::unique_ptr<AutoReleaseTimer> fGUITimer;
 
   // the timer that will handle sending messages (enabled when there are messages to handle)
-  GUITimerCallback fGUIMessageTimerCallback{this, &RTProcessor::sendPendingMessages};
+  GUITimerCallback fGUIMessageTimerCallback{this, &RTProcessor::onGUIMessageTimer};
   std::unique_ptr<AutoReleaseTimer> fGUIMessageTimer;
 
   bool fActive;
 
+  // sample accurate automation (disabled by default)
+  bool fSampleAccurateAutomation{false};
+  int32 fMinSubBlockSize{1};
+  int32 fMaxAutomationPointsPerBlock{0};
+  SubBlockBusBuffers fSubBlockInputs{};
+  SubBlockBusBuffers fSubBlockOutputs{};
+  ProcessContext fSubBlockProcessContext{};
+  RTEventList fSubBlockInputEvents{};
+  RTEventList fSubBlockOutputEvents{};
+  RTParameterChanges fSubBlockInputParameterChanges{};
+  RTParameterChanges fSubBlockOutputParameterChanges{};
+
+  // flush denormals to zero during process (disabled by default)
+  bool fFlushDenormals{false};
+
+  // silence bypass (disabled by default)
+  bool fSilenceBypass{false};
+  bool fBypassingSilence{false};
+  uint64 fSilentSampleCount{0};
+
+  // fixed block processing (disabled by default)
+  int32 fFixedBlockSize{0};
+  int32 fFixedBlockMaxPointsPerBlock{1};
+  int32 fFixedBlockOffset{0};
+  std::atomic<bool> fFixedBlockFallback{false}; // unexpected bus configuration => disabled until setActive
+  FixedBlockBusBuffers fFixedBlockInputs{};
+  FixedBlockBusBuffers fFixedBlockOutputs{};
+  ProcessContext fFixedBlockProcessContext{};
+  RTEventList fFixedBlockInputEventsFIFO{}; // relative to the block being accumulated
+  RTEventList fFixedBlockInputEvents{};
+  RTEventList fFixedBlockOutputEvents{};
+  RTEventList fFixedBlockOutputEventsFIFO{}; // relative to the current frame
+  RTParameterChanges fFixedBlockInputParameterChangesFIFO{};
+  RTParameterChanges fFixedBlockInputParameterChanges{};
+  RTParameterChanges fFixedBlockOutputParameterChanges{};
+  RTParameterChanges fFixedBlockOutputParameterChangesFIFO{};
+
+  // the stages adding latency (see addLatencySource)
+  std::vector<ILatencySource const *> fLatencySources{};
+  uint32 fReportedLatency{0};
+  std::atomic<bool> fLatencyChanged{false};
+
+  // latency compensation (disabled by default)
+  uint32 fMaxCompensatedLatency{0};
+  std::vector<std::unique_ptr<Utils::Collection::RingBuffer<Sample32>>> fDryDelayLines32{};
+  std::vector<std::unique_ptr<Utils::Collection::RingBuffer<Sample64>>> fDryDelayLines64{};
+  double fPreviousDryMix{-1};
+
+  // scratch arena (disabled by default)
+  RTScratchArena fScratchArena{};
+  int32 fScratchArenaMaxChannels{0};
+  size_t fScratchArenaExtraBytes{0};
+
 #ifdef JAMBA_DEBUG_LOGGING
   int32 fSymbolicSampleSize = -1;
 #endif
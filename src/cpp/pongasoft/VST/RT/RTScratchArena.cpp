@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#include "RTScratchArena.h"
+
+#include <pongasoft/logging/logging.h>
+
+#include <cstdint>
+
+namespace pongasoft::VST::RT {
+
+namespace {
+
+// alignUp (iAlignment must be a power of 2)
+inline size_t alignUp(size_t iValue, size_t iAlignment)
+{
+  return (iValue + iAlignment - 1) & ~(iAlignment - 1);
+}
+
+}
+
+//------------------------------------------------------------------------
+// RTScratchArena::reserve
+//------------------------------------------------------------------------
+void RTScratchArena::reserve(size_t iCapacity)
+{
+  fSize = 0;
+
+  if(iCapacity <= fCapacity)
+    return;
+
+  // allocating kAlignment more bytes so that the beginning of the arena can be aligned
+  fMemory = std::make_unique<char[]>(iCapacity + kAlignment);
+  auto address = reinterpret_cast<std::uintptr_t>(fMemory.get());
+  fAlignedMemory = fMemory.get() + (alignUp(address, kAlignment) - address);
+  fCapacity = iCapacity;
+  fHighWaterMark = 0;
+}
+
+//------------------------------------------------------------------------
+// RTScratchArena::allocate
+//------------------------------------------------------------------------
+void *RTScratchArena::allocate(size_t iSize, size_t iAlignment)
+{
+  DCHECK_F((iAlignment & (iAlignment - 1)) == 0, "alignment must be a power of 2");
+
+  // aligning the address (and not simply the offset) so that alignments bigger than kAlignment work as well
+  auto base = reinterpret_cast<std::uintptr_t>(fAlignedMemory);
+  auto offset = alignUp(base + fSize, std::max(iAlignment, static_cast<size_t>(1))) - base;
+
+  if(offset > fCapacity || iSize > fCapacity - offset)
+    return nullptr;
+
+  fSize = offset + iSize;
+  fHighWaterMark = std::max(fHighWaterMark, fSize);
+
+  return fAlignedMemory + offset;
+}
+
+//------------------------------------------------------------------------
+// RTScratchArena::computeAudioBusBuffersSize
+//------------------------------------------------------------------------
+size_t RTScratchArena::computeAudioBusBuffersSize(int32 iNumChannels, int32 iNumSamples, size_t iSampleSize)
+{
+  auto numChannels = static_cast<size_t>(std::max(iNumChannels, 0));
+  auto numSamples = static_cast<size_t>(std::max(iNumSamples, 0));
+
+  return alignUp(sizeof(AudioBusBuffers), kAlignment) +
+         alignUp(numChannels * sizeof(void *), kAlignment) +
+         numChannels * alignUp(numSamples * iSampleSize, kAlignment);
+}
+
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include <pluginterfaces/vst/ivstaudioprocessor.h>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace pongasoft::VST::RT {
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+/**
+ * Scratch memory for the RT thread: a (bump) arena allocator whose memory is allocated once, outside of the RT
+ * thread (`reserve`), and then handed out in the RT thread by simply moving an offset forward. Individual
+ * allocations are never freed: the whole arena is `reset` at once (`RTProcessor` does it at the end of each
+ * `process` call), which means that the memory is only valid for the duration of the frame.
+ *
+ * Every allocation is aligned (`kAlignment` by default) so that it can be used with simd instructions and does not
+ * share a cache line with the previous allocation.
+ *
+ * This class is not thread safe (it is meant to be used by the RT thread only, except for `reserve`).
+ */
+class RTScratchArena
+{
+public:
+  //! Default alignment of each allocation (cache line size, large enough for any simd instruction set)
+  static constexpr size_t kAlignment = 64;
+
+  /**
+   * Allocates the memory for the arena (NOT RT safe). Does nothing if the arena already has enough memory.
+   * Resets the arena. */
+  void reserve(size_t iCapacity);
+
+  //! @return the number of bytes available in the arena (`0` until `reserve` is called)
+  inline size_t getCapacity() const { return fCapacity; }
+
+  //! @return the number of bytes currently allocated (including alignment padding)
+  inline size_t getSize() const { return fSize; }
+
+  //! @return the maximum value of `getSize` since the arena was reserved (useful to size the arena)
+  inline size_t getHighWaterMark() const { return fHighWaterMark; }
+
+  //! Releases all the allocations at once (the memory remains reserved)
+  inline void reset() { fSize = 0; }
+
+  /**
+   * Allocates `iSize` bytes aligned on `iAlignment` (which must be a power of 2, and can be bigger than
+   * `kAlignment` in which case padding is added as needed). The memory is not initialized.
+   *
+   * @return the memory or `nullptr` if there is not enough room left in the arena */
+  void *allocate(size_t iSize, size_t iAlignment = kAlignment);
+
+  /**
+   * Allocates an (uninitialized) array of `iCount` elements of type `T` (which must be trivial since no
+   * constructor nor destructor is ever called).
+   *
+   * @return the array or `nullptr` if there is not enough room left in the arena */
+  template<typename T>
+  inline T *allocateArray(size_t iCount)
+  {
+    static_assert(std::is_trivial_v<T>, "only trivial types can be allocated in the arena");
+    return static_cast<T *>(allocate(iCount * sizeof(T), std::max(alignof(T), kAlignment)));
+  }
+
+  /**
+   * Allocates the channels (each one aligned) as well as the `AudioBusBuffers` describing them so that the result
+   * can be used directly with `AudioBuffers<SampleType>` (ex: `AudioBuffers32 buffers{*bus, iNumSamples}`). The
+   * samples are set to `0` and every channel is flagged as silent.
+   *
+   * @return the buffers or `nullptr` if there is not enough room left in the arena */
+  template<typename SampleType>
+  AudioBusBuffers *allocateAudioBusBuffers(int32 iNumChannels, int32 iNumSamples);
+
+  /**
+   * @return the (maximum) number of bytes used by `allocateAudioBusBuffers` for the given parameters (use it to
+   *         compute the capacity to reserve) */
+  static size_t computeAudioBusBuffersSize(int32 iNumChannels, int32 iNumSamples, size_t iSampleSize);
+
+private:
+  std::unique_ptr<char[]> fMemory{};
+  char *fAlignedMemory{};
+  size_t fCapacity{};
+  size_t fSize{};
+  size_t fHighWaterMark{};
+};
+
+//------------------------------------------------------------------------
+// RTScratchArena::allocateAudioBusBuffers
+//------------------------------------------------------------------------
+template<typename SampleType>
+AudioBusBuffers *RTScratchArena::allocateAudioBusBuffers(int32 iNumChannels, int32 iNumSamples)
+{
+  static_assert(std::is_same_v<SampleType, Sample32> || std::is_same_v<SampleType, Sample64>);
+
+  if(iNumChannels < 0 || iNumChannels > 64 || iNumSamples < 0)
+    return nullptr;
+
+  auto previousSize = fSize;
+
+  auto busMemory = allocate(sizeof(AudioBusBuffers));
+  auto channels = allocateArray<SampleType *>(static_cast<size_t>(iNumChannels));
+
+  if(!busMemory || !channels)
+  {
+    fSize = previousSize;
+    return nullptr;
+  }
+
+  for(int32 c = 0; c < iNumChannels; c++)
+  {
+    channels[c] = allocateArray<SampleType>(static_cast<size_t>(iNumSamples));
+    if(!channels[c])
+    {
+      fSize = previousSize;
+      return nullptr;
+    }
+    std::fill(channels[c], channels[c] + iNumSamples, 0);
+  }
+
+  // AudioBusBuffers is trivially destructible so it never needs to be destroyed
+  auto bus = new(busMemory) AudioBusBuffers{};
+  bus->numChannels = iNumChannels;
+  bus->silenceFlags = iNumChannels == 64 ? ~static_cast<uint64>(0) : (static_cast<uint64>(1) << iNumChannels) - 1;
+  if constexpr(std::is_same_v<SampleType, Sample32>)
+    bus->channelBuffers32 = channels;
+  else
+    bus->channelBuffers64 = channels;
+
+  return bus;
+}
+
+}
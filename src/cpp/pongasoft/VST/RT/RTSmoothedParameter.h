@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include "RTParameter.h"
+
+#include <pongasoft/VST/SampleRateBasedClock.h>
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace pongasoft::VST::RT {
+
+/**
+ * Describes how a parameter should be smoothed (see `RTState::add(VstParam<T>, RTSmoothing const &)`)
+ */
+struct RTSmoothing
+{
+  enum class Type
+  {
+    kLinear,  //!< reaches the target value in exactly `fTimeMs` (constant slope)
+    kOnePole  //!< exponential approach to the target value where `fTimeMs` is the time constant
+  };
+
+  Type fType{Type::kLinear};
+  uint32 fTimeMs{0};
+
+  //! Shortcut to create a linear smoothing
+  static constexpr RTSmoothing linear(uint32 iTimeMs) { return { Type::kLinear, iTimeMs }; }
+
+  //! Shortcut to create a one pole (exponential) smoothing
+  static constexpr RTSmoothing onePole(uint32 iTimeMs) { return { Type::kOnePole, iTimeMs }; }
+};
+
+/**
+ * Implemented by all smoothed parameters so that `RTState` can propagate the sample rate (which is only known
+ * in `setupProcessing`).
+ */
+class IRTSmoothedParameter
+{
+public:
+  virtual ~IRTSmoothedParameter() = default;
+
+  //! Called (outside the RT thread) when the sample rate changes: recomputes the smoothing coefficients
+  virtual void setSampleRate(SampleRate iSampleRate) = 0;
+
+  //! Jumps to the target value (no more smoothing)
+  virtual void snapToTarget() = 0;
+};
+
+/**
+ * A parameter whose (denormalized) value is smoothed over time: `getValue()` is always the target value (the one
+ * set by the host or the plugin) whereas `getSmoothedValue()` ramps toward it as samples are consumed (see
+ * `nextSmoothedValue`, `advance` and `fillRamp`). The state of the ramp is only modified when samples are
+ * consumed, so it is up to the plugin to consume exactly `numSamples` samples per frame (or sub-block).
+ *
+ * @tparam T the underlying type of the param which must be a floating point type */
+template<typename T>
+class RTSmoothedVstParameter : public RTVstParameter<T>, public IRTSmoothedParameter
+{
+  static_assert(std::is_floating_point_v<T>, "Smoothing is only supported for floating point parameters");
+
+public:
+  using ParamType = T;
+
+  // Constructor
+  RTSmoothedVstParameter(VstParam<T> iParamDef, RTSmoothing const &iSmoothing) :
+    RTVstParameter<T>(std::move(iParamDef)),
+    fSmoothing{iSmoothing},
+    fSmoothedValue{this->fValue}
+  {
+  }
+
+  // getSmoothing
+  inline RTSmoothing const &getSmoothing() const { return fSmoothing; }
+
+  //! @return the current smoothed value (the target value is `getValue()`)
+  inline ParamType getSmoothedValue() const { return fSmoothedValue; }
+
+  //! @return true if the smoothed value has not reached the target value yet
+  inline bool isSmoothing() const { return fRemainingSamples > 0; }
+
+  //! Sets the smoothing coefficients according to the sample rate
+  void setSampleRate(SampleRate iSampleRate) override;
+
+  //! Jumps to the target value (no more smoothing)
+  void snapToTarget() override { fSmoothedValue = this->fValue; fRemainingSamples = 0; }
+
+  //! Consumes one sample and returns the smoothed value for this sample
+  inline ParamType nextSmoothedValue()
+  {
+    if(fRemainingSamples > 0)
+      advanceOne();
+    return fSmoothedValue;
+  }
+
+  /**
+   * Consumes `iNumSamples` samples (without producing them) and returns the smoothed value after doing so. `advance`,
+   * `fillRamp` and `applyRamp` end up with the exact same value (and so does `nextSmoothedValue` for the one pole
+   * smoothing since the same recurrence is used instead of a closed form). */
+  ParamType advance(int32 iNumSamples);
+
+  /**
+   * Consumes `iNumSamples` samples and writes the smoothed value of each of them into `oBuffer`. The inner loops
+   * have no branches (and no dependency between iterations for the linear case) so that they can be vectorized by
+   * the compiler.
+   *
+   * @return the smoothed value after the last sample */
+  template<typename SampleType>
+  ParamType fillRamp(SampleType *oBuffer, int32 iNumSamples);
+
+  /**
+   * Consumes `iNumSamples` samples and multiplies `ioBuffer` (in place) by the smoothed value of each sample (the
+   * typical use case being a smoothed gain). The values are the same as the ones written by `fillRamp`.
+   *
+   * @return the smoothed value after the last sample */
+  template<typename SampleType>
+  ParamType applyRamp(SampleType *ioBuffer, int32 iNumSamples);
+
+  // Override to start a new ramp toward the new value
+  void update(ParamType const &iNewValue) override;
+
+protected:
+  // Override to start a new ramp toward the new value
+  bool updateNormalizedValue(ParamValue iNormalizedValue) override;
+
+  // starts a new ramp toward fValue
+  void startRamp();
+
+  // ends a ramp of iNumSamples (<= fRemainingSamples) samples whose last value is iValue (snaps at the end)
+  inline void endRamp(ParamType iValue, int32 iNumSamples)
+  {
+    fRemainingSamples -= iNumSamples;
+    fSmoothedValue = fRemainingSamples == 0 ? this->fValue : iValue;
+  }
+
+  // advances one sample (fRemainingSamples > 0)
+  inline void advanceOne()
+  {
+    if(fSmoothing.fType == RTSmoothing::Type::kLinear)
+      fSmoothedValue += fStep;
+    else
+      fSmoothedValue = this->fValue + (fSmoothedValue - this->fValue) * fCoefficient;
+
+    if(--fRemainingSamples == 0)
+      fSmoothedValue = this->fValue;
+  }
+
+private:
+  RTSmoothing fSmoothing;
+
+  // number of samples for a ramp (linear) or to consider the target reached (one pole)
+  int32 fRampSampleCount{0};
+
+  // one pole coefficient (0 means jump)
+  ParamType fCoefficient{0};
+
+  ParamType fSmoothedValue;
+  ParamType fStep{0};
+  int32 fRemainingSamples{0};
+};
+
+//------------------------------------------------------------------------
+// RTSmoothedVstParameter::setSampleRate
+//------------------------------------------------------------------------
+template<typename T>
+void RTSmoothedVstParameter<T>::setSampleRate(SampleRate iSampleRate)
+{
+  SampleRateBasedClock clock{iSampleRate};
+
+  auto sampleCount = static_cast<int32>(clock.getSampleCountFor(fSmoothing.fTimeMs));
+
+  if(fSmoothing.fType == RTSmoothing::Type::kLinear)
+  {
+    fRampSampleCount = sampleCount;
+  }
+  else
+  {
+    // coefficient for a time constant of sampleCount samples; after 5 time constants the value is within 1% of
+    // the target so we stop there (and jump to the target) so that the ramp always ends
+    fCoefficient = sampleCount > 0 ? static_cast<ParamType>(std::exp(-1.0 / sampleCount)) : 0;
+    fRampSampleCount = sampleCount * 5;
+  }
+
+  snapToTarget();
+}
+
+//------------------------------------------------------------------------
+// RTSmoothedVstParameter::startRamp
+//------------------------------------------------------------------------
+template<typename T>
+void RTSmoothedVstParameter<T>::startRamp()
+{
+  if(fRampSampleCount <= 0)
+  {
+    snapToTarget();
+    return;
+  }
+
+  fRemainingSamples = fRampSampleCount;
+  fStep = (this->fValue - fSmoothedValue) / static_cast<ParamType>(fRampSampleCount);
+}
+
+//------------------------------------------------------------------------
+// RTSmoothedVstParameter::updateNormalizedValue
+//------------------------------------------------------------------------
+template<typename T>
+bool RTSmoothedVstParameter<T>::updateNormalizedValue(ParamValue iNormalizedValue)
+{
+  if(RTVstParameter<T>::updateNormalizedValue(iNormalizedValue))
+  {
+    startRamp();
+    return true;
+  }
+
+  return false;
+}
+
+//------------------------------------------------------------------------
+// RTSmoothedVstParameter::update
+//------------------------------------------------------------------------
+template<typename T>
+void RTSmoothedVstParameter<T>::update(ParamType const &iNewValue)
+{
+  auto changed = iNewValue != this->fValue;
+  RTVstParameter<T>::update(iNewValue);
+  if(changed)
+    startRamp();
+}
+
+//------------------------------------------------------------------------
+// RTSmoothedVstParameter::advance
+//------------------------------------------------------------------------
+template<typename T>
+T RTSmoothedVstParameter<T>::advance(int32 iNumSamples)
+{
+  if(fRemainingSamples <= 0 || iNumSamples <= 0)
+    return fSmoothedValue;
+
+  if(iNumSamples >= fRemainingSamples)
+  {
+    snapToTarget();
+    return fSmoothedValue;
+  }
+
+  auto value = fSmoothedValue;
+
+  if(fSmoothing.fType == RTSmoothing::Type::kLinear)
+    value += fStep * static_cast<ParamType>(iNumSamples);
+  else
+  {
+    // same recurrence as fillRamp (rather than a closed form) so that the values are identical
+    auto const target = this->fValue;
+    auto const coefficient = fCoefficient;
+    for(int32 i = 0; i < iNumSamples; i++)
+      value = target + (value - target) * coefficient;
+  }
+
+  endRamp(value, iNumSamples);
+
+  return fSmoothedValue;
+}
+
+//------------------------------------------------------------------------
+// RTSmoothedVstParameter::fillRamp
+//------------------------------------------------------------------------
+template<typename T>
+template<typename SampleType>
+T RTSmoothedVstParameter<T>::fillRamp(SampleType *oBuffer, int32 iNumSamples)
+{
+  if(iNumSamples <= 0)
+    return fSmoothedValue;
+
+  auto rampSamples = std::min(fRemainingSamples, iNumSamples);
+
+  if(rampSamples > 0)
+  {
+    auto const start = fSmoothedValue;
+    auto const target = this->fValue;
+
+    auto value = start;
+
+    if(fSmoothing.fType == RTSmoothing::Type::kLinear)
+    {
+      auto const step = fStep;
+      for(int32 i = 0; i < rampSamples; i++)
+        oBuffer[i] = static_cast<SampleType>(start + step * static_cast<ParamType>(i + 1));
+      value = start + step * static_cast<ParamType>(rampSamples);
+    }
+    else
+    {
+      auto const coefficient = fCoefficient;
+      for(int32 i = 0; i < rampSamples; i++)
+      {
+        value = target + (value - target) * coefficient;
+        oBuffer[i] = static_cast<SampleType>(value);
+      }
+    }
+
+    // the state continues from the last value written (snaps at the end of the ramp)
+    endRamp(value, rampSamples);
+
+    if(fRemainingSamples == 0)
+      oBuffer[rampSamples - 1] = static_cast<SampleType>(fSmoothedValue);
+  }
+
+  std::fill(oBuffer + rampSamples, oBuffer + iNumSamples, static_cast<SampleType>(fSmoothedValue));
+
+  return fSmoothedValue;
+}
+
+//------------------------------------------------------------------------
+// RTSmoothedVstParameter::applyRamp
+//------------------------------------------------------------------------
+template<typename T>
+template<typename SampleType>
+T RTSmoothedVstParameter<T>::applyRamp(SampleType *ioBuffer, int32 iNumSamples)
+{
+  if(iNumSamples <= 0)
+    return fSmoothedValue;
+
+  auto rampSamples = std::min(fRemainingSamples, iNumSamples);
+
+  if(rampSamples > 0)
+  {
+    auto const start = fSmoothedValue;
+    auto const target = this->fValue;
+
+    auto value = start;
+
+    // same values as fillRamp: the last sample of a ramp ending in this block is the target
+    auto const endsRamp = rampSamples == fRemainingSamples;
+    auto const numComputedSamples = endsRamp ? rampSamples - 1 : rampSamples;
+
+    if(fSmoothing.fType == RTSmoothing::Type::kLinear)
+    {
+      auto const step = fStep;
+      for(int32 i = 0; i < numComputedSamples; i++)
+        ioBuffer[i] *= static_cast<SampleType>(start + step * static_cast<ParamType>(i + 1));
+      value = start + step * static_cast<ParamType>(rampSamples);
+    }
+    else
+    {
+      auto const coefficient = fCoefficient;
+      for(int32 i = 0; i < numComputedSamples; i++)
+      {
+        value = target + (value - target) * coefficient;
+        ioBuffer[i] *= static_cast<SampleType>(value);
+      }
+    }
+
+    if(endsRamp)
+      ioBuffer[rampSamples - 1] *= static_cast<SampleType>(target);
+
+    endRamp(value, rampSamples);
+  }
+
+  auto const value = static_cast<SampleType>(fSmoothedValue);
+  if(value != 1)
+  {
+    for(int32 i = rampSamples; i < iNumSamples; i++)
+      ioBuffer[i] *= value;
+  }
+
+  return fSmoothedValue;
+}
+
+//------------------------------------------------------------------------
+// RTSmoothedVstParam - wrapper to make writing the code much simpler and natural
+//------------------------------------------------------------------------
+/**
+ * This is the class that the plugin should use for smoothed parameters: it behaves exactly like `RTVstParam<T>`
+ * (`*param` or `param.value()` being the target value) and adds access to the smoothed value.
+ *
+ * Typical usage:
+ *
+ *     // in the state
+ *     fGain{add(iParams.fGain, RTSmoothing::linear(20))}
+ *
+ *     // in process (per sample)
+ *     for(int32 i = 0; i < numSamples; i++)
+ *       out[i] = in[i] * fState.fGain.nextSmoothedValue();
+ *
+ *     // or in process (per block)
+ *     fState.fGain.fillRamp(fGainBuffer.data(), numSamples);
+ *
+ * @tparam T the underlying type of the param (must be a floating point type) */
+template<typename T>
+class RTSmoothedVstParam : public RTVstParam<T>
+{
+  using ParamType = T;
+
+public:
+  RTSmoothedVstParam(RTSmoothedVstParameter<T> *iPtr) : RTVstParam<T>(iPtr), fSmoothedPtr{iPtr} {} // NOLINT (not marked explicit on purpose)
+
+  //! Allow to write param = 3.0
+  using RTVstParam<T>::operator=;
+
+  //! @return the current smoothed value
+  inline ParamType smoothedValue() const { return fSmoothedPtr->getSmoothedValue(); }
+
+  //! @return true if the smoothed value has not reached the target value yet
+  inline bool isSmoothing() const { return fSmoothedPtr->isSmoothing(); }
+
+  //! Consumes one sample and returns the smoothed value for this sample
+  inline ParamType nextSmoothedValue() { return fSmoothedPtr->nextSmoothedValue(); }
+
+  //! Consumes `iNumSamples` samples and returns the smoothed value after doing so (per sub-block smoothing)
+  inline ParamType advance(int32 iNumSamples) { return fSmoothedPtr->advance(iNumSamples); }
+
+  //! Consumes `iNumSamples` samples and writes the smoothed value of each of them into `oBuffer`
+  template<typename SampleType>
+  inline ParamType fillRamp(SampleType *oBuffer, int32 iNumSamples) { return fSmoothedPtr->fillRamp(oBuffer, iNumSamples); }
+
+  //! Consumes `iNumSamples` samples and multiplies `ioBuffer` by the smoothed value of each of them
+  template<typename SampleType>
+  inline ParamType applyRamp(SampleType *ioBuffer, int32 iNumSamples) { return fSmoothedPtr->applyRamp(ioBuffer, iNumSamples); }
+
+  //! Jumps to the target value (no more smoothing)
+  inline void snapToTarget() { fSmoothedPtr->snapToTarget(); }
+
+private:
+  RTSmoothedVstParameter<T> *fSmoothedPtr;
+};
+
+}
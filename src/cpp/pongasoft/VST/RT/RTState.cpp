@@ -17,6 +17,8 @@
  */
 #include "RTState.h"
 
+#include <algorithm>
+
 namespace pongasoft::VST::RT {
 
 //------------------------------------------------------------------------
@@ -25,7 +27,8 @@ namespace pongasoft::VST::RT {
 RTState::RTState(Parameters const &iParameters) :
   fPluginParameters{iParameters},
   fStateUpdate{iParameters.newRTState(), true},
-  fLatestState{iParameters.newRTState()}
+  fLatestState{iParameters.newRTState()},
+  fLatestStateRT{iParameters.newRTState()}
 {
 }
 
@@ -68,6 +71,19 @@ tresult RTState::addRawParameter(std::unique_ptr<RTRawVstParameter> iParameter)
     return kInvalidArgument;
   }
 
+  if(isSampleAccurateAutomationEnabled())
+  {
+    iParameter->enableAutomationPoints(fMaxAutomationPointsPerBlock);
+    fAutomatedParameters.reserve(fVstParameters.size() + 1);
+  }
+
+  auto slot = getVstParameterCount();
+  fVstParameterTable.emplace_back(iParameter.get());
+  fVstParameterIndexBuilt = false;
+
+  fDirtyParameters.resize(slot + 1);
+  iParameter->trackChanges(&fDirtyParameters, slot);
+
   fVstParameters[paramID] = std::move(iParameter);
   fAllRegistrationOrder.emplace_back(paramID);
 
@@ -103,6 +119,8 @@ tresult RTState::addOutboundMessagingParameter(std::unique_ptr<IRTJmbOutParamete
     return kInvalidArgument;
   }
 
+  fOutboundMessagingTable.emplace_back(iParameter.get());
+  fOutboundMessages.emplace_back();
   fOutboundMessagingParameters[paramID] = std::move(iParameter);
   fAllRegistrationOrder.emplace_back(paramID);
 
@@ -168,10 +186,13 @@ bool RTState::applyParameterChanges(IParameterChanges &inputParameterChanges)
       // we read the "last" point (ignoring multiple changes for now)
       if(paramQueue->getPoint(numPoints - 1, sampleOffset, value) == kResultOk)
       {
-        auto item = fVstParameters.find(paramQueue->getParameterId());
-        if(item != fVstParameters.cend())
+        auto param = findVstParameter(paramQueue->getParameterId());
+        if(param)
         {
-          stateChanged |= item->second->updateNormalizedValue(value);
+          if(isSampleAccurateAutomationEnabled())
+            addAutomationPoints(param, *paramQueue);
+
+          stateChanged |= param->updateNormalizedValue(value);
         }
       }
     }
@@ -180,6 +201,177 @@ bool RTState::applyParameterChanges(IParameterChanges &inputParameterChanges)
   return stateChanged;
 }
 
+//------------------------------------------------------------------------
+// RTState::enableSampleAccurateAutomation
+//------------------------------------------------------------------------
+void RTState::enableSampleAccurateAutomation(int32 iMaxPointsPerBlock)
+{
+  DCHECK_F(iMaxPointsPerBlock > 0);
+
+  fMaxAutomationPointsPerBlock = std::max(iMaxPointsPerBlock, 1);
+
+  for(auto param : fVstParameterTable)
+    param->enableAutomationPoints(fMaxAutomationPointsPerBlock);
+
+  // reserving so that adding to the vector in the RT thread never allocates
+  fAutomatedParameters.clear();
+  fAutomatedParameters.reserve(fVstParameterTable.size());
+}
+
+//------------------------------------------------------------------------
+// RTState::addAutomationPoints
+//------------------------------------------------------------------------
+void RTState::addAutomationPoints(RTRawVstParameter *iParameter, IParamValueQueue &iParamQueue)
+{
+  // the same parameter should not appear twice in a frame but if it does, we keep the first set of points
+  if(iParameter->getAutomationPointCount() > 0)
+    return;
+
+  // sanity check (should not happen since capacity was reserved for all parameters)
+  if(fAutomatedParameters.size() == fAutomatedParameters.capacity())
+    return;
+
+  iParameter->beginAutomationPoints();
+
+  int32 numPoints = iParamQueue.getPointCount();
+  for(int32 i = 0; i < numPoints; i++)
+  {
+    ParamValue value;
+    int32 sampleOffset;
+    if(iParamQueue.getPoint(i, sampleOffset, value) == kResultOk)
+      iParameter->addAutomationPoint(sampleOffset, value);
+  }
+
+  if(iParameter->getAutomationPointCount() > 0)
+    fAutomatedParameters.emplace_back(iParameter);
+}
+
+//------------------------------------------------------------------------
+// RTState::rewindAutomation
+//------------------------------------------------------------------------
+void RTState::rewindAutomation()
+{
+  for(auto param : fAutomatedParameters)
+    param->rewindAutomation();
+}
+
+//------------------------------------------------------------------------
+// RTState::advanceAutomation
+//------------------------------------------------------------------------
+bool RTState::advanceAutomation(int32 iSampleOffset)
+{
+  bool stateChanged = false;
+
+  for(auto param : fAutomatedParameters)
+    stateChanged |= param->advanceAutomation(iSampleOffset);
+
+  return stateChanged;
+}
+
+//------------------------------------------------------------------------
+// RTState::getNextAutomationSampleOffset
+//------------------------------------------------------------------------
+int32 RTState::getNextAutomationSampleOffset(int32 iSampleOffset, int32 iNumSamples) const
+{
+  int32 res = iNumSamples;
+
+  for(auto param : fAutomatedParameters)
+  {
+    auto offset = param->getNextAutomationSampleOffset(iSampleOffset);
+    if(offset >= 0 && offset < res)
+      res = offset;
+  }
+
+  return res;
+}
+
+//------------------------------------------------------------------------
+// RTState::clearAutomationPoints
+//------------------------------------------------------------------------
+void RTState::clearAutomationPoints()
+{
+  for(auto param : fAutomatedParameters)
+    param->clearAutomationPoints();
+
+  fAutomatedParameters.clear();
+}
+
+//------------------------------------------------------------------------
+// RTState::findVstParameterSlot
+//------------------------------------------------------------------------
+int32 RTState::findVstParameterSlot(ParamID iParamID) const
+{
+  if(fVstParameterIndexBuilt)
+  {
+    if(!fVstParameterDenseIndex.empty())
+      return iParamID < fVstParameterDenseIndex.size() ? fVstParameterDenseIndex[iParamID] : -1;
+
+    auto iter = std::lower_bound(fVstParameterSparseIndex.cbegin(),
+                                 fVstParameterSparseIndex.cend(),
+                                 iParamID,
+                                 [](auto const &iEntry, ParamID iID) { return iEntry.first < iID; });
+
+    return (iter != fVstParameterSparseIndex.cend() && iter->first == iParamID) ? iter->second : -1;
+  }
+
+  // index not built yet (init not called) => linear search
+  for(int32 slot = 0; slot < getVstParameterCount(); slot++)
+  {
+    if(fVstParameterTable[slot]->getParamID() == iParamID)
+      return slot;
+  }
+
+  return -1;
+}
+
+//------------------------------------------------------------------------
+// RTState::buildParameterIndex
+//------------------------------------------------------------------------
+void RTState::buildParameterIndex()
+{
+  // the dense index wastes at most a few int32 per parameter when ParamIDs are not contiguous
+  constexpr ParamID kMinDenseIndexSize = 1024;
+  constexpr ParamID kMaxDenseIndexRatio = 8;
+
+  auto count = getVstParameterCount();
+
+  ParamID maxParamID = 0;
+  for(auto param : fVstParameterTable)
+    maxParamID = std::max(maxParamID, param->getParamID());
+
+  fVstParameterDenseIndex.clear();
+  fVstParameterSparseIndex.clear();
+
+  if(count > 0 && maxParamID < std::max(kMinDenseIndexSize, kMaxDenseIndexRatio * static_cast<ParamID>(count)))
+  {
+    fVstParameterDenseIndex.resize(maxParamID + 1, -1);
+    for(int32 slot = 0; slot < count; slot++)
+      fVstParameterDenseIndex[fVstParameterTable[slot]->getParamID()] = slot;
+  }
+  else
+  {
+    fVstParameterSparseIndex.reserve(count);
+    for(int32 slot = 0; slot < count; slot++)
+      fVstParameterSparseIndex.emplace_back(fVstParameterTable[slot]->getParamID(), slot);
+    std::sort(fVstParameterSparseIndex.begin(), fVstParameterSparseIndex.end());
+  }
+
+  fVstParameterIndexBuilt = true;
+
+  // save order -> slot
+  auto const &saveOrder = fPluginParameters.getRTSaveStateOrder();
+  fSaveStateSlots.clear();
+  fSaveStateSlots.reserve(saveOrder.getCount());
+  fSlotSaveStateIndices.assign(count, -1);
+  for(int i = 0; i < saveOrder.getCount(); i++)
+  {
+    auto slot = findVstParameterSlot(saveOrder.fOrder[i]);
+    fSaveStateSlots.emplace_back(slot);
+    if(slot >= 0)
+      fSlotSaveStateIndices[slot] = i;
+  }
+}
+
 //------------------------------------------------------------------------
 // RTState::getParamUpdateSampleOffset
 //------------------------------------------------------------------------
@@ -223,6 +415,27 @@ void RTState::computeLatestState(NormalizedState *oLatestState) const
 {
   auto const &saveOrder = oLatestState->fSaveOrder;
 
+  // fast path: only the parameters modified during the frame need to be rewritten (fLatestStateRT always
+  // contains the values computed at the end of the previous frame)
+  if(oLatestState == fLatestStateRT.get() && fSlotSaveStateIndices.size() == fVstParameterTable.size())
+  {
+    for(auto slot : fDirtyParameters.getSlots())
+    {
+      auto idx = fSlotSaveStateIndices[slot];
+      if(idx >= 0)
+        oLatestState->set(idx, fVstParameterTable[slot]->getNormalizedValue());
+    }
+    return;
+  }
+
+  // same save order as the one used to build the slots
+  if(saveOrder == &fPluginParameters.getRTSaveStateOrder() && fSaveStateSlots.size() == saveOrder->fOrder.size())
+  {
+    for(int i = 0; i < oLatestState->getCount(); i++)
+      oLatestState->set(i, fVstParameterTable[fSaveStateSlots[i]]->getNormalizedValue());
+    return;
+  }
+
   for(int i = 0; i < oLatestState->getCount(); i++)
   {
     auto paramID = saveOrder->fOrder[i];
@@ -235,9 +448,8 @@ void RTState::computeLatestState(NormalizedState *oLatestState) const
 //------------------------------------------------------------------------
 void RTState::computeLatestState()
 {
-  fLatestState.update([this](auto iNormalizedStateRT) {
-    this->computeLatestState(iNormalizedStateRT);
-  });
+  computeLatestState(fLatestStateRT.get());
+  fLatestState.set(fLatestStateRT.get());
 }
 
 //------------------------------------------------------------------------
@@ -268,6 +480,15 @@ tresult RTState::writeLatestState(IBStreamer &oStreamer)
   return fPluginParameters.writeRTState(normalizedState, oStreamer);
 }
 
+//------------------------------------------------------------------------
+// RTState::setSampleRate
+//------------------------------------------------------------------------
+void RTState::setSampleRate(SampleRate iSampleRate)
+{
+  for(auto param : fSmoothedParameters)
+    param->setSampleRate(iSampleRate);
+}
+
 //------------------------------------------------------------------------
 // RTState::beforeProcessing
 //------------------------------------------------------------------------
@@ -293,6 +514,14 @@ bool RTState::onNewState(NormalizedState const *iLatestState)
 
   bool res = false;
 
+  // fast path: same save order as the one used to build the slots
+  if(saveOrder == &fPluginParameters.getRTSaveStateOrder() && fSaveStateSlots.size() == saveOrder->fOrder.size())
+  {
+    for(int i = 0; i < iLatestState->getCount(); i ++)
+      res |= fVstParameterTable[fSaveStateSlots[i]]->updateNormalizedValue(iLatestState->fValues[i]);
+    return res;
+  }
+
   for(int i = 0; i < iLatestState->getCount(); i ++)
   {
     res |= fVstParameters.at(saveOrder->fOrder[i])->updateNormalizedValue(iLatestState->fValues[i]);
@@ -306,11 +535,17 @@ bool RTState::onNewState(NormalizedState const *iLatestState)
 //------------------------------------------------------------------------
 void RTState::afterProcessing()
 {
+  // automation points are only valid for the duration of the frame
+  if(hasAutomationPoints())
+    clearAutomationPoints();
+
   // when the state has changed we update latest state for writeLatestState
   if(resetPreviousValues())
   {
     computeLatestState();
   }
+
+  fDirtyParameters.clear();
 }
 
 //------------------------------------------------------------------------
@@ -319,9 +554,9 @@ void RTState::afterProcessing()
 bool RTState::resetPreviousValues()
 {
   bool stateChanged = false;
-  for(auto &iter : fVstParameters)
+  for(auto slot : fDirtyParameters.getSlots())
   {
-    stateChanged |= iter.second->resetPreviousValue();
+    stateChanged |= fVstParameterTable[slot]->resetPreviousValue();
   }
 
   return stateChanged;
@@ -332,28 +567,28 @@ bool RTState::resetPreviousValues()
 //------------------------------------------------------------------------
 tresult RTState::sendPendingMessages(IMessageProducer *iMessageProducer)
 {
+  if(fMessageBatching)
+    return sendPendingMessagesAsBatch(iMessageProducer);
+
   tresult res = kResultOk;
 
-  for(auto &p : fOutboundMessagingParameters)
+  for(size_t i = 0; i < fOutboundMessagingTable.size(); i++)
   {
-    std::unique_ptr<IRTJmbOutParameter> &param = p.second;
-    if(param->hasUpdate())
-    {
-      auto message = iMessageProducer->allocateMessage();
+    auto param = fOutboundMessagingTable[i];
+    auto &message = fOutboundMessages[i];
 
-      if(message)
-      {
-        Message m{message.get()};
+    // one message per update (only the updates available at this time to avoid looping forever)
+    for(auto count = param->getUpdateCount(); count > 0; count--)
+    {
+      // reuses the message sent during the previous tick if possible
+      Message m{iMessageProducer->recycleMessage(message)};
 
-        // sets the message ID
-        m.setMessageID(param->getParamID());
+      // sets the message ID
+      m.setMessageID(param->getParamID());
 
-        // serialize the content
-        if(param->writeToMessage(m) == kResultOk)
-          res |= iMessageProducer->sendMessage(message);
-        else
-          res = kResultFalse;
-      }
+      // serialize the content
+      if(param->writeToMessage(m) == kResultOk)
+        res |= iMessageProducer->sendMessage(IPtr<IMessage>{message.get()});
       else
         res = kResultFalse;
     }
@@ -362,6 +597,36 @@ tresult RTState::sendPendingMessages(IMessageProducer *iMessageProducer)
   return res;
 }
 
+//------------------------------------------------------------------------
+// RTState::sendPendingMessagesAsBatch
+//------------------------------------------------------------------------
+tresult RTState::sendPendingMessagesAsBatch(IMessageProducer *iMessageProducer)
+{
+  tresult res = kResultOk;
+
+  fMessageBatch.clear();
+
+  for(auto param : fOutboundMessagingTable)
+  {
+    // only the updates available at this time to avoid looping forever
+    for(auto count = param->getUpdateCount(); count > 0; count--)
+      res |= param->writeToBatch(fMessageBatch);
+  }
+
+  if(fMessageBatch.isEmpty())
+    return res;
+
+  // reuses the message sent during the previous tick if possible
+  Message m{iMessageProducer->recycleMessage(fMessageBatchMessage)};
+
+  if(fMessageBatch.writeToMessage(m) == kResultOk)
+    res |= iMessageProducer->sendMessage(IPtr<IMessage>{fMessageBatchMessage.get()});
+  else
+    res = kResultFalse;
+
+  return res;
+}
+
 //------------------------------------------------------------------------
 // RTState::handleMessage
 //------------------------------------------------------------------------
@@ -405,6 +670,13 @@ tresult RTState::init()
 
   if(result == kResultOk)
   {
+    // freezes the parameter table
+    buildParameterIndex();
+
+    // all values are considered modified so that the latest state is fully computed
+    for(int32 slot = 0; slot < getVstParameterCount(); slot++)
+      fDirtyParameters.mark(slot);
+
     computeLatestState();
   }
 
@@ -23,6 +23,7 @@
 #include <pongasoft/VST/MessageProducer.h>
 
 #include "RTParameter.h"
+#include "RTSmoothedParameter.h"
 #include "RTJmbOutParameter.h"
 #include "RTJmbInParameter.h"
 
@@ -58,22 +59,59 @@ public:
   template<typename T>
   RTVstParam<T> add(VstParam<T> iParamDef);
 
+  /**
+   * Same as `add(VstParam<T>)` for a parameter whose converter type is known at compile time (see
+   * `Parameters::VstParamDefBuilder::add<ParamConverter>()`): the values are converted without virtual calls. The
+   * result can be stored in a `RTVstParam<T>` but only `RTVstParam<T, Converter>` keeps `normalize` / `denormalize`
+   * non virtual. */
+  template<typename T, typename Converter>
+  RTVstParam<T, Converter> add(TVstParam<T, Converter> iParamDef);
+
+  /**
+   * Same as `add(VstParam<T>)` but the parameter is smoothed (ramps toward the value set by the host or the plugin)
+   * according to `iSmoothing` (ex: `add(iParams.fGain, RTSmoothing::linear(20))`). T must be a floating point type.
+   */
+  template<typename T>
+  RTSmoothedVstParam<T> add(VstParam<T> iParamDef, RTSmoothing const &iSmoothing);
+
   /**
    * This method should be called to add an rt outbound jmb parameter
    */
   template<typename T>
   RTJmbOutParam<T> addJmbOut(JmbParam<T> iParamDef);
 
+  /**
+   * Same as `addJmbOut(JmbParam<T>)` but the parameter is backed by a bounded queue of (at least) `iQueueCapacity`
+   * elements, so that every value broadcast is delivered (in order) instead of only the latest one. Use it when
+   * every value matters (ex: a stream of events) and size the queue to hold what the RT code can produce between 2
+   * GUI timer ticks (values broadcast while the queue is full are dropped).
+   */
+  template<typename T>
+  RTJmbOutParam<T> addJmbOut(JmbParam<T> iParamDef, size_t iQueueCapacity);
+
   /**
    * This method should be called to add an rt inbound jmb parameter
    */
   template<typename T>
   RTJmbInParam<T> addJmbIn(JmbParam<T> iParamDef);
 
+  /**
+   * Same as `addJmbIn(JmbParam<T>)` but the messages for this parameter can safely be received from more than one
+   * thread (up to `iMaxProducers` at the exact same time) without locking the RT thread (see
+   * `Concurrent::LockFree::MPSCSingleElementQueue`).
+   */
+  template<typename T>
+  RTJmbInParam<T> addJmbIn(JmbParam<T> iParamDef, size_t iMaxProducers);
+
   /**
    * Call this method after adding all the parameters. If using the RT processor, it will happen automatically. */
   virtual tresult init();
 
+  /**
+   * Called when the sample rate changes (from `RTProcessor::setupProcessing`, so NOT from the RT thread) to
+   * recompute the smoothing coefficients of the smoothed parameters. */
+  virtual void setSampleRate(SampleRate iSampleRate);
+
   /**
    * This method should be call at the beginning of the process(ProcessData &data) method before doing anything else.
    * The goal of this method is to update the current state with a state set by the UI (typical use case is to
@@ -96,6 +134,46 @@ public:
    */
   virtual int32 getParamUpdateSampleOffset(ProcessData &iData, ParamID iParamID) const;
 
+  /**
+   * By default, when a parameter changes more than once in a frame, only the last value is taken into account
+   * (see `applyParameterChanges`). Calling this method enables sample accurate automation: every automation point
+   * sent by the host is recorded (see `RTVstParam::getAutomationPoint`) and the frame can then be processed in
+   * sub-blocks (see `RTProcessor::enableSampleAccurateAutomation` which does it for you).
+   *
+   * This method allocates memory and must NOT be called from the RT thread. It should be called after all
+   * parameters have been added (for example from `RTProcessor::initialize`).
+   *
+   * @param iMaxPointsPerBlock the maximum number of automation points recorded per parameter per frame (extra points
+   *                           get merged into the last one)
+   */
+  void enableSampleAccurateAutomation(int32 iMaxPointsPerBlock);
+
+  //! @return true if `enableSampleAccurateAutomation` has been called
+  inline bool isSampleAccurateAutomationEnabled() const { return fMaxAutomationPointsPerBlock > 0; }
+
+  //! @return true if at least one parameter received automation points during this frame
+  inline bool hasAutomationPoints() const { return !fAutomatedParameters.empty(); }
+
+  //! @return the number of registered vst parameters (which is also the number of slots)
+  inline int32 getVstParameterCount() const { return static_cast<int32>(fVstParameterTable.size()); }
+
+  /**
+   * Resets every automated parameter to the value it had at the beginning of the frame (meaning before
+   * `applyParameterChanges` was called). Called from the RT thread before processing the first sub-block. */
+  virtual void rewindAutomation();
+
+  /**
+   * Applies all automation points with a sample offset `<= iSampleOffset`. Called from the RT thread before
+   * processing the sub-block starting at `iSampleOffset`.
+   *
+   * @return true if the state of the plugin changed */
+  virtual bool advanceAutomation(int32 iSampleOffset);
+
+  /**
+   * @return the sample offset (strictly greater than `iSampleOffset`) at which the next automation point happens
+   *         across all parameters or `iNumSamples` if there is none */
+  int32 getNextAutomationSampleOffset(int32 iSampleOffset, int32 iNumSamples) const;
+
   /**
    * This method should be called at the end of process(ProcessData &data) method. It will update the previous state
    * to the current one and save the latest changes (if necessary) so that it is accessible via writeLatestState.
@@ -122,6 +200,17 @@ public:
    * Called (from a GUI timer) to send the messages to the GUI (JmbParam for the moment) */
   virtual tresult sendPendingMessages(IMessageProducer *iMessageProducer);
 
+  /**
+   * Call this method to enable message batching: instead of sending one message per update, all the updates pending
+   * when the GUI timer fires are packed into a single message (see `MessageBatchWriter`), so the cost of
+   * `sendMessage` (which varies widely from one host to another) becomes constant. The GUI side demultiplexes
+   * the batch transparently. Should be called in the constructor (or `RTProcessor::initialize`).
+   */
+  void enableMessageBatching(bool iEnable = true) { fMessageBatching = iEnable; }
+
+  // isMessageBatchingEnabled
+  bool isMessageBatchingEnabled() const { return fMessageBatching; }
+
   /**
    * Called by the UI thread (from RTProcessor) to handle messages.
    */
@@ -137,7 +226,8 @@ protected:
   // the parameters
   Parameters const &fPluginParameters;
 
-  // contains all the registered vst parameters (unique ID, will be checked on add)
+  // contains all the registered vst parameters (unique ID, will be checked on add). Note that this map owns the
+  // parameters but is not used in the RT code path (see fVstParameterTable)
   std::map<ParamID, std::unique_ptr<RTRawVstParameter>> fVstParameters{};
 
   // contains all the registered outbound message parameters (unique ID, will be checked on add)
@@ -159,9 +249,32 @@ protected:
   // add outbound messaging parameter
   tresult addOutboundMessagingParameter(std::unique_ptr<IRTJmbOutParameter> iParameter);
 
+  // sendPendingMessagesAsBatch (when message batching is enabled)
+  tresult sendPendingMessagesAsBatch(IMessageProducer *iMessageProducer);
+
   // add inbound messaging parameter
   tresult addInboundMessagingParameter(std::unique_ptr<IRTJmbInParameter> iParameter);
 
+  // records all the automation points of the queue for the parameter (sample accurate automation only)
+  void addAutomationPoints(RTRawVstParameter *iParameter, IParamValueQueue &iParamQueue);
+
+  // clears the automation points recorded during the frame
+  void clearAutomationPoints();
+
+  /**
+   * @return the slot (index in the flat parameter table) of the vst parameter or `-1` if there is no such
+   *         parameter. Lookup is O(1) (or O(log n) for very sparse ParamIDs) once `init` has been called. */
+  int32 findVstParameterSlot(ParamID iParamID) const;
+
+  /**
+   * @return the vst parameter for the given id or `nullptr` if there is no such parameter. Does not allocate and
+   *         is safe to call from the RT thread */
+  inline RTRawVstParameter *findVstParameter(ParamID iParamID) const
+  {
+    auto slot = findVstParameterSlot(iParamID);
+    return slot >= 0 ? fVstParameterTable[slot] : nullptr;
+  }
+
   /**
    * Called from the RT thread from beforeProcessing to set the new state. Can be overridden
    * @return true if the state has changed, false otherwise
@@ -170,16 +283,21 @@ protected:
 
   /**
    * Called from the RT thread from afterProcessing to reset previous values (copy current value to previous).
-   * Can be overridden.
+   * Only the parameters modified during the frame (see `getDirtyParameters`) are visited. Can be overridden.
    *
    * @return true if the state has changed, false otherwise */
   virtual bool resetPreviousValues();
 
   /**
-   * Called from the RT thread from afterProcessing to compute the latest state. Can be overridden
+   * Called from the RT thread from afterProcessing to compute the latest state. The state provided is always the
+   * same instance and holds the values computed at the end of the previous frame so that the default implementation
+   * only rewrites the values of the parameters modified during the frame. Can be overridden
    */
   virtual void computeLatestState(NormalizedState *oLatestState) const;
 
+  //! @return the parameters (slots) modified during this frame
+  inline RTDirtyParameterSet const &getDirtyParameters() const { return fDirtyParameters; }
+
   /**
    * Gives a chance to subclasses to tweak and/or display the state after being read */
   virtual void afterReadNewState(NormalizedState const *iState) {};
@@ -192,14 +310,64 @@ private:
   // computeLatestState
   void computeLatestState();
 
+  // builds the (frozen) ParamID -> slot index and the save order -> slot mapping (called from init)
+  void buildParameterIndex();
+
 private:
   // this queue is used to propagate a Processor::setState call (made from the UI thread) to this state
-  // the check happens in beforeProcessing
-  Concurrent::LockFree::SingleElementQueue<NormalizedState> fStateUpdate;
+  // the check happens in beforeProcessing. Depending on the host, setState may be called from different threads
+  // (UI, loader, automation...) hence the multi producer version.
+  Concurrent::LockFree::MPSCSingleElementQueue<NormalizedState> fStateUpdate;
 
   // this atomic value always hold the most current (and consistent) version of this state so that the UI thread
   // can access it in Processor::getState. It is updated in afterProcessing.
   Concurrent::LockFree::AtomicValue<NormalizedState> fLatestState;
+
+  // the latest state as computed by the RT thread (only the modified values are updated) which then gets copied
+  // into fLatestState
+  std::unique_ptr<NormalizedState> fLatestStateRT;
+
+  // the parameters modified during the frame
+  RTDirtyParameterSet fDirtyParameters{};
+
+  // max number of automation points recorded per parameter per frame (0 means sample accurate automation disabled)
+  int32 fMaxAutomationPointsPerBlock{0};
+
+  // the parameters which received automation points during the frame (capacity reserved ahead of time)
+  std::vector<RTRawVstParameter *> fAutomatedParameters{};
+
+  // flat table of all the vst parameters (slot -> parameter) in registration order (owned by fVstParameters)
+  std::vector<RTRawVstParameter *> fVstParameterTable{};
+
+  // ParamID -> slot (-1 when no such parameter) used when ParamIDs are dense enough (built in init)
+  std::vector<int32> fVstParameterDenseIndex{};
+
+  // ParamID -> slot sorted by ParamID used when ParamIDs are too sparse for the dense index (built in init)
+  std::vector<std::pair<ParamID, int32>> fVstParameterSparseIndex{};
+
+  // true when the index has been built and is up to date
+  bool fVstParameterIndexBuilt{false};
+
+  // NormalizedState index (RT save order) -> slot (built in init)
+  std::vector<int32> fSaveStateSlots{};
+
+  // slot -> NormalizedState index (RT save order) or -1 if not saved (built in init)
+  std::vector<int32> fSlotSaveStateIndices{};
+
+  // flat table of all the outbound messaging parameters (owned by fOutboundMessagingParameters)
+  std::vector<IRTJmbOutParameter *> fOutboundMessagingTable{};
+
+  // one message per outbound messaging parameter (same order as fOutboundMessagingTable) recycled from one tick
+  // to the next (only accessed from the UI thread)
+  std::vector<IPtr<RecyclableMessage>> fOutboundMessages{};
+
+  // message batching (disabled by default) => a single message (recycled) carries every update
+  bool fMessageBatching{false};
+  MessageBatchWriter fMessageBatch{};
+  IPtr<RecyclableMessage> fMessageBatchMessage{};
+
+  // all the smoothed parameters (owned by fVstParameters)
+  std::vector<IRTSmoothedParameter *> fSmoothedParameters{};
 };
 
 //------------------------------------------------------------------------
@@ -219,6 +387,33 @@ RTVstParam<T> RTState::add(VstParam<T> iParamDef)
   return rawPtr;
 }
 
+//------------------------------------------------------------------------
+// RTState::add (compile time converter)
+//------------------------------------------------------------------------
+template<typename T, typename Converter>
+RTVstParam<T, Converter> RTState::add(TVstParam<T, Converter> iParamDef)
+{
+  // YP Impl note: see add for similar impl note
+  auto rawPtr = new RTVstParameter<T, Converter>(std::move(iParamDef));
+  std::unique_ptr<RTRawVstParameter> rtParam{rawPtr};
+  addRawParameter(std::move(rtParam));
+  return rawPtr;
+}
+
+//------------------------------------------------------------------------
+// RTState::add (smoothed)
+//------------------------------------------------------------------------
+template<typename T>
+RTSmoothedVstParam<T> RTState::add(VstParam<T> iParamDef, RTSmoothing const &iSmoothing)
+{
+  // YP Impl note: see add for similar impl note
+  auto rawPtr = new RTSmoothedVstParameter<T>(std::move(iParamDef), iSmoothing);
+  std::unique_ptr<RTRawVstParameter> rtParam{rawPtr};
+  if(addRawParameter(std::move(rtParam)) == kResultOk)
+    fSmoothedParameters.emplace_back(rawPtr);
+  return rawPtr;
+}
+
 //------------------------------------------------------------------------
 // RTState::addJmbOut
 //------------------------------------------------------------------------
@@ -232,6 +427,18 @@ RTJmbOutParam<T> RTState::addJmbOut(JmbParam<T> iParamDef)
   return rawPtr;
 }
 
+//------------------------------------------------------------------------
+// RTState::addJmbOut
+//------------------------------------------------------------------------
+template<typename T>
+RTJmbOutParam<T> RTState::addJmbOut(JmbParam<T> iParamDef, size_t iQueueCapacity)
+{
+  auto rawPtr = new RTJmbOutParameter<T>(std::move(iParamDef), iQueueCapacity);
+  std::unique_ptr<IRTJmbOutParameter> rtParam{rawPtr};
+  addOutboundMessagingParameter(std::move(rtParam));
+  return rawPtr;
+}
+
 //------------------------------------------------------------------------
 // RTState::addJmbIn
 //------------------------------------------------------------------------
@@ -246,6 +453,19 @@ RTJmbInParam<T> RTState::addJmbIn(JmbParam<T> iParamDef)
   return rawPtr;
 }
 
+//------------------------------------------------------------------------
+// RTState::addJmbIn
+//------------------------------------------------------------------------
+template<typename T>
+RTJmbInParam<T> RTState::addJmbIn(JmbParam<T> iParamDef, size_t iMaxProducers)
+{
+  auto rawPtr = new RTJmbInParameter<T>(iParamDef, iMaxProducers);
+  std::unique_ptr<IRTJmbInParameter> rtParam{rawPtr};
+  addInboundMessagingParameter(std::move(rtParam));
+  fMessageHandler.registerHandler(iParamDef->fParamID, rawPtr);
+  return rawPtr;
+}
+
 }
 }
 }
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include "RTProcessor.h"
+#include <pongasoft/VST/DenormalGuard.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace pongasoft::VST::RT {
+
+/**
+ * Alternative base class for the actual processor which resolves at compile time what `RTProcessor` resolves at
+ * runtime on every frame: the dispatch on the sample size (`processInputs` -> `processInputs32Bits` /
+ * `processInputs64Bits`) and the `RTState` hooks (`beforeProcessing`, `applyParameterChanges`, `afterProcessing`)
+ * are direct (non virtual) calls, which lets the compiler inline the whole per frame pipeline. This makes a
+ * difference with very small buffers (ex: 32 samples in low latency sessions).
+ *
+ * This class uses the CRTP (Curiously Recurring Template Pattern): the derived class passes itself as the first
+ * template parameter and must provide the following methods (public, or declare `TRTProcessor` as a friend):
+ *
+ * ```
+ * class MyProcessor : public TRTProcessor<MyProcessor, MyRTState>
+ * {
+ * public:
+ *   // note the covariant return type (MyRTState and not RTState)
+ *   MyRTState *getRTState() override { return &fState; }
+ *
+ *   template<typename SampleType>
+ *   tresult genericProcessInputs(ProcessData &data);
+ * };
+ * ```
+ *
+ * When one of the options changing how `processInputs` is called is enabled (see `RTProcessor::isPlainProcessing`),
+ * `process` delegates to `RTProcessor::process` (the sample size dispatch remains static).
+ *
+ * @tparam Derived the actual processor (subclass of this class)
+ * @tparam State the actual state (subclass of `RTState`) returned by `Derived::getRTState()`
+ */
+template<typename Derived, typename State>
+class TRTProcessor : public RTProcessor
+{
+  static_assert(std::is_base_of_v<RTState, State>, "State must be a subclass of RTState");
+
+public:
+  explicit TRTProcessor(Steinberg::FUID const &iControllerUID) : RTProcessor(iControllerUID) {}
+
+  /** Here we go...the process call (resolved at compile time) */
+  tresult PLUGIN_API process(ProcessData &data) override;
+
+protected:
+  /**
+   * Delegates to `Derived::genericProcessInputs<Sample32>` or `Derived::genericProcessInputs<Sample64>` */
+  tresult processInputs(ProcessData &data) override { return dispatchProcessInputs(data); }
+
+  //! Delegates to `Derived::genericProcessInputs<Sample32>`
+  tresult processInputs32Bits(ProcessData &data) final
+  {
+    return derived()->template genericProcessInputs<Sample32>(data);
+  }
+
+  //! Delegates to `Derived::genericProcessInputs<Sample64>`
+  tresult processInputs64Bits(ProcessData &data) final
+  {
+    return derived()->template genericProcessInputs<Sample64>(data);
+  }
+
+  //! @return the state (non virtual call)
+  inline State *getState()
+  {
+    static_assert(std::is_same_v<decltype(std::declval<Derived &>().getRTState()), State *>,
+                  "Derived::getRTState() must return State *");
+    return derived()->Derived::getRTState();
+  }
+
+private:
+  inline Derived *derived() { return static_cast<Derived *>(this); }
+
+  // static dispatch on the sample size
+  inline tresult dispatchProcessInputs(ProcessData &data)
+  {
+    if(data.symbolicSampleSize == kSample32)
+      return derived()->template genericProcessInputs<Sample32>(data);
+
+    if(data.symbolicSampleSize == kSample64)
+      return derived()->template genericProcessInputs<Sample64>(data);
+
+    return kResultFalse;
+  }
+};
+
+//------------------------------------------------------------------------
+// TRTProcessor::process
+//------------------------------------------------------------------------
+template<typename Derived, typename State>
+tresult TRTProcessor<Derived, State>::process(ProcessData &data)
+{
+  if(!isPlainProcessing())
+    return RTProcessor::process(data);
+
+  // same steps as RTProcessor::process but every call is qualified (thus not virtual)
+  DenormalGuard denormalGuard{isFlushingDenormals()};
+
+  auto state = getState();
+
+  // 1. we check if there was any state update (UI calls setState)
+  state->State::beforeProcessing();
+
+  // 2. process parameter changes (this will override any update in step 1.)
+  if(data.inputParameterChanges != nullptr)
+    state->State::applyParameterChanges(*data.inputParameterChanges);
+
+  // 3. process inputs
+  auto res = dispatchProcessInputs(data);
+
+  // 4. update the previous state
+  state->State::afterProcessing();
+
+  // 5. release the scratch memory allocated during this frame
+  getScratchArena().reset();
+
+  return res;
+}
+
+}
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include <pluginterfaces/base/ftypes.h>
+#include <pongasoft/logging/logging.h>
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JAMBA_FFT_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define JAMBA_FFT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace pongasoft::VST {
+
+using namespace Steinberg;
+
+namespace Impl {
+
+/**
+ * Butterflies of one group of a radix-2 stage: `h` butterflies between `a` and `b` (`h` values each) with the
+ * twiddle factors `w`. The baseline instruction set of the platform is used (SSE2 on x86_64, NEON on arm64), the
+ * remaining butterflies (or all of them on other platforms) being computed one at a time.
+ */
+struct FFTKernels
+{
+  template<typename SampleType>
+  static inline void butterflies(SampleType *ar, SampleType *ai, SampleType *br, SampleType *bi,
+                                 SampleType const *wr, SampleType const *wi, int32 h)
+  {
+    int32 j = 0;
+#if JAMBA_FFT_SSE2
+    if constexpr(std::is_same_v<SampleType, float>)
+    {
+      for(; j + 4 <= h; j += 4)
+      {
+        auto vbr = _mm_loadu_ps(br + j), vbi = _mm_loadu_ps(bi + j);
+        auto vwr = _mm_loadu_ps(wr + j), vwi = _mm_loadu_ps(wi + j);
+        auto tr = _mm_sub_ps(_mm_mul_ps(vbr, vwr), _mm_mul_ps(vbi, vwi));
+        auto ti = _mm_add_ps(_mm_mul_ps(vbr, vwi), _mm_mul_ps(vbi, vwr));
+        auto var = _mm_loadu_ps(ar + j), vai = _mm_loadu_ps(ai + j);
+        _mm_storeu_ps(br + j, _mm_sub_ps(var, tr));
+        _mm_storeu_ps(bi + j, _mm_sub_ps(vai, ti));
+        _mm_storeu_ps(ar + j, _mm_add_ps(var, tr));
+        _mm_storeu_ps(ai + j, _mm_add_ps(vai, ti));
+      }
+    }
+    else if constexpr(std::is_same_v<SampleType, double>)
+    {
+      for(; j + 2 <= h; j += 2)
+      {
+        auto vbr = _mm_loadu_pd(br + j), vbi = _mm_loadu_pd(bi + j);
+        auto vwr = _mm_loadu_pd(wr + j), vwi = _mm_loadu_pd(wi + j);
+        auto tr = _mm_sub_pd(_mm_mul_pd(vbr, vwr), _mm_mul_pd(vbi, vwi));
+        auto ti = _mm_add_pd(_mm_mul_pd(vbr, vwi), _mm_mul_pd(vbi, vwr));
+        auto var = _mm_loadu_pd(ar + j), vai = _mm_loadu_pd(ai + j);
+        _mm_storeu_pd(br + j, _mm_sub_pd(var, tr));
+        _mm_storeu_pd(bi + j, _mm_sub_pd(vai, ti));
+        _mm_storeu_pd(ar + j, _mm_add_pd(var, tr));
+        _mm_storeu_pd(ai + j, _mm_add_pd(vai, ti));
+      }
+    }
+#elif JAMBA_FFT_NEON
+    if constexpr(std::is_same_v<SampleType, float>)
+    {
+      for(; j + 4 <= h; j += 4)
+      {
+        auto vbr = vld1q_f32(br + j), vbi = vld1q_f32(bi + j);
+        auto vwr = vld1q_f32(wr + j), vwi = vld1q_f32(wi + j);
+        auto tr = vsubq_f32(vmulq_f32(vbr, vwr), vmulq_f32(vbi, vwi));
+        auto ti = vaddq_f32(vmulq_f32(vbr, vwi), vmulq_f32(vbi, vwr));
+        auto var = vld1q_f32(ar + j), vai = vld1q_f32(ai + j);
+        vst1q_f32(br + j, vsubq_f32(var, tr));
+        vst1q_f32(bi + j, vsubq_f32(vai, ti));
+        vst1q_f32(ar + j, vaddq_f32(var, tr));
+        vst1q_f32(ai + j, vaddq_f32(vai, ti));
+      }
+    }
+    else if constexpr(std::is_same_v<SampleType, double>)
+    {
+      for(; j + 2 <= h; j += 2)
+      {
+        auto vbr = vld1q_f64(br + j), vbi = vld1q_f64(bi + j);
+        auto vwr = vld1q_f64(wr + j), vwi = vld1q_f64(wi + j);
+        auto tr = vsubq_f64(vmulq_f64(vbr, vwr), vmulq_f64(vbi, vwi));
+        auto ti = vaddq_f64(vmulq_f64(vbr, vwi), vmulq_f64(vbi, vwr));
+        auto var = vld1q_f64(ar + j), vai = vld1q_f64(ai + j);
+        vst1q_f64(br + j, vsubq_f64(var, tr));
+        vst1q_f64(bi + j, vsubq_f64(vai, ti));
+        vst1q_f64(ar + j, vaddq_f64(var, tr));
+        vst1q_f64(ai + j, vaddq_f64(vai, ti));
+      }
+    }
+#endif
+    for(; j < h; j++)
+    {
+      auto tr = br[j] * wr[j] - bi[j] * wi[j];
+      auto ti = br[j] * wi[j] + bi[j] * wr[j];
+      br[j] = ar[j] - tr;
+      bi[j] = ai[j] - ti;
+      ar[j] += tr;
+      ai[j] += ti;
+    }
+  }
+};
+
+}
+
+/**
+ * Fast Fourier Transform of a real signal of `getSize()` samples (a power of 2). The signal is processed as a complex
+ * signal of half the size (even samples as real part, odd samples as imaginary part) with an iterative radix-2 FFT,
+ * and the result is then split into the `getNumBins()` (`getSize() / 2 + 1`) bins of the real signal.
+ *
+ * The spectrum is represented as 2 separate arrays (real and imaginary parts) and the butterflies are computed on
+ * contiguous arrays (the twiddle factors are stored per stage) with SSE2 / NEON (see `Impl::FFTKernels`). The first
+ * 2 stages (1 and 2 butterflies per group, too short to be vectorized) are combined into a single radix-4 pass
+ * whose twiddle factors (1 and -i) require no multiplication.
+ *
+ * All the memory is allocated in the constructor: `forward` and `inverse` do not allocate and can be called from the
+ * RT thread (they are not thread safe though since they share internal buffers).
+ *
+ * @tparam SampleType `float` or `double` (`Sample32` or `Sample64`)
+ */
+template<typename SampleType>
+class RealFFT
+{
+public:
+  /**
+   * @param iSize the number of samples (must be a power of 2, at least 4) */
+  explicit RealFFT(int32 iSize);
+
+  //! @return the number of samples of the signal
+  inline int32 getSize() const { return fSize; }
+
+  //! @return the number of bins of the spectrum (`getSize() / 2 + 1`, from DC to Nyquist)
+  inline int32 getNumBins() const { return fHalfSize + 1; }
+
+  /**
+   * Computes the spectrum of `iSignal` (`getSize()` samples) into `oReal` and `oImag` (`getNumBins()` values each).
+   * The spectrum is not normalized. */
+  void forward(SampleType const *iSignal, SampleType *oReal, SampleType *oImag);
+
+  /**
+   * Computes the signal (`getSize()` samples) from its spectrum (`getNumBins()` values each) such that
+   * `inverse(forward(x)) == x`. Note that the imaginary part of the DC and Nyquist bins is ignored. */
+  void inverse(SampleType const *iReal, SampleType const *iImag, SampleType *oSignal);
+
+private:
+  // in place (forward) complex FFT of size fHalfSize
+  void complexFFT(SampleType *ioReal, SampleType *ioImag) const;
+
+private:
+  int32 const fSize;
+  int32 const fHalfSize;
+
+  // bit reversal permutation (for the complex FFT)
+  std::vector<int32> fBitReverse;
+
+  // twiddle factors of each stage (stage with half size h starts at index h - 1)
+  std::vector<SampleType> fTwiddleReal;
+  std::vector<SampleType> fTwiddleImag;
+
+  // twiddle factors used to split the complex spectrum into the real spectrum (e^(-2i.pi.k/N))
+  std::vector<SampleType> fSplitReal;
+  std::vector<SampleType> fSplitImag;
+
+  // the complex signal / spectrum
+  std::vector<SampleType> fReal;
+  std::vector<SampleType> fImag;
+};
+
+//------------------------------------------------------------------------
+// RealFFT::RealFFT
+//------------------------------------------------------------------------
+template<typename SampleType>
+RealFFT<SampleType>::RealFFT(int32 iSize) :
+  fSize{iSize},
+  fHalfSize{iSize / 2},
+  fBitReverse(static_cast<size_t>(fHalfSize)),
+  fTwiddleReal(static_cast<size_t>(fHalfSize)),
+  fTwiddleImag(static_cast<size_t>(fHalfSize)),
+  fSplitReal(static_cast<size_t>(fHalfSize + 1)),
+  fSplitImag(static_cast<size_t>(fHalfSize + 1)),
+  fReal(static_cast<size_t>(fHalfSize)),
+  fImag(static_cast<size_t>(fHalfSize))
+{
+  DCHECK_F(iSize >= 4 && (iSize & (iSize - 1)) == 0, "FFT size must be a power of 2 (>= 4)");
+
+  constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+  int32 numBits = 0;
+  while((1 << numBits) < fHalfSize)
+    numBits++;
+
+  for(int32 i = 0; i < fHalfSize; i++)
+  {
+    int32 reversed = 0;
+    for(int32 b = 0; b < numBits; b++)
+      reversed |= ((i >> b) & 1) << (numBits - 1 - b);
+    fBitReverse[i] = reversed;
+  }
+
+  for(int32 h = 1; h < fHalfSize; h <<= 1)
+  {
+    for(int32 j = 0; j < h; j++)
+    {
+      auto angle = -kTwoPi * j / (2.0 * h);
+      fTwiddleReal[h - 1 + j] = static_cast<SampleType>(std::cos(angle));
+      fTwiddleImag[h - 1 + j] = static_cast<SampleType>(std::sin(angle));
+    }
+  }
+
+  for(int32 k = 0; k <= fHalfSize; k++)
+  {
+    auto angle = -kTwoPi * k / fSize;
+    fSplitReal[k] = static_cast<SampleType>(std::cos(angle));
+    fSplitImag[k] = static_cast<SampleType>(std::sin(angle));
+  }
+}
+
+//------------------------------------------------------------------------
+// RealFFT::complexFFT
+//------------------------------------------------------------------------
+template<typename SampleType>
+void RealFFT<SampleType>::complexFFT(SampleType *ioReal, SampleType *ioImag) const
+{
+  auto const n = fHalfSize;
+
+  for(int32 i = 0; i < n; i++)
+  {
+    auto j = fBitReverse[i];
+    if(i < j)
+    {
+      std::swap(ioReal[i], ioReal[j]);
+      std::swap(ioImag[i], ioImag[j]);
+    }
+  }
+
+  int32 h = 1;
+
+  // first 2 stages combined (radix-4): for each group of 4, the twiddle factors are 1 (stage 1) and 1, -i (stage 2)
+  if(n >= 4)
+  {
+    for(int32 i = 0; i < n; i += 4)
+    {
+      auto r0 = ioReal[i] + ioReal[i + 1], i0 = ioImag[i] + ioImag[i + 1];
+      auto r1 = ioReal[i] - ioReal[i + 1], i1 = ioImag[i] - ioImag[i + 1];
+      auto r2 = ioReal[i + 2] + ioReal[i + 3], i2 = ioImag[i + 2] + ioImag[i + 3];
+      auto r3 = ioReal[i + 2] - ioReal[i + 3], i3 = ioImag[i + 2] - ioImag[i + 3];
+
+      ioReal[i] = r0 + r2;
+      ioImag[i] = i0 + i2;
+      ioReal[i + 2] = r0 - r2;
+      ioImag[i + 2] = i0 - i2;
+
+      // (r3 + i.i3) * -i = i3 - i.r3
+      ioReal[i + 1] = r1 + i3;
+      ioImag[i + 1] = i1 - r3;
+      ioReal[i + 3] = r1 - i3;
+      ioImag[i + 3] = i1 + r3;
+    }
+    h = 4;
+  }
+
+  for(; h < n; h <<= 1)
+  {
+    SampleType const *wr = fTwiddleReal.data() + h - 1;
+    SampleType const *wi = fTwiddleImag.data() + h - 1;
+
+    for(int32 i = 0; i < n; i += 2 * h)
+      Impl::FFTKernels::butterflies(ioReal + i, ioImag + i, ioReal + i + h, ioImag + i + h, wr, wi, h);
+  }
+}
+
+//------------------------------------------------------------------------
+// RealFFT::forward
+//------------------------------------------------------------------------
+template<typename SampleType>
+void RealFFT<SampleType>::forward(SampleType const *iSignal, SampleType *oReal, SampleType *oImag)
+{
+  auto const n = fHalfSize;
+
+  for(int32 i = 0; i < n; i++)
+  {
+    fReal[i] = iSignal[2 * i];
+    fImag[i] = iSignal[2 * i + 1];
+  }
+
+  complexFFT(fReal.data(), fImag.data());
+
+  // X[k] = E[k] + W^k.O[k] where E (resp. O) is the spectrum of the even (resp. odd) samples:
+  // E[k] = (Z[k] + conj(Z[n-k])) / 2 and O[k] = (Z[k] - conj(Z[n-k])) / 2i
+  for(int32 k = 0; k <= n; k++)
+  {
+    auto zr = fReal[k % n];
+    auto zi = fImag[k % n];
+    auto cr = fReal[(n - k) % n];
+    auto ci = -fImag[(n - k) % n];
+
+    auto er = (zr + cr) / 2;
+    auto ei = (zi + ci) / 2;
+    auto oR = (zi - ci) / 2;
+    auto oI = -(zr - cr) / 2;
+
+    oReal[k] = er + fSplitReal[k] * oR - fSplitImag[k] * oI;
+    oImag[k] = ei + fSplitReal[k] * oI + fSplitImag[k] * oR;
+  }
+}
+
+//------------------------------------------------------------------------
+// RealFFT::inverse
+//------------------------------------------------------------------------
+template<typename SampleType>
+void RealFFT<SampleType>::inverse(SampleType const *iReal, SampleType const *iImag, SampleType *oSignal)
+{
+  auto const n = fHalfSize;
+
+  // E[k] = (X[k] + conj(X[n-k])) / 2, O[k] = (X[k] - conj(X[n-k])) / (2.W^k) and Z[k] = E[k] + i.O[k]
+  for(int32 k = 0; k < n; k++)
+  {
+    auto xr = iReal[k];
+    auto xi = k == 0 ? 0 : iImag[k];
+    auto cr = iReal[n - k];
+    auto ci = k == 0 ? 0 : -iImag[n - k];
+
+    auto er = (xr + cr) / 2;
+    auto ei = (xi + ci) / 2;
+    auto dr = (xr - cr) / 2;
+    auto di = (xi - ci) / 2;
+
+    // division by W^k is a multiplication by its conjugate (|W| = 1)
+    auto oR = dr * fSplitReal[k] + di * fSplitImag[k];
+    auto oI = di * fSplitReal[k] - dr * fSplitImag[k];
+
+    fReal[k] = er - oI;
+    fImag[k] = ei + oR;
+  }
+
+  // inverse FFT by swapping the real and imaginary parts (on input and output)
+  complexFFT(fImag.data(), fReal.data());
+
+  auto const scale = static_cast<SampleType>(1) / static_cast<SampleType>(n);
+  for(int32 i = 0; i < n; i++)
+  {
+    oSignal[2 * i] = fReal[i] * scale;
+    oSignal[2 * i + 1] = fImag[i] * scale;
+  }
+}
+
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#include "RecyclableMessage.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace pongasoft::VST {
+
+//------------------------------------------------------------------------
+// RecyclableMessage::create
+//------------------------------------------------------------------------
+IPtr<RecyclableMessage> RecyclableMessage::create()
+{
+  return owned(new RecyclableMessage());
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::queryInterface
+//------------------------------------------------------------------------
+tresult RecyclableMessage::queryInterface(const TUID _iid, void **obj)
+{
+  QUERY_INTERFACE(_iid, obj, FUnknown::iid, IMessage)
+  QUERY_INTERFACE(_iid, obj, IMessage::iid, IMessage)
+  QUERY_INTERFACE(_iid, obj, IAttributeList::iid, IAttributeList)
+  *obj = nullptr;
+  return kNoInterface;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::addRef
+//------------------------------------------------------------------------
+uint32 RecyclableMessage::addRef()
+{
+  return ++fRefCount;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::release
+//------------------------------------------------------------------------
+uint32 RecyclableMessage::release()
+{
+  auto refCount = --fRefCount;
+  if(refCount == 0)
+    delete this;
+  return refCount;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::clear
+//------------------------------------------------------------------------
+void RecyclableMessage::clear()
+{
+  fMessageID.clear();
+  fHasMessageID = false;
+  fNumAttributes = 0;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::getMessageID
+//------------------------------------------------------------------------
+FIDString RecyclableMessage::getMessageID()
+{
+  return fHasMessageID ? fMessageID.c_str() : nullptr;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::setMessageID
+//------------------------------------------------------------------------
+void RecyclableMessage::setMessageID(FIDString id)
+{
+  fHasMessageID = id != nullptr;
+  if(fHasMessageID)
+    fMessageID.assign(id); // reuses the memory when it fits
+  else
+    fMessageID.clear();
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::find
+//------------------------------------------------------------------------
+RecyclableMessage::Attribute *RecyclableMessage::find(AttrID iID, AttributeType iType)
+{
+  if(!iID)
+    return nullptr;
+
+  for(int32 i = 0; i < fNumAttributes; i++)
+  {
+    auto &attribute = fAttributes[i];
+    if(attribute.fID == iID)
+      return attribute.fType == iType ? &attribute : nullptr;
+  }
+
+  return nullptr;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::findOrAdd
+//------------------------------------------------------------------------
+RecyclableMessage::Attribute *RecyclableMessage::findOrAdd(AttrID iID, AttributeType iType)
+{
+  if(!iID)
+    return nullptr;
+
+  Attribute *res = nullptr;
+
+  for(int32 i = 0; i < fNumAttributes && !res; i++)
+  {
+    if(fAttributes[i].fID == iID)
+      res = &fAttributes[i];
+  }
+
+  if(!res)
+  {
+    if(fNumAttributes == static_cast<int32>(fAttributes.size()))
+      fAttributes.emplace_back();
+    res = &fAttributes[fNumAttributes++];
+    res->fID.assign(iID);
+  }
+
+  res->fType = iType;
+  return res;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::setInt
+//------------------------------------------------------------------------
+tresult RecyclableMessage::setInt(AttrID id, int64 value)
+{
+  auto attribute = findOrAdd(id, AttributeType::kInt);
+  if(!attribute)
+    return kInvalidArgument;
+  attribute->fInt = value;
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::getInt
+//------------------------------------------------------------------------
+tresult RecyclableMessage::getInt(AttrID id, int64 &value)
+{
+  auto attribute = find(id, AttributeType::kInt);
+  if(!attribute)
+    return kResultFalse;
+  value = attribute->fInt;
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::setFloat
+//------------------------------------------------------------------------
+tresult RecyclableMessage::setFloat(AttrID id, double value)
+{
+  auto attribute = findOrAdd(id, AttributeType::kFloat);
+  if(!attribute)
+    return kInvalidArgument;
+  attribute->fFloat = value;
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::getFloat
+//------------------------------------------------------------------------
+tresult RecyclableMessage::getFloat(AttrID id, double &value)
+{
+  auto attribute = find(id, AttributeType::kFloat);
+  if(!attribute)
+    return kResultFalse;
+  value = attribute->fFloat;
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::setString
+//------------------------------------------------------------------------
+tresult RecyclableMessage::setString(AttrID id, const TChar *string)
+{
+  if(!string)
+    return kInvalidArgument;
+
+  auto attribute = findOrAdd(id, AttributeType::kString);
+  if(!attribute)
+    return kInvalidArgument;
+
+  size_t length = 0;
+  while(string[length] != 0)
+    length++;
+
+  auto bytes = reinterpret_cast<char const *>(string);
+  attribute->fData.assign(bytes, bytes + (length + 1) * sizeof(TChar));
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::getString
+//------------------------------------------------------------------------
+tresult RecyclableMessage::getString(AttrID id, TChar *string, uint32 sizeInBytes)
+{
+  auto attribute = find(id, AttributeType::kString);
+  if(!attribute || !string || sizeInBytes < sizeof(TChar))
+    return kResultFalse;
+
+  // truncates if necessary (always 0 terminated)
+  auto numChars = std::min(attribute->fData.size(), static_cast<size_t>(sizeInBytes)) / sizeof(TChar);
+  std::memcpy(string, attribute->fData.data(), numChars * sizeof(TChar));
+  string[numChars - 1] = 0;
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::setBinary
+//------------------------------------------------------------------------
+tresult RecyclableMessage::setBinary(AttrID id, const void *data, uint32 sizeInBytes)
+{
+  if(!data && sizeInBytes > 0)
+    return kInvalidArgument;
+
+  auto attribute = findOrAdd(id, AttributeType::kBinary);
+  if(!attribute)
+    return kInvalidArgument;
+
+  auto bytes = static_cast<char const *>(data);
+  attribute->fData.assign(bytes, bytes + sizeInBytes);
+  return kResultOk;
+}
+
+//------------------------------------------------------------------------
+// RecyclableMessage::getBinary
+//------------------------------------------------------------------------
+tresult RecyclableMessage::getBinary(AttrID id, const void *&data, uint32 &sizeInBytes)
+{
+  auto attribute = find(id, AttributeType::kBinary);
+  if(!attribute)
+    return kResultFalse;
+  data = attribute->fData.data();
+  sizeInBytes = static_cast<uint32>(attribute->fData.size());
+  return kResultOk;
+}
+
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include <pluginterfaces/vst/ivstmessage.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace pongasoft::VST {
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+/**
+ * Jamba implementation of `IMessage` (and its `IAttributeList`) meant to be reused: since jamba implements the
+ * reference counting, it knows for sure when nobody else holds a reference to the message anymore (`isShared`), at
+ * which point the message can be cleared (`clear`) and filled again. Clearing keeps the memory allocated for the
+ * attributes so that sending messages with the same shape over and over does not allocate.
+ *
+ * @see IMessageProducer::recycleMessage */
+class RecyclableMessage : public IMessage, public IAttributeList
+{
+public:
+  //! Creates a new message (with a reference count of 1, owned by the returned pointer)
+  static IPtr<RecyclableMessage> create();
+
+  //! @return `true` if somebody other than the caller holds a reference to this message
+  inline bool isShared() const { return fRefCount.load() > 1; }
+
+  //! Removes the message id and every attribute (but keeps the memory for reuse)
+  void clear();
+
+  //! @return the number of attributes
+  inline int32 getAttributeCount() const { return fNumAttributes; }
+
+  // FUnknown
+  tresult PLUGIN_API queryInterface(const TUID _iid, void **obj) override;
+  uint32 PLUGIN_API addRef() override;
+  uint32 PLUGIN_API release() override;
+
+  // IMessage
+  FIDString PLUGIN_API getMessageID() override;
+  void PLUGIN_API setMessageID(FIDString id) override;
+  IAttributeList *PLUGIN_API getAttributes() override { return this; }
+
+  // IAttributeList
+  tresult PLUGIN_API setInt(AttrID id, int64 value) override;
+  tresult PLUGIN_API getInt(AttrID id, int64 &value) override;
+  tresult PLUGIN_API setFloat(AttrID id, double value) override;
+  tresult PLUGIN_API getFloat(AttrID id, double &value) override;
+  tresult PLUGIN_API setString(AttrID id, const TChar *string) override;
+  tresult PLUGIN_API getString(AttrID id, TChar *string, uint32 sizeInBytes) override;
+  tresult PLUGIN_API setBinary(AttrID id, const void *data, uint32 sizeInBytes) override;
+  tresult PLUGIN_API getBinary(AttrID id, const void *&data, uint32 &sizeInBytes) override;
+
+  // disabling copy
+  RecyclableMessage(RecyclableMessage const &) = delete;
+  RecyclableMessage& operator=(RecyclableMessage const &) = delete;
+
+private:
+  enum class AttributeType { kInt, kFloat, kString, kBinary };
+
+  struct Attribute
+  {
+    std::string fID{};
+    AttributeType fType{AttributeType::kInt};
+    int64 fInt{};
+    double fFloat{};
+    std::vector<char> fData{}; // string (including the terminating 0) or binary
+  };
+
+  RecyclableMessage() = default;
+  virtual ~RecyclableMessage() = default;
+
+  // returns the attribute with the given id (nullptr if not found or not of the given type)
+  Attribute *find(AttrID iID, AttributeType iType);
+
+  // returns the attribute with the given id (reusing a slot if the attribute does not exist yet)
+  Attribute *findOrAdd(AttrID iID, AttributeType iType);
+
+private:
+  std::atomic<uint32> fRefCount{1};
+  std::string fMessageID{};
+  bool fHasMessageID{false};
+  std::vector<Attribute> fAttributes{}; // slots past fNumAttributes are kept for reuse
+  int32 fNumAttributes{0};
+};
+
+}
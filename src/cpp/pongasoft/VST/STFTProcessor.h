@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#pragma once
+
+#include "AudioBuffer.h"
+#include "ILatencySource.h"
+#include "RealFFT.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace pongasoft::VST {
+
+/**
+ * The window applied to each frame of the `STFTProcessor` (all windows are periodic so that they overlap properly) */
+enum class STFTWindow
+{
+  kRectangular,
+  kHann,
+  kHamming,
+  kBlackman
+};
+
+/**
+ * Short-Time Fourier Transform processing (analysis, spectral processing, resynthesis by overlap-add).
+ *
+ * The input is split into frames of `getFFTSize()` samples, every `getHopSize()` samples. Each frame is windowed and
+ * transformed into its spectrum (`getNumBins()` bins, from DC to Nyquist) which is handed to a callback provided by
+ * the caller (this is where the actual processing happens). The modified spectrum is then transformed back, windowed
+ * again and added to the output (overlap-add). The output is normalized so that a callback which does not modify the
+ * spectrum reproduces the input exactly (delayed by `getLatencySamples()` = `getFFTSize()` samples).
+ *
+ * All the memory is allocated in the constructor: `process` does not allocate and is meant to be called from
+ * `RTProcessor::processInputs` (after registering the processor with `RTProcessor::addLatencySource` so that the
+ * latency is reported to the host). Typical usage:
+ *
+ * ```
+ * // in initialize
+ * fSTFT = std::make_unique<STFTProcessor<Sample32>>(2, 1024, 256, STFTWindow::kHann);
+ * addLatencySource(fSTFT.get());
+ *
+ * // in genericProcessInputs
+ * fSTFT->process(in, out, [](int32 iChannel, Sample32 *ioReal, Sample32 *ioImag, int32 iNumBins) {
+ *   for(int32 k = iNumBins / 2; k < iNumBins; k++)
+ *     ioReal[k] = ioImag[k] = 0; // brick wall low pass filter
+ * });
+ * ```
+ *
+ * @tparam SampleType `float` or `double` (`Sample32` or `Sample64`)
+ */
+template<typename SampleType>
+class STFTProcessor : public ILatencySource
+{
+public:
+  /**
+   * @param iNumChannels the (maximum) number of channels processed
+   * @param iFFTSize the size of each frame (must be a power of 2, at least 4)
+   * @param iHopSize the number of samples between 2 frames (must divide `iFFTSize`, ex: `iFFTSize / 4`)
+   * @param iWindow the window applied to each frame (on analysis and resynthesis)
+   */
+  STFTProcessor(int32 iNumChannels, int32 iFFTSize, int32 iHopSize, STFTWindow iWindow = STFTWindow::kHann);
+
+  //! @return the size of each frame
+  inline int32 getFFTSize() const { return fFFT.getSize(); }
+
+  //! @return the number of samples between 2 frames
+  inline int32 getHopSize() const { return fHopSize; }
+
+  //! @return the number of bins of the spectrum handed to the callback (`getFFTSize() / 2 + 1`)
+  inline int32 getNumBins() const { return fFFT.getNumBins(); }
+
+  //! @return the number of channels processed
+  inline int32 getNumChannels() const { return static_cast<int32>(fChannels.size()); }
+
+  //! @return the delay introduced by the processing (`getFFTSize()`)
+  uint32 getLatencySamples() const override { return static_cast<uint32>(getFFTSize()); }
+
+  /**
+   * Processes `iIn` into `oOut` (which can be the same buffers) calling `iCallback` for every frame of every channel
+   * with the following signature:
+   *
+   * ```
+   * void callback(int32 iChannel, SampleType *ioReal, SampleType *ioImag, int32 iNumBins);
+   * ```
+   *
+   * Note that the callback can be called 0, 1 or more times per `process` call depending on the number of samples.
+   * The silence flags of `oOut` are adjusted. */
+  template<typename Callback>
+  void process(AudioBuffers<SampleType> const &iIn, AudioBuffers<SampleType> &oOut, Callback &&iCallback);
+
+  //! Clears the internal state (to be called when the processing is (re)started, not RT safe)
+  void reset();
+
+private:
+  // computes a frame of a channel (fInput) and overlap-adds the result (fOutput)
+  template<typename Callback>
+  void processFrame(int32 iChannel, Callback &iCallback);
+
+  struct ChannelState
+  {
+    std::vector<SampleType> fInput;  // the last fftSize samples of input
+    std::vector<SampleType> fOutput; // the overlap-add accumulator
+  };
+
+private:
+  RealFFT<SampleType> fFFT;
+  int32 const fHopSize;
+
+  // analysis window
+  std::vector<SampleType> fWindow;
+
+  // synthesis window (analysis window with overlap-add normalization)
+  std::vector<SampleType> fSynthesisWindow;
+
+  std::vector<ChannelState> fChannels;
+
+  // position in the current hop (shared by all channels)
+  int32 fHopPosition{0};
+
+  // work buffers (shared by all channels)
+  std::vector<SampleType> fFrame;
+  std::vector<SampleType> fReal;
+  std::vector<SampleType> fImag;
+};
+
+//------------------------------------------------------------------------
+// STFTProcessor::STFTProcessor
+//------------------------------------------------------------------------
+template<typename SampleType>
+STFTProcessor<SampleType>::STFTProcessor(int32 iNumChannels, int32 iFFTSize, int32 iHopSize, STFTWindow iWindow) :
+  fFFT{iFFTSize},
+  fHopSize{iHopSize > 0 && iHopSize <= iFFTSize && iFFTSize % iHopSize == 0 ? iHopSize : iFFTSize},
+  fWindow(static_cast<size_t>(iFFTSize)),
+  fSynthesisWindow(static_cast<size_t>(iFFTSize)),
+  fChannels(static_cast<size_t>(std::max(iNumChannels, 0))),
+  fFrame(static_cast<size_t>(iFFTSize)),
+  fReal(static_cast<size_t>(fFFT.getNumBins())),
+  fImag(static_cast<size_t>(fFFT.getNumBins()))
+{
+  DCHECK_F(fHopSize == iHopSize, "hop size (%d) must divide the fft size (%d)", iHopSize, iFFTSize);
+
+  constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+  for(int32 i = 0; i < iFFTSize; i++)
+  {
+    auto x = kTwoPi * i / iFFTSize;
+    double w;
+    switch(iWindow)
+    {
+      case STFTWindow::kHann:
+        w = 0.5 - 0.5 * std::cos(x);
+        break;
+      case STFTWindow::kHamming:
+        w = 0.54 - 0.46 * std::cos(x);
+        break;
+      case STFTWindow::kBlackman:
+        w = 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2 * x);
+        break;
+      default:
+        w = 1.0;
+        break;
+    }
+    fWindow[i] = static_cast<SampleType>(w);
+  }
+
+  // each output sample is the sum of fftSize / hop frames, each one multiplied by the window twice
+  for(int32 i = 0; i < iFFTSize; i++)
+  {
+    double sum = 0;
+    for(int32 j = i % fHopSize; j < iFFTSize; j += fHopSize)
+      sum += static_cast<double>(fWindow[j]) * static_cast<double>(fWindow[j]);
+    fSynthesisWindow[i] = sum > 0 ? static_cast<SampleType>(fWindow[i] / sum) : 0;
+  }
+
+  reset();
+}
+
+//------------------------------------------------------------------------
+// STFTProcessor::reset
+//------------------------------------------------------------------------
+template<typename SampleType>
+void STFTProcessor<SampleType>::reset()
+{
+  auto fftSize = static_cast<size_t>(getFFTSize());
+  for(auto &channel: fChannels)
+  {
+    channel.fInput.assign(fftSize, 0);
+    channel.fOutput.assign(fftSize, 0);
+  }
+  fHopPosition = 0;
+}
+
+//------------------------------------------------------------------------
+// STFTProcessor::process
+//------------------------------------------------------------------------
+template<typename SampleType>
+template<typename Callback>
+void STFTProcessor<SampleType>::process(AudioBuffers<SampleType> const &iIn,
+                                        AudioBuffers<SampleType> &oOut,
+                                        Callback &&iCallback)
+{
+  auto const fftSize = getFFTSize();
+  auto const numChannels = getNumChannels();
+  auto const numSamples = std::min(iIn.getNumSamples(), oOut.getNumSamples());
+  auto inputs = iIn.getBuffer();
+  auto outputs = oOut.getBuffer();
+
+  int32 offset = 0;
+  while(offset < numSamples)
+  {
+    auto hopPosition = fHopPosition;
+    auto n = std::min(fHopSize - hopPosition, numSamples - offset);
+
+    for(int32 c = 0; c < numChannels; c++)
+    {
+      auto &channel = fChannels[c];
+
+      // the input is copied first so that iIn and oOut can be the same buffers
+      auto input = channel.fInput.data() + fftSize - fHopSize + hopPosition;
+      if(inputs && c < iIn.getNumChannels() && inputs[c])
+        std::copy(inputs[c] + offset, inputs[c] + offset + n, input);
+      else
+        std::fill(input, input + n, 0);
+
+      if(outputs && c < oOut.getNumChannels() && outputs[c])
+      {
+        auto output = channel.fOutput.data() + hopPosition;
+        std::copy(output, output + n, outputs[c] + offset);
+      }
+    }
+
+    fHopPosition += n;
+    offset += n;
+
+    if(fHopPosition == fHopSize)
+    {
+      for(int32 c = 0; c < numChannels; c++)
+        processFrame(c, iCallback);
+      fHopPosition = 0;
+    }
+  }
+
+  oOut.adjustSilenceFlags();
+}
+
+//------------------------------------------------------------------------
+// STFTProcessor::processFrame
+//------------------------------------------------------------------------
+template<typename SampleType>
+template<typename Callback>
+void STFTProcessor<SampleType>::processFrame(int32 iChannel, Callback &iCallback)
+{
+  auto const fftSize = getFFTSize();
+  auto &channel = fChannels[iChannel];
+  auto input = channel.fInput.data();
+  auto output = channel.fOutput.data();
+  auto frame = fFrame.data();
+
+  // analysis
+  for(int32 i = 0; i < fftSize; i++)
+    frame[i] = input[i] * fWindow[i];
+
+  fFFT.forward(frame, fReal.data(), fImag.data());
+
+  iCallback(iChannel, fReal.data(), fImag.data(), getNumBins());
+
+  // resynthesis
+  fFFT.inverse(fReal.data(), fImag.data(), frame);
+
+  // the samples of the previous hop have been output => shift the accumulator and overlap-add the new frame
+  std::copy(output + fHopSize, output + fftSize, output);
+  std::fill(output + fftSize - fHopSize, output + fftSize, 0);
+  for(int32 i = 0; i < fftSize; i++)
+    output[i] += frame[i] * fSynthesisWindow[i];
+
+  // make room for the next hop
+  std::copy(input + fHopSize, input + fftSize, input);
+}
+
+}
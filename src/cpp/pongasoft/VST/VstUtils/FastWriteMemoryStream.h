@@ -56,6 +56,12 @@ public:
   void setSize(TSize size);  ///< set the memory size, a realloc will occur if memory already used
   void reset();
   inline void clear() { setSize(0); }
+  inline void rewind(int64 iPos = 0) ///< truncates the stream to iPos (0 empties it) but keeps the memory (for reuse)
+  {
+    if(iPos >= 0 && iPos < size)
+      size = iPos;
+    cursor = size;
+  }
   inline char const* getData() const { return memory; }
   inline int64 pos() const { return cursor; }
 
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#include <pongasoft/Utils/Collection/RingBuffer.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace pongasoft::Utils::Collection::TestRingBuffer {
+
+// RingBuffer - capacity
+TEST(RingBuffer, capacity)
+{
+  ASSERT_EQ(1, RingBuffer<int>(1).getCapacity());
+  ASSERT_EQ(8, RingBuffer<int>(5).getCapacity());
+  ASSERT_EQ(8, RingBuffer<int>(8).getCapacity());
+  ASSERT_EQ(1024, RingBuffer<int>(1000, true).getCapacity());
+  ASSERT_TRUE(RingBuffer<int>(1000, true).isMirrored());
+}
+
+// RingBuffer - a delay line processed with varying block sizes is the input delayed
+TEST(RingBuffer, delayLine)
+{
+  constexpr int kNumElements = 200;
+  constexpr int kDelay = 5;
+
+  for(bool mirrored: {false, true})
+  {
+    RingBuffer<int> rb{16, mirrored};
+    ASSERT_EQ(16, rb.getCapacity());
+    rb.init(-1);
+
+    std::vector<int> output{};
+    int blockSizes[] = {1, 3, 11, 7, 2};
+    int next = 0;
+    for(int i = 0; next < kNumElements; i++)
+    {
+      auto n = std::min(blockSizes[i % 5], kNumElements - next);
+      std::vector<int> block(static_cast<size_t>(n));
+      for(auto &e: block)
+        e = next++;
+
+      rb.write(block.data(), n);
+      ASSERT_EQ(next - 1, rb.getDelayed(0));
+
+      std::vector<int> delayed(static_cast<size_t>(n));
+      rb.read(delayed.data(), n, kDelay);
+      output.insert(output.end(), delayed.begin(), delayed.end());
+
+      if(mirrored)
+      {
+        auto span = rb.getSpan(n, kDelay);
+        ASSERT_EQ(delayed, std::vector<int>(span, span + n));
+      }
+    }
+
+    for(int i = 0; i < kNumElements; i++)
+      ASSERT_EQ(i < kDelay ? -1 : i - kDelay, output[i]) << "i=" << i << " mirrored=" << mirrored;
+
+    // reading the whole buffer (wraps)
+    std::vector<int> all(16);
+    rb.read(all.data(), 16, 0);
+    for(int i = 0; i < 16; i++)
+      ASSERT_EQ(kNumElements - 16 + i, all[i]);
+  }
+}
+
+// RingBuffer - push / write more than the capacity
+TEST(RingBuffer, push)
+{
+  for(bool mirrored: {false, true})
+  {
+    RingBuffer<int> rb{4, mirrored};
+    for(int i = 0; i < 6; i++)
+      rb.push(i);
+    ASSERT_EQ(5, rb.getDelayed(0));
+    ASSERT_EQ(2, rb.getDelayed(3));
+
+    int block[10] = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+    rb.write(block, 10);
+    int out[4];
+    rb.read(out, 4, 0);
+    ASSERT_EQ((std::vector<int>{16, 17, 18, 19}), std::vector<int>(out, out + 4));
+
+    rb.push(20);
+    rb.read(out, 3, 1);
+    ASSERT_EQ((std::vector<int>{17, 18, 19}), std::vector<int>(out, out + 3));
+  }
+}
+
+// RingBuffer - fractional delay
+TEST(RingBuffer, readInterpolated)
+{
+  for(bool mirrored: {false, true})
+  {
+    RingBuffer<float> rb{32, mirrored};
+
+    // a ramp => the interpolated value is exact
+    float next = 0;
+    for(int block = 0; block < 10; block++)
+    {
+      float input[7];
+      for(auto &e: input)
+        e = next++;
+      rb.write(input, 7);
+
+      float output[7];
+      rb.readInterpolated(output, 7, 2.25f);
+      for(int i = 0; i < 7; i++)
+      {
+        // the buffer starts with 0s (not part of the ramp)
+        if(input[i] >= 3)
+        {
+          ASSERT_FLOAT_EQ(input[i] - 2.25f, output[i]) << "block=" << block << " i=" << i;
+        }
+      }
+
+      // integer delay is the same as read
+      float expected[7];
+      rb.read(expected, 7, 3);
+      rb.readInterpolated(output, 7, 3.0f);
+      for(int i = 0; i < 7; i++)
+        ASSERT_FLOAT_EQ(expected[i], output[i]);
+    }
+  }
+}
+
+// RingBuffer - non trivially copyable type
+TEST(RingBuffer, nonTrivial)
+{
+  RingBuffer<std::string> rb{3};
+  ASSERT_EQ(4, rb.getCapacity());
+  std::string block[] = {"a", "b", "c", "d", "e"};
+  rb.write(block, 3);
+  rb.write(block + 3, 2);
+  std::string out[4];
+  rb.read(out, 4, 0);
+  ASSERT_EQ("b", out[0]);
+  ASSERT_EQ("e", out[3]);
+}
+
+}
@@ -553,6 +553,94 @@ TEST(SingleElementQueueTest, Atomic)
 
 }
 
+///////////////////////////////////////////
+// SpinLock tests
+///////////////////////////////////////////
+
+// SpinLockTest - TryAcquire
+TEST(SpinLockTest, TryAcquire)
+{
+  SpinLock spinLock{};
+  ASSERT_EQ(0u, spinLock.getContentionCount());
+
+  {
+    auto lock = spinLock.tryAcquire();
+    ASSERT_TRUE(lock.isLocked());
+
+    // already locked => fails right away
+    auto lock2 = spinLock.tryAcquire();
+    ASSERT_FALSE(lock2);
+    ASSERT_EQ(1u, spinLock.getContentionCount());
+  }
+
+  // released when out of scope
+  {
+    auto lock = spinLock.acquire();
+    ASSERT_TRUE(lock);
+  }
+  ASSERT_TRUE(spinLock.tryAcquire());
+  ASSERT_EQ(1u, spinLock.getContentionCount());
+
+  AtomicValue<MyTestValue> value{std::make_unique<MyTestValue>(3)};
+  ASSERT_TRUE(value.trySet(MyTestValue{4}));
+  MyTestValue v{};
+  ASSERT_TRUE(value.tryGet(v));
+  ASSERT_EQ(4, v.fValue);
+  ASSERT_EQ(0u, value.getLockContentionCount());
+
+  SingleElementQueue<MyTestValue> queue{};
+  ASSERT_FALSE(queue.tryPop(v));
+  ASSERT_TRUE(queue.tryPush(MyTestValue{5}));
+  ASSERT_TRUE(queue.tryPop(v));
+  ASSERT_EQ(5, v.fValue);
+  ASSERT_FALSE(queue.tryPop(v));
+}
+
+// SpinLockTest - MultiThreadSafe
+TEST(SpinLockTest, MultiThreadSafe)
+{
+  constexpr int N = 10000;
+  constexpr int M = 4;
+
+  SpinLock spinLock{};
+
+  // on purpose not atomic
+  int counter = 0;
+  std::atomic<int> tryAcquireCounter{0};
+
+  auto increment = [&] {
+    for(int i = 0; i < N; i++)
+    {
+      auto lock = spinLock.acquire();
+      counter++;
+    }
+  };
+
+  auto tryIncrement = [&] {
+    for(int i = 0; i < N; i++)
+    {
+      auto lock = spinLock.tryAcquire();
+      if(lock)
+      {
+        counter++;
+        tryAcquireCounter++;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads{};
+  for(int i = 0; i < M; i++)
+  {
+    threads.emplace_back(increment);
+    threads.emplace_back(tryIncrement);
+  }
+
+  for(auto &t: threads)
+    t.join();
+
+  ASSERT_EQ(N * M + tryAcquireCounter.load(), counter);
+}
+
 }
 }
 }
@@ -251,6 +251,24 @@ TEST(LockFreeSingleElementQueueTest, SingleThreadCorrectBehavior)
   ASSERT_EQ(0, MyTestValue::instanceCounter.load());
 }
 
+// LockFreeSingleElementQueueTest - Acquire
+TEST(LockFreeSingleElementQueueTest, Acquire)
+{
+  SingleElementQueue<MyTestValue> queue{};
+
+  auto element = queue.acquire();
+  element->fValue = 3;
+  ASSERT_EQ(element, queue.acquire());
+  ASSERT_TRUE(queue.isEmpty());
+
+  queue.pushAcquired();
+  ASSERT_FALSE(queue.isEmpty());
+
+  // same element (no copy)
+  ASSERT_EQ(element, queue.pop());
+  ASSERT_EQ(3, queue.last()->fValue);
+}
+
 // LockFreeSingleElementQueueTest - MultiThreadSafe
 TEST(LockFreeSingleElementQueueTest, MultiThreadSafe)
 {
@@ -436,6 +454,416 @@ TEST(LockFreeSingleElementQueueTest, MultiThreadSafe)
 //
 //}
 
+///////////////////////////////////////////
+// SeqLockAtomicValue tests
+///////////////////////////////////////////
+
+struct SmallValue
+{
+  int32_t fValues[4];
+};
+
+// the seqlock implementation is selected for small trivially copyable types only
+static_assert(std::is_base_of_v<SeqLockAtomicValue<SmallValue>, AtomicValue<SmallValue>>);
+static_assert(std::is_base_of_v<SeqLockAtomicValue<double>, AtomicValue<double>>);
+static_assert(!std::is_base_of_v<SeqLockAtomicValue<SmallValue>, AtomicValue<MyTestValue>>);
+static_assert(!use_seq_lock_atomic_value_v<char[kSeqLockMaxSize + 1]>);
+
+// LockFreeSeqLockAtomicValueTest - SingleThreadCorrectBehavior
+TEST(LockFreeSeqLockAtomicValueTest, SingleThreadCorrectBehavior)
+{
+  AtomicValue<SmallValue> value{SmallValue{{1, 2, 3, 4}}};
+  ASSERT_TRUE(value.__isLockFree());
+
+  ASSERT_EQ(3, value.get()->fValues[2]);
+
+  value.set(SmallValue{{5, 6, 7, 8}});
+  SmallValue v{};
+  value.get(v);
+  ASSERT_EQ(8, v.fValues[3]);
+
+  // update modifies the last value set
+  value.update([](SmallValue *oValue) { oValue->fValues[0] = 10; });
+  ASSERT_EQ(10, value.getCopy().fValues[0]);
+  ASSERT_EQ(6, value.getCopy().fValues[1]);
+
+  ASSERT_FALSE(value.updateIf([](SmallValue *oValue) { return false; }));
+  ASSERT_TRUE(value.updateIf([](SmallValue *oValue) { oValue->fValues[1] = 11; return true; }));
+  ASSERT_EQ(11, value.get()->fValues[1]);
+
+  // size which is not a multiple of the internal word size
+  struct OddSize { char fChars[11]; };
+  AtomicValue<OddSize> chars{OddSize{}};
+  chars.update([](OddSize *oValue) { std::strcpy(oValue->fChars, "0123456789"); });
+  ASSERT_STREQ("0123456789", chars.get()->fChars);
+}
+
+// LockFreeSeqLockAtomicValueTest - Atomic
+TEST(LockFreeSeqLockAtomicValueTest, Atomic)
+{
+  constexpr int N = 100000;
+
+  AtomicValue<SmallValue> value{SmallValue{{0, 0, 0, 0}}};
+
+  auto processing = [&value] {
+    for(int i = 1; i <= N; i++)
+      value.set(SmallValue{{i, i, i, i}});
+  };
+
+  std::thread processingThread{processing};
+
+  // the value is always consistent and never goes back in time
+  int last = 0;
+  while(last < N)
+  {
+    auto v = value.get();
+    ASSERT_EQ(v->fValues[0], v->fValues[1]);
+    ASSERT_EQ(v->fValues[0], v->fValues[2]);
+    ASSERT_EQ(v->fValues[0], v->fValues[3]);
+    ASSERT_TRUE(v->fValues[0] >= last);
+    last = v->fValues[0];
+    if(last < N)
+      std::this_thread::yield();
+  }
+
+  processingThread.join();
+}
+
+///////////////////////////////////////////
+// SPSCQueue tests
+///////////////////////////////////////////
+
+// LockFreeSPSCQueueTest - SingleThreadCorrectBehavior
+TEST(LockFreeSPSCQueueTest, SingleThreadCorrectBehavior)
+{
+  SPSCQueue<MyTestValue> queue{3};
+  ASSERT_TRUE(queue.__isLockFree());
+
+  // capacity is rounded to the next power of 2
+  ASSERT_EQ(4u, queue.getCapacity());
+  ASSERT_TRUE(queue.isEmpty());
+  ASSERT_EQ(nullptr, queue.front());
+
+  MyTestValue v{7};
+  ASSERT_FALSE(queue.pop(v));
+  ASSERT_EQ(7, v.fValue);
+
+  ASSERT_TRUE(queue.push(MyTestValue{1}));
+  ASSERT_TRUE(queue.updateAndPush([](MyTestValue *oValue) { oValue->fValue = 2; }));
+  ASSERT_FALSE(queue.updateAndPushIf([](MyTestValue *oValue) { oValue->fValue = 100; return false; }));
+  ASSERT_TRUE(queue.updateAndPushIf([](MyTestValue *oValue) { oValue->fValue = 3; return true; }));
+  ASSERT_TRUE(queue.push(MyTestValue{4}));
+  ASSERT_EQ(4u, queue.getSize());
+
+  // full
+  ASSERT_FALSE(queue.push(MyTestValue{5}));
+  ASSERT_FALSE(queue.updateAndPush([](MyTestValue *oValue) { oValue->fValue = 5; }));
+
+  // elements are popped in order
+  ASSERT_EQ(1, queue.front()->fValue);
+  queue.popFront();
+  ASSERT_TRUE(queue.pop(v));
+  ASSERT_EQ(2, v.fValue);
+  ASSERT_EQ(2u, queue.getSize());
+
+  // batch push (wraps around the end of the buffer, only 2 slots available)
+  MyTestValue values[3]{MyTestValue{5}, MyTestValue{6}, MyTestValue{7}};
+  ASSERT_EQ(2u, queue.push(values, 3));
+
+  // batch pop
+  std::vector<int> popped{};
+  ASSERT_EQ(3u, queue.popAll([&popped](MyTestValue *iValue) { popped.emplace_back(iValue->fValue); }, 3));
+  ASSERT_EQ((std::vector<int>{3, 4, 5}), popped);
+  ASSERT_EQ(1u, queue.popAll([&popped](MyTestValue *iValue) { popped.emplace_back(iValue->fValue); }));
+  ASSERT_EQ((std::vector<int>{3, 4, 5, 6}), popped);
+  ASSERT_TRUE(queue.isEmpty());
+  ASSERT_EQ(0u, queue.popAll([](MyTestValue *) { FAIL(); }));
+}
+
+// LockFreeSPSCQueueTest - MultiThreadOrder
+TEST(LockFreeSPSCQueueTest, MultiThreadOrder)
+{
+  constexpr int N = 10000;
+
+  struct Chunk
+  {
+    int fValue{0};
+    int fArray[16]{};
+  };
+
+  SPSCQueue<Chunk> queue{64};
+
+  auto processing = [&queue] {
+    int i = 0;
+    while(i < N)
+    {
+      if(queue.updateAndPush([i](Chunk *oChunk) {
+        oChunk->fValue = i;
+        for(auto &v: oChunk->fArray)
+          v = i;
+      }))
+        i++;
+      else
+        std::this_thread::yield();
+    }
+  };
+
+  std::thread processingThread{processing};
+
+  int expected = 0;
+  while(expected < N)
+  {
+    auto count = queue.popAll([&expected](Chunk *iChunk) {
+      ASSERT_EQ(expected, iChunk->fValue);
+      for(auto v: iChunk->fArray)
+        ASSERT_EQ(expected, v);
+      expected++;
+    });
+
+    if(count == 0)
+      std::this_thread::yield();
+  }
+
+  processingThread.join();
+
+  ASSERT_TRUE(queue.isEmpty());
+}
+
+///////////////////////////////////////////
+// PooledQueue tests
+///////////////////////////////////////////
+
+// counts the number of copies (to make sure elements are never copied once the pool is created)
+struct CopyCountingValue
+{
+  CopyCountingValue() = default;
+  CopyCountingValue(CopyCountingValue const &iOther) : fValue{iOther.fValue} { fCopyCount++; }
+  CopyCountingValue &operator=(CopyCountingValue const &iOther) { fValue = iOther.fValue; fCopyCount++; return *this; }
+
+  int fValue{0};
+  static inline int fCopyCount = 0;
+};
+
+// LockFreePooledQueueTest - SingleThreadCorrectBehavior
+TEST(LockFreePooledQueueTest, SingleThreadCorrectBehavior)
+{
+  PooledQueue<CopyCountingValue> queue{3, CopyCountingValue{}};
+  ASSERT_TRUE(queue.__isLockFree());
+  ASSERT_EQ(4u, queue.getPoolSize());
+  CopyCountingValue::fCopyCount = 0;
+
+  ASSERT_TRUE(queue.isEmpty());
+  ASSERT_EQ(nullptr, queue.pop());
+  ASSERT_EQ(0, queue.last()->fValue);
+
+  // acquire returns the same element until pushed
+  auto element = queue.acquire();
+  ASSERT_TRUE(element != nullptr);
+  element->fValue = 1;
+  ASSERT_EQ(element, queue.acquire());
+  ASSERT_TRUE(queue.pushAcquired());
+  ASSERT_FALSE(queue.pushAcquired());
+  ASSERT_EQ(1u, queue.getSize());
+
+  // the pool is exhausted after capacity elements
+  ASSERT_TRUE(queue.updateAndPush([](CopyCountingValue *oValue) { oValue->fValue = 2; }));
+  ASSERT_FALSE(queue.updateAndPushIf([](CopyCountingValue *oValue) { oValue->fValue = 3; return false; }));
+  ASSERT_TRUE(queue.updateAndPushIf([](CopyCountingValue *oValue) { return oValue->fValue == 3; }));
+  ASSERT_EQ(3u, queue.getSize());
+  ASSERT_EQ(nullptr, queue.acquire());
+  ASSERT_FALSE(queue.updateAndPush([](CopyCountingValue *oValue) { FAIL(); }));
+
+  // pop returns the element pushed (not a copy of it)
+  auto popped = queue.pop();
+  ASSERT_EQ(element, popped);
+  ASSERT_EQ(1, popped->fValue);
+  ASSERT_EQ(popped, queue.last());
+
+  // the previously popped element is returned to the pool on the next pop
+  ASSERT_EQ(2, queue.pop()->fValue);
+  ASSERT_TRUE(queue.updateAndPush([](CopyCountingValue *oValue) { oValue->fValue = 4; }));
+  ASSERT_EQ(3, queue.pop()->fValue);
+  ASSERT_EQ(4, queue.pop()->fValue);
+  ASSERT_EQ(nullptr, queue.pop());
+  ASSERT_EQ(4, queue.last()->fValue);
+  ASSERT_TRUE(queue.isEmpty());
+
+  ASSERT_EQ(0, CopyCountingValue::fCopyCount);
+}
+
+// LockFreePooledQueueTest - MultiThreadOrder
+TEST(LockFreePooledQueueTest, MultiThreadOrder)
+{
+  constexpr int N = 10000;
+
+  struct Frame
+  {
+    int fValue{0};
+    int fArray[1024]{};
+  };
+
+  PooledQueue<Frame> queue{4, Frame{}};
+
+  auto processing = [&queue] {
+    int i = 0;
+    while(i < N)
+    {
+      // fill the frame in 2 steps (as if it were done across 2 processing calls)
+      auto frame = queue.acquire();
+      if(frame)
+      {
+        frame->fValue = i;
+        for(auto &v: frame->fArray)
+          v = i;
+        queue.pushAcquired();
+        i++;
+      }
+      else
+        std::this_thread::yield();
+    }
+  };
+
+  std::thread processingThread{processing};
+
+  int expected = 0;
+  while(expected < N)
+  {
+    auto frame = queue.pop();
+    if(frame)
+    {
+      ASSERT_EQ(expected, frame->fValue);
+      for(auto v: frame->fArray)
+        ASSERT_EQ(expected, v);
+      expected++;
+    }
+    else
+      std::this_thread::yield();
+  }
+
+  processingThread.join();
+
+  ASSERT_TRUE(queue.isEmpty());
+}
+
+///////////////////////////////////////////
+// MPSCSingleElementQueue / MPSCAtomicValue tests
+///////////////////////////////////////////
+
+// LockFreeMPSCSingleElementQueueTest - SingleThreadCorrectBehavior
+TEST(LockFreeMPSCSingleElementQueueTest, SingleThreadCorrectBehavior)
+{
+  MPSCSingleElementQueue<MyTestValue> queue{2};
+  ASSERT_TRUE(queue.__isLockFree());
+  ASSERT_EQ(2u, queue.getMaxProducers());
+
+  ASSERT_TRUE(queue.isEmpty());
+  ASSERT_EQ(nullptr, queue.pop());
+  ASSERT_EQ(0, queue.last()->fValue);
+
+  // only the latest value is kept
+  ASSERT_TRUE(queue.push(MyTestValue{1}));
+  ASSERT_TRUE(queue.updateAndPush([](MyTestValue *oValue) { oValue->fValue = 2; }));
+  ASSERT_FALSE(queue.updateAndPushIf([](MyTestValue *oValue) { oValue->fValue = 3; return false; }));
+  ASSERT_FALSE(queue.isEmpty());
+  ASSERT_EQ(2, queue.pop()->fValue);
+  ASSERT_TRUE(queue.isEmpty());
+  ASSERT_EQ(nullptr, queue.pop());
+  ASSERT_EQ(2, queue.last()->fValue);
+  ASSERT_EQ(2, queue.popOrLast()->fValue);
+
+  ASSERT_TRUE(queue.push(MyTestValue{4}));
+  MyTestValue v{};
+  ASSERT_TRUE(queue.pop(v));
+  ASSERT_EQ(4, v.fValue);
+  ASSERT_FALSE(queue.pop(v));
+
+  // not empty on creation
+  MPSCSingleElementQueue<MyTestValue> queue2{std::make_unique<MyTestValue>(5)};
+  ASSERT_FALSE(queue2.isEmpty());
+  ASSERT_EQ(5, queue2.pop()->fValue);
+}
+
+// LockFreeMPSCSingleElementQueueTest - MultiProducerSafe
+TEST(LockFreeMPSCSingleElementQueueTest, MultiProducerSafe)
+{
+  constexpr int N = 10000;
+  constexpr int kNumProducers = 3;
+
+  struct Chunk
+  {
+    int fProducer{-1};
+    int fValue{-1};
+    int fArray[16]{};
+  };
+
+  MPSCSingleElementQueue<Chunk> queue{kNumProducers};
+
+  std::atomic<int> running{kNumProducers};
+
+  auto producer = [&queue, &running](int iProducer) {
+    for(int i = 0; i < N; i++)
+    {
+      ASSERT_TRUE(queue.updateAndPush([iProducer, i](Chunk *oChunk) {
+        oChunk->fProducer = iProducer;
+        oChunk->fValue = i;
+        for(auto &v: oChunk->fArray)
+          v = i;
+      }));
+      if(i % 16 == 0)
+        std::this_thread::yield();
+    }
+    running--;
+  };
+
+  std::vector<std::thread> producers{};
+  for(int i = 0; i < kNumProducers; i++)
+    producers.emplace_back(producer, i);
+
+  // each element popped is consistent and, for a given producer, more recent than the previous one
+  int last[kNumProducers] = {-1, -1, -1};
+  while(running > 0 || !queue.isEmpty())
+  {
+    auto chunk = queue.pop();
+    if(chunk)
+    {
+      ASSERT_TRUE(chunk->fProducer >= 0 && chunk->fProducer < kNumProducers);
+      for(auto v: chunk->fArray)
+        ASSERT_EQ(chunk->fValue, v);
+      ASSERT_TRUE(chunk->fValue > last[chunk->fProducer]);
+      last[chunk->fProducer] = chunk->fValue;
+    }
+    else
+      std::this_thread::yield();
+  }
+
+  for(auto &t: producers)
+    t.join();
+
+  // the last value of at least one producer has been popped
+  ASSERT_TRUE(last[0] == N - 1 || last[1] == N - 1 || last[2] == N - 1);
+}
+
+// LockFreeMPSCAtomicValueTest - SingleThreadCorrectBehavior
+TEST(LockFreeMPSCAtomicValueTest, SingleThreadCorrectBehavior)
+{
+  MPSCAtomicValue<MyTestValue> value{MyTestValue{3}};
+  ASSERT_TRUE(value.__isLockFree());
+  ASSERT_EQ(kDefaultMaxProducers, value.getMaxProducers());
+
+  ASSERT_EQ(3, value.get()->fValue);
+  ASSERT_EQ(3, value.getCopy().fValue);
+
+  ASSERT_TRUE(value.set(MyTestValue{4}));
+  ASSERT_TRUE(value.set(MyTestValue{5}));
+  ASSERT_EQ(5, value.get()->fValue);
+  ASSERT_EQ(5, value.get()->fValue);
+
+  ASSERT_TRUE(value.updateAndSet([](MyTestValue *oValue) { oValue->fValue = 6; }));
+  MyTestValue v{};
+  value.get(v);
+  ASSERT_EQ(6, v.fValue);
+}
+
 }
 }
 }
@@ -19,6 +19,7 @@
 #include <pongasoft/Utils/Lerp.h>
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 namespace pongasoft {
 namespace Utils {
@@ -53,6 +54,72 @@ TEST(Lerp, mapValue)
 
 }
 
+template<typename T>
+void testArrays()
+{
+  // testing various sizes to exercise the tails
+  for(int count: {0, 1, 3, 4, 5, 8, 17})
+  {
+    std::vector<T> values(static_cast<size_t>(count));
+    for(int i = 0; i < count; i++)
+      values[i] = static_cast<T>(-2.0 + 4.0 * i / std::max(count - 1, 1)); // [-2, 2]
+
+    std::vector<T> output(values.size());
+
+    // mapValues (clamped / not clamped)
+    Lerp<T, T, T>::mapValues(values.data(), output.data(), count, -1, 1, 0, 7);
+    for(int i = 0; i < count; i++)
+      ASSERT_NEAR((Lerp<T, T, T>::mapValue(values[i], -1, 1, 0, 7)), output[i], 1e-6) << i;
+
+    Lerp<T, T, T>::mapValues(values.data(), output.data(), count, 1, -1, 0, 100, false);
+    for(int i = 0; i < count; i++)
+      ASSERT_NEAR((Lerp<T, T, T>::mapValue(values[i], 1, -1, 0, 100, false)), output[i], 1e-5) << i;
+
+    // degenerate ranges
+    Lerp<T, T, T>::mapValues(values.data(), output.data(), count, 0, 0, 3, 5);
+    for(int i = 0; i < count; i++)
+      ASSERT_EQ(values[i] <= 0 ? 3 : 5, output[i]);
+    Lerp<T, T, T>::mapValues(values.data(), output.data(), count, -1, 1, 4, 4);
+    for(int i = 0; i < count; i++)
+      ASSERT_EQ(4, output[i]);
+
+    // computeY (in place)
+    auto lerp = Lerp<T, T, T>::mapRange(10, 20, 100, 200);
+    output = values;
+    lerp.computeY(output.data(), output.data(), count);
+    for(int i = 0; i < count; i++)
+      ASSERT_NEAR(lerp.computeY(values[i]), output[i], 1e-4) << i;
+
+    // clampRange (order of the bounds does not matter)
+    clampRange(values.data(), output.data(), count, static_cast<T>(1), static_cast<T>(-0.5));
+    for(int i = 0; i < count; i++)
+      ASSERT_EQ(clampRange(values[i], static_cast<T>(-0.5), static_cast<T>(1)), output[i]);
+  }
+}
+
+// Lerp - arrays
+TEST(Lerp, arrays)
+{
+  testArrays<float>();
+  testArrays<double>();
+
+  float sp[] = {-1, 0, 0.5f, 1, 2};
+  mapValuesSP(sp, sp, 5, -1, 1, 0, 10);
+  ASSERT_EQ((std::vector<float>{0, 5, 7.5f, 10, 10}), std::vector<float>(sp, sp + 5));
+
+  double dp[] = {-1, 0, 0.5, 1, 2};
+  mapValuesDP(dp, dp, 5, -1, 1, 10, 0, false);
+  ASSERT_EQ((std::vector<double>{10, 5, 2.5, 0, -5}), std::vector<double>(dp, dp + 5));
+
+  // not vectorized (mixed types)
+  int ints[] = {0, 5, 10, 15};
+  double mapped[4];
+  DPLerpX<int>::mapValues(ints, mapped, 4, 0, 10, 0.0, 1.0);
+  ASSERT_EQ((std::vector<double>{0, 0.5, 1.0, 1.0}), std::vector<double>(mapped, mapped + 4));
+  clampRange(ints, ints, 4, 12, 3);
+  ASSERT_EQ((std::vector<int>{3, 5, 10, 12}), std::vector<int>(ints, ints + 4));
+}
+
 }
 }
 }
\ No newline at end of file
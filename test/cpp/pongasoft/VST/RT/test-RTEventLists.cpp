@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+#include <pongasoft/VST/RT/RTEventLists.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace pongasoft::VST::RT::TestRTEventLists {
+
+// returns the sample offsets of the events
+std::vector<int32> getOffsets(RTEventList &iEvents)
+{
+  std::vector<int32> res{};
+  for(int32 i = 0; i < iEvents.getEventCount(); i++)
+  {
+    Event e{};
+    iEvents.getEvent(i, e);
+    res.emplace_back(e.sampleOffset);
+  }
+  return res;
+}
+
+// returns the (offset, value) points of the queue
+std::vector<std::pair<int32, ParamValue>> getPoints(IParamValueQueue *iQueue)
+{
+  std::vector<std::pair<int32, ParamValue>> res{};
+  for(int32 i = 0; i < iQueue->getPointCount(); i++)
+  {
+    int32 sampleOffset;
+    ParamValue value;
+    iQueue->getPoint(i, sampleOffset, value);
+    res.emplace_back(sampleOffset, value);
+  }
+  return res;
+}
+
+// RTEventList - copyFrom / moveTo
+TEST(RTEventList, copyFromMoveTo)
+{
+  RTEventList host{};
+  host.setCapacity(8);
+  for(auto offset: {0, 5, 10, 15})
+  {
+    Event e{};
+    e.sampleOffset = offset;
+    ASSERT_EQ(kResultOk, host.addEvent(e));
+  }
+
+  // window [5, 15[ shifted by -5
+  RTEventList list{};
+  list.setCapacity(3);
+  ASSERT_TRUE(list.copyFrom(&host, 5, 15, -5));
+  ASSERT_EQ((std::vector<int32>{0, 5}), getOffsets(list));
+
+  // capacity reached
+  ASSERT_FALSE(list.copyFrom(&host, kMinSampleOffset, kMaxSampleOffset, 0));
+  ASSERT_EQ((std::vector<int32>{0, 5, 0}), getOffsets(list));
+
+  // moves the events before 5 (shifted by 100) and the remaining ones become relative to 5
+  list.clear();
+  list.copyFrom(&host, kMinSampleOffset, 15, 0);
+  RTEventList out{};
+  out.setCapacity(8);
+  ASSERT_TRUE(list.moveTo(&out, 5, 100));
+  ASSERT_EQ((std::vector<int32>{100}), getOffsets(out));
+  ASSERT_EQ((std::vector<int32>{0, 5}), getOffsets(list));
+}
+
+// RTParameterChanges - copyFrom / moveTo
+TEST(RTParameterChanges, copyFromMoveTo)
+{
+  RTParameterChanges host{};
+  host.setCapacity(2, 4);
+  int32 index;
+  auto queue = host.addParameterData(1, index);
+  queue->addPoint(0, 0.1, index);
+  queue->addPoint(10, 0.2, index);
+  host.addParameterData(2, index)->addPoint(12, 0.3, index);
+  ASSERT_EQ(nullptr, host.addParameterData(3, index));
+  ASSERT_EQ(3, host.getTotalPointCount());
+
+  // only queues with a point in [5, 20[ are added
+  RTParameterChanges changes{};
+  changes.setCapacity(2, 4);
+  ASSERT_TRUE(changes.copyFrom(&host, 5, 20, -5));
+  ASSERT_EQ(2, changes.getParameterCount());
+  ASSERT_EQ((std::vector<std::pair<int32, ParamValue>>{{5, 0.2}}), getPoints(changes.getParameterData(0)));
+  ASSERT_EQ((std::vector<std::pair<int32, ParamValue>>{{7, 0.3}}), getPoints(changes.getParameterData(1)));
+
+  // the queue of param 1 becomes empty and is removed
+  RTParameterChanges out{};
+  out.setCapacity(2, 4);
+  ASSERT_TRUE(changes.moveTo(&out, 6, 0));
+  ASSERT_EQ(1, out.getParameterCount());
+  ASSERT_EQ(1u, out.getParameterData(0)->getParameterId());
+  ASSERT_EQ(1, changes.getParameterCount());
+  ASSERT_EQ(2u, changes.getParameterData(0)->getParameterId());
+  ASSERT_EQ((std::vector<std::pair<int32, ParamValue>>{{1, 0.3}}), getPoints(changes.getParameterData(0)));
+}
+
+// RTParamValueQueue - points are sorted and the last value is kept when full
+TEST(RTParamValueQueue, addPoint)
+{
+  RTParamValueQueue queue{};
+  queue.setCapacity(3);
+  queue.reset(7);
+
+  int32 index;
+  queue.addPoint(10, 0.1, index);
+  queue.addPoint(0, 0.2, index);
+  ASSERT_EQ(0, index);
+  queue.addPoint(10, 0.3, index);
+  ASSERT_EQ((std::vector<std::pair<int32, ParamValue>>{{0, 0.2}, {10, 0.3}}), getPoints(&queue));
+
+  queue.addPoint(20, 0.4, index);
+  queue.addPoint(30, 0.5, index);
+  ASSERT_EQ((std::vector<std::pair<int32, ParamValue>>{{0, 0.2}, {10, 0.3}, {30, 0.5}}), getPoints(&queue));
+  ASSERT_EQ(kResultFalse, queue.addPoint(5, 0.6, index));
+}
+
+}
@@ -0,0 +1,930 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include <pongasoft/VST/RT/RTProcessor.h>
+#include <pongasoft/VST/RT/TRTProcessor.h>
+#include <pongasoft/VST/DenormalGuard.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace pongasoft::VST::RT::TestRTProcessor {
+
+struct TestParameters : public Parameters {};
+
+struct TestRTState : public RTState
+{
+  explicit TestRTState(TestParameters const &iParams) : RTState(iParams) {}
+};
+
+// records the floating point mode during processInputs
+class TestRTProcessor : public RTProcessor
+{
+public:
+  TestRTProcessor() : RTProcessor(FUID{}), fState{fParameters} {}
+
+  using RTProcessor::enableDenormalsFlushing;
+  using RTProcessor::isFlushingDenormals;
+
+  RTState *getRTState() override { return &fState; }
+
+  tresult processInputs32Bits(ProcessData &data) override
+  {
+    fNumCalls++;
+    fFlushingDenormals = DenormalGuard::isFlushingDenormals();
+    return kResultOk;
+  }
+
+  TestParameters fParameters{};
+  TestRTState fState;
+  int fNumCalls{0};
+  bool fFlushingDenormals{false};
+};
+
+// RTProcessor - enableDenormalsFlushing
+TEST(RTProcessor, enableDenormalsFlushing)
+{
+  if(!DenormalGuard::isSupported())
+    GTEST_SKIP() << "Flushing denormals not supported on this platform";
+
+  TestRTProcessor processor{};
+  ProcessData data{};
+
+  ASSERT_FALSE(DenormalGuard::isFlushingDenormals());
+
+  // disabled by default
+  ASSERT_FALSE(processor.isFlushingDenormals());
+  ASSERT_EQ(kResultOk, processor.process(data));
+  ASSERT_EQ(1, processor.fNumCalls);
+  ASSERT_FALSE(processor.fFlushingDenormals);
+
+  // enabled => set during processInputs and restored after
+  processor.enableDenormalsFlushing();
+  ASSERT_TRUE(processor.isFlushingDenormals());
+  ASSERT_EQ(kResultOk, processor.process(data));
+  ASSERT_EQ(2, processor.fNumCalls);
+  ASSERT_TRUE(processor.fFlushingDenormals);
+  ASSERT_FALSE(DenormalGuard::isFlushingDenormals());
+
+  // disabled again
+  processor.enableDenormalsFlushing(false);
+  ASSERT_EQ(kResultOk, processor.process(data));
+  ASSERT_FALSE(processor.fFlushingDenormals);
+  ASSERT_FALSE(DenormalGuard::isFlushingDenormals());
+}
+
+struct AutomationParameters : public Parameters
+{
+  RawVstParam fParam;
+
+  AutomationParameters()
+  {
+    fParam = raw(1, STR16("param")).defaultValue(0.1).add();
+  }
+};
+
+struct AutomationRTState : public RTState
+{
+  RTRawVstParam fParam;
+
+  explicit AutomationRTState(AutomationParameters const &iParams) : RTState(iParams), fParam{add(iParams.fParam)} {}
+};
+
+// records what processInputs receives and produces one output event and one output parameter change per call
+class EventsRTProcessor : public RTProcessor
+{
+public:
+  struct Call
+  {
+    int32 fNumSamples{};
+    ParamValue fParamValue{};
+    std::vector<int32> fEventOffsets{};
+    std::vector<int32> fParameterChangeOffsets{};
+  };
+
+  EventsRTProcessor() : RTProcessor(FUID{}), fState{fParameters} {}
+
+  using RTProcessor::enableSampleAccurateAutomation;
+  using RTProcessor::enableFixedBlockProcessing;
+
+  RTState *getRTState() override { return &fState; }
+
+  tresult processInputs32Bits(ProcessData &data) override
+  {
+    Call call{};
+    call.fNumSamples = data.numSamples;
+    call.fParamValue = *fState.fParam;
+
+    if(data.inputEvents)
+    {
+      for(int32 i = 0; i < data.inputEvents->getEventCount(); i++)
+      {
+        Event e{};
+        data.inputEvents->getEvent(i, e);
+        call.fEventOffsets.emplace_back(e.sampleOffset);
+      }
+    }
+
+    if(data.inputParameterChanges)
+    {
+      for(int32 i = 0; i < data.inputParameterChanges->getParameterCount(); i++)
+      {
+        auto queue = data.inputParameterChanges->getParameterData(i);
+        for(int32 j = 0; j < queue->getPointCount(); j++)
+        {
+          int32 sampleOffset;
+          ParamValue value;
+          queue->getPoint(j, sampleOffset, value);
+          call.fParameterChangeOffsets.emplace_back(sampleOffset);
+        }
+      }
+    }
+
+    fCalls.emplace_back(call);
+
+    if(data.outputEvents)
+    {
+      Event e{};
+      e.sampleOffset = 1;
+      data.outputEvents->addEvent(e);
+    }
+
+    if(data.outputParameterChanges)
+    {
+      int32 index;
+      auto queue = data.outputParameterChanges->addParameterData(100, index);
+      queue->addPoint(2, 0.5, index);
+    }
+
+    return fCalls.size() == 1 ? fFirstCallResult : kResultOk;
+  }
+
+  AutomationParameters fParameters{};
+  AutomationRTState fState;
+  std::vector<Call> fCalls{};
+  tresult fFirstCallResult{kResultOk};
+};
+
+// returns the sample offsets of the events
+std::vector<int32> getEventOffsets(RTEventList &iEvents)
+{
+  std::vector<int32> res{};
+  for(int32 i = 0; i < iEvents.getEventCount(); i++)
+  {
+    Event e{};
+    iEvents.getEvent(i, e);
+    res.emplace_back(e.sampleOffset);
+  }
+  return res;
+}
+
+// returns the sample offsets of the points of the (first) queue
+std::vector<int32> getPointOffsets(RTParameterChanges &iChanges)
+{
+  std::vector<int32> res{};
+  if(iChanges.getParameterCount() > 0)
+  {
+    auto queue = iChanges.getParameterData(0);
+    for(int32 i = 0; i < queue->getPointCount(); i++)
+    {
+      int32 sampleOffset;
+      ParamValue value;
+      queue->getPoint(i, sampleOffset, value);
+      res.emplace_back(sampleOffset);
+    }
+  }
+  return res;
+}
+
+// adds a note on event
+void addNoteOn(RTEventList &oEvents, int32 iSampleOffset)
+{
+  Event e{};
+  e.sampleOffset = iSampleOffset;
+  e.type = Event::kNoteOnEvent;
+  e.noteOn.pitch = 60;
+  oEvents.addEvent(e);
+}
+
+// RTProcessor - sample accurate automation: events and parameter changes are split across sub-blocks
+TEST(RTProcessor, sampleAccurateAutomationEvents)
+{
+  EventsRTProcessor processor{};
+  ASSERT_EQ(kResultOk, processor.initialize(nullptr));
+  processor.enableSampleAccurateAutomation(8);
+  ASSERT_EQ(kResultOk, processor.setActive(true));
+
+  RTParameterChanges inputChanges{};
+  inputChanges.setCapacity(4, 4);
+  int32 index;
+  inputChanges.addParameterData(1, index)->addPoint(10, 0.6, index);
+
+  RTEventList inputEvents{};
+  inputEvents.setCapacity(4);
+  addNoteOn(inputEvents, 5);
+  addNoteOn(inputEvents, 20);
+
+  RTEventList outputEvents{};
+  outputEvents.setCapacity(8);
+  RTParameterChanges outputChanges{};
+  outputChanges.setCapacity(4, 8);
+
+  ProcessData data{};
+  data.symbolicSampleSize = kSample32;
+  data.numSamples = 32;
+  data.inputParameterChanges = &inputChanges;
+  data.inputEvents = &inputEvents;
+  data.outputEvents = &outputEvents;
+  data.outputParameterChanges = &outputChanges;
+
+  // the result of the first failing sub-block is returned but all sub-blocks are processed
+  processor.fFirstCallResult = kResultFalse;
+  ASSERT_EQ(kResultFalse, processor.process(data));
+
+  // 2 sub-blocks: [0, 10[ and [10, 32[
+  ASSERT_EQ(2u, processor.fCalls.size());
+
+  auto &first = processor.fCalls[0];
+  ASSERT_EQ(10, first.fNumSamples);
+  ASSERT_DOUBLE_EQ(0.1, first.fParamValue);
+  ASSERT_EQ(std::vector<int32>{5}, first.fEventOffsets);
+  ASSERT_TRUE(first.fParameterChangeOffsets.empty());
+
+  // each event is delivered once, relative to its sub-block
+  auto &second = processor.fCalls[1];
+  ASSERT_EQ(22, second.fNumSamples);
+  ASSERT_DOUBLE_EQ(0.6, second.fParamValue);
+  ASSERT_EQ(std::vector<int32>{10}, second.fEventOffsets);
+  ASSERT_EQ(std::vector<int32>{0}, second.fParameterChangeOffsets);
+
+  // what is produced by each sub-block is relative to the frame
+  ASSERT_EQ((std::vector<int32>{1, 11}), getEventOffsets(outputEvents));
+  ASSERT_EQ((std::vector<int32>{2, 12}), getPointOffsets(outputChanges));
+}
+
+// same as EventsRTProcessor with a stereo bus (the outputs being a copy of the inputs)
+class FixedBlockRTProcessor : public EventsRTProcessor
+{
+public:
+  FixedBlockRTProcessor()
+  {
+    addAudioInput(nullptr, SpeakerArr::kStereo);
+    addAudioOutput(nullptr, SpeakerArr::kStereo);
+  }
+
+  tresult processInputs32Bits(ProcessData &data) override
+  {
+    for(int32 c = 0; c < data.outputs[0].numChannels; c++)
+      std::copy(data.inputs[0].channelBuffers32[c],
+                data.inputs[0].channelBuffers32[c] + data.numSamples,
+                data.outputs[0].channelBuffers32[c]);
+    return EventsRTProcessor::processInputs32Bits(data);
+  }
+};
+
+// RTProcessor - fixed block processing: odd frame sizes, latency and events / parameter changes timing
+TEST(RTProcessor, fixedBlockProcessing)
+{
+  constexpr int32 kBlockSize = 8;
+  constexpr int32 kMaxSamples = 8;
+
+  FixedBlockRTProcessor processor{};
+  ASSERT_EQ(kResultOk, processor.initialize(nullptr));
+  processor.enableFixedBlockProcessing(kBlockSize);
+
+  ProcessSetup setup{};
+  setup.symbolicSampleSize = kSample32;
+  setup.maxSamplesPerBlock = kMaxSamples;
+  setup.sampleRate = 44100;
+  ASSERT_EQ(kResultOk, processor.setupProcessing(setup));
+  ASSERT_EQ(kResultOk, processor.setActive(true));
+  ASSERT_EQ(static_cast<uint32>(kBlockSize), processor.getLatencySamples());
+
+  std::vector<Sample32> inputs[2] = {std::vector<Sample32>(kMaxSamples), std::vector<Sample32>(kMaxSamples)};
+  std::vector<Sample32> outputs[2] = {std::vector<Sample32>(kMaxSamples), std::vector<Sample32>(kMaxSamples)};
+  Sample32 *in[2] = {inputs[0].data(), inputs[1].data()};
+  Sample32 *out[2] = {outputs[0].data(), outputs[1].data()};
+
+  AudioBusBuffers inBus{};
+  inBus.numChannels = 2;
+  inBus.channelBuffers32 = in;
+  AudioBusBuffers outBus{};
+  outBus.numChannels = 2;
+  outBus.channelBuffers32 = out;
+
+  RTEventList inputEvents{};
+  inputEvents.setCapacity(4);
+  RTParameterChanges inputChanges{};
+  inputChanges.setCapacity(4, 4);
+  RTEventList outputEvents{};
+  outputEvents.setCapacity(8);
+  RTParameterChanges outputChanges{};
+  outputChanges.setCapacity(4, 8);
+
+  ProcessData data{};
+  data.symbolicSampleSize = kSample32;
+  data.numInputs = 1;
+  data.inputs = &inBus;
+  data.numOutputs = 1;
+  data.outputs = &outBus;
+  data.inputEvents = &inputEvents;
+  data.inputParameterChanges = &inputChanges;
+  data.outputEvents = &outputEvents;
+  data.outputParameterChanges = &outputChanges;
+
+  // the input is a ramp (1, 2, 3...) so that the output can be checked against the (absolute) time
+  int32 time = 0;
+  auto processFrame = [&](int32 iNumSamples, std::vector<int32> const &iEventOffsets) {
+    for(int32 i = 0; i < iNumSamples; i++)
+    {
+      inputs[0][i] = static_cast<Sample32>(time + i + 1);
+      inputs[1][i] = -inputs[0][i];
+    }
+    inputEvents.clear();
+    for(auto offset: iEventOffsets)
+      addNoteOn(inputEvents, offset);
+    outputEvents.clear();
+    outputChanges.clear();
+
+    data.numSamples = iNumSamples;
+    auto res = processor.process(data);
+
+    // the output is the input delayed by exactly the block size
+    for(int32 i = 0; i < iNumSamples; i++)
+    {
+      auto expected = std::max(time + i + 1 - kBlockSize, 0);
+      EXPECT_EQ(static_cast<Sample32>(expected), outputs[0][i]) << "time=" << time + i;
+      EXPECT_EQ(static_cast<Sample32>(-expected), outputs[1][i]) << "time=" << time + i;
+    }
+
+    time += iNumSamples;
+    inputChanges.clear();
+    return res;
+  };
+
+  // blocks: [0, 8[ completes at time 8 (frame 2), [8, 16[ at time 16 (frame 4), [16, 24[ at time 24 (frame 5)
+  ASSERT_EQ(kResultOk, processFrame(5, {2})); // time [0, 5[
+  ASSERT_TRUE(processor.fCalls.empty());
+  ASSERT_EQ(0, outputEvents.getEventCount());
+
+  ASSERT_EQ(kResultOk, processFrame(5, {2, 4})); // time [5, 10[ (events at time 7 and 9)
+  ASSERT_EQ(1u, processor.fCalls.size());
+  // the block emits an event at 1 (time 9 => offset 4 in this frame)
+  ASSERT_EQ(std::vector<int32>{4}, getEventOffsets(outputEvents));
+  // the block emits a parameter change at 2 (time 10 => next frame)
+  ASSERT_EQ(0, outputChanges.getParameterCount());
+
+  // no block completes in this frame: the event and the parameter change are not lost
+  int32 index;
+  inputChanges.addParameterData(1, index)->addPoint(3, 0.6, index);
+  ASSERT_EQ(kResultOk, processFrame(5, {2})); // time [10, 15[ (event at time 12, change at time 13)
+  ASSERT_EQ(1u, processor.fCalls.size());
+  ASSERT_EQ(0, outputEvents.getEventCount());
+  ASSERT_EQ(std::vector<int32>{0}, getPointOffsets(outputChanges));
+
+  ASSERT_EQ(kResultOk, processFrame(3, {})); // time [15, 18[
+  ASSERT_EQ(2u, processor.fCalls.size());
+  ASSERT_EQ(std::vector<int32>{2}, getEventOffsets(outputEvents)); // time 17
+
+  ASSERT_EQ(kResultOk, processFrame(7, {2})); // time [18, 25[ (event at time 20)
+  ASSERT_EQ(3u, processor.fCalls.size());
+  ASSERT_EQ(0, outputEvents.getEventCount()); // time 25 => next frame
+  ASSERT_EQ(std::vector<int32>{0}, getPointOffsets(outputChanges)); // time 18
+
+  ASSERT_EQ(kResultOk, processFrame(3, {})); // time [25, 28[
+  ASSERT_EQ(std::vector<int32>{0}, getEventOffsets(outputEvents));
+  ASSERT_EQ(std::vector<int32>{1}, getPointOffsets(outputChanges)); // time 26
+
+  // each event / parameter change is delivered once, relative to its block
+  for(auto &call: processor.fCalls)
+    ASSERT_EQ(kBlockSize, call.fNumSamples);
+  ASSERT_EQ((std::vector<int32>{2, 7}), processor.fCalls[0].fEventOffsets);
+  ASSERT_EQ((std::vector<int32>{1, 4}), processor.fCalls[1].fEventOffsets);
+  ASSERT_EQ(std::vector<int32>{5}, processor.fCalls[1].fParameterChangeOffsets);
+  ASSERT_EQ(std::vector<int32>{4}, processor.fCalls[2].fEventOffsets);
+  ASSERT_TRUE(processor.fCalls[0].fParameterChangeOffsets.empty());
+  ASSERT_TRUE(processor.fCalls[2].fParameterChangeOffsets.empty());
+
+  // unexpected bus configuration => the frame is processed directly and fixed block processing is disabled (no
+  // more latency) until the processor is activated again
+  processor.fCalls.clear();
+  inBus.numChannels = 1;
+  data.numSamples = 3;
+  ASSERT_EQ(kResultOk, processor.process(data));
+  ASSERT_EQ(1u, processor.fCalls.size());
+  ASSERT_EQ(3, processor.fCalls[0].fNumSamples);
+  ASSERT_EQ(0u, processor.getLatencySamples());
+
+  inBus.numChannels = 2;
+  ASSERT_EQ(kResultOk, processor.process(data));
+  ASSERT_EQ(2u, processor.fCalls.size());
+  ASSERT_EQ(3, processor.fCalls[1].fNumSamples);
+
+  ASSERT_EQ(kResultOk, processor.setActive(false));
+  ASSERT_EQ(kResultOk, processor.setActive(true));
+  ASSERT_EQ(static_cast<uint32>(kBlockSize), processor.getLatencySamples());
+}
+
+// outputs the input + 1 (never silent) and counts the calls
+class SilenceRTProcessor : public RTProcessor
+{
+public:
+  SilenceRTProcessor() : RTProcessor(FUID{}), fState{fParameters}
+  {
+    addAudioInput(nullptr, SpeakerArr::kStereo);
+    addAudioOutput(nullptr, SpeakerArr::kStereo);
+    enableSilenceBypass();
+  }
+
+  using RTProcessor::isBypassingSilence;
+
+  RTState *getRTState() override { return &fState; }
+
+  uint32 PLUGIN_API getTailSamples() override { return fTailSamples; }
+
+  tresult processInputs32Bits(ProcessData &data) override
+  {
+    fNumCalls++;
+    for(int32 c = 0; c < data.outputs[0].numChannels; c++)
+    {
+      for(int32 i = 0; i < data.numSamples; i++)
+        data.outputs[0].channelBuffers32[c][i] = data.inputs[0].channelBuffers32[c][i] + 1;
+    }
+    data.outputs[0].silenceFlags = 0;
+    return kResultOk;
+  }
+
+  AutomationParameters fParameters{};
+  AutomationRTState fState;
+  uint32 fTailSamples{10};
+  int fNumCalls{0};
+};
+
+// RTProcessor - silence bypass
+TEST(RTProcessor, silenceBypass)
+{
+  constexpr int32 kNumSamples = 8;
+
+  SilenceRTProcessor processor{};
+
+  ProcessSetup setup{};
+  setup.symbolicSampleSize = kSample32;
+  setup.maxSamplesPerBlock = kNumSamples;
+  setup.sampleRate = 44100;
+  ASSERT_EQ(kResultOk, processor.setupProcessing(setup));
+  ASSERT_EQ(kResultOk, processor.setActive(true));
+
+  std::vector<Sample32> inputs[2] = {std::vector<Sample32>(kNumSamples), std::vector<Sample32>(kNumSamples)};
+  std::vector<Sample32> outputs[2] = {std::vector<Sample32>(kNumSamples), std::vector<Sample32>(kNumSamples)};
+  Sample32 *in[2] = {inputs[0].data(), inputs[1].data()};
+  Sample32 *out[2] = {outputs[0].data(), outputs[1].data()};
+
+  AudioBusBuffers inBus{};
+  inBus.numChannels = 2;
+  inBus.channelBuffers32 = in;
+  AudioBusBuffers outBus{};
+  outBus.numChannels = 2;
+  outBus.channelBuffers32 = out;
+
+  RTParameterChanges inputChanges{};
+  inputChanges.setCapacity(1, 1);
+
+  ProcessData data{};
+  data.symbolicSampleSize = kSample32;
+  data.numSamples = kNumSamples;
+  data.numInputs = 1;
+  data.inputs = &inBus;
+  data.numOutputs = 1;
+  data.outputs = &outBus;
+  data.inputParameterChanges = &inputChanges;
+
+  auto processFrame = [&](Sample32 iInput) {
+    for(auto &input: inputs)
+      std::fill(input.begin(), input.end(), iInput);
+    inBus.silenceFlags = iInput == 0 ? 3 : 0;
+    return processor.process(data);
+  };
+
+  auto isOutputSilent = [&]() {
+    for(auto &output: outputs)
+    {
+      for(auto s: output)
+      {
+        if(s != 0)
+          return false;
+      }
+    }
+    return outBus.silenceFlags == 3;
+  };
+
+  ASSERT_EQ(kResultOk, processFrame(0.5f));
+  ASSERT_EQ(1, processor.fNumCalls);
+
+  // the tail (10 samples, measured from the first silent sample) spans 2 frames
+  ASSERT_EQ(kResultOk, processFrame(0));
+  ASSERT_EQ(kResultOk, processFrame(0));
+  ASSERT_EQ(3, processor.fNumCalls);
+  ASSERT_FALSE(processor.isBypassingSilence());
+  ASSERT_FALSE(isOutputSilent());
+
+  // tail elapsed => bypassed: processInputs is no longer called and the outputs are cleared and flagged as silent
+  ASSERT_EQ(kResultOk, processFrame(0));
+  ASSERT_EQ(kResultOk, processFrame(0));
+  ASSERT_EQ(3, processor.fNumCalls);
+  ASSERT_TRUE(processor.isBypassingSilence());
+  ASSERT_TRUE(isOutputSilent());
+
+  // the host reuses the (same) buffers for something else in between => still cleared
+  for(auto &output: outputs)
+    std::fill(output.begin(), output.end(), 0.25f);
+  outBus.silenceFlags = 0;
+  ASSERT_EQ(kResultOk, processFrame(0));
+  ASSERT_EQ(3, processor.fNumCalls);
+  ASSERT_TRUE(isOutputSilent());
+
+  // a parameter change resumes processing (and is applied)
+  int32 index;
+  inputChanges.addParameterData(1, index)->addPoint(0, 0.7, index);
+  ASSERT_EQ(kResultOk, processFrame(0));
+  inputChanges.clear();
+  ASSERT_EQ(4, processor.fNumCalls);
+  ASSERT_FALSE(processor.isBypassingSilence());
+  ASSERT_FALSE(isOutputSilent());
+  ASSERT_DOUBLE_EQ(0.7, *processor.fState.fParam);
+
+  // ...until the tail has elapsed again
+  for(int i = 0; i < 3; i++)
+    ASSERT_EQ(kResultOk, processFrame(0));
+  ASSERT_EQ(6, processor.fNumCalls);
+  ASSERT_TRUE(processor.isBypassingSilence());
+  ASSERT_TRUE(isOutputSilent());
+
+  // a non silent input resumes processing
+  ASSERT_EQ(kResultOk, processFrame(0.5f));
+  ASSERT_EQ(7, processor.fNumCalls);
+  ASSERT_FALSE(processor.isBypassingSilence());
+  ASSERT_FLOAT_EQ(1.5f, outputs[0][0]);
+
+  // infinite tail => never bypassed
+  processor.fTailSamples = kInfiniteTail;
+  for(int i = 0; i < 5; i++)
+    ASSERT_EQ(kResultOk, processFrame(0));
+  ASSERT_EQ(12, processor.fNumCalls);
+  ASSERT_FALSE(processor.isBypassingSilence());
+}
+
+// the wet signal is silence => the outputs only contain the (delayed) dry signal
+class LatencyRTProcessor : public RTProcessor
+{
+public:
+  explicit LatencyRTProcessor(bool iAddLatencySource = true) : RTProcessor(FUID{}), fState{fParameters}
+  {
+    addAudioInput(nullptr, SpeakerArr::kStereo);
+    addAudioOutput(nullptr, SpeakerArr::kStereo);
+    if(iAddLatencySource)
+      addLatencySource(&fLookahead);
+    enableLatencyCompensation(16);
+  }
+
+  using RTProcessor::onGUIMessageTimer;
+  using RTProcessor::enableSilenceBypass;
+  using RTProcessor::isBypassingSilence;
+
+  RTState *getRTState() override { return &fState; }
+
+  bool isBypassed() const override { return fBypassed; }
+  double getDryMix() const override { return fDryMix; }
+
+  // ad hoc latency (on top of the latency source)
+  uint32 PLUGIN_API getLatencySamples() override { return RTProcessor::getLatencySamples() + fAdHocLatency; }
+
+  tresult notifyLatencyChanged() override
+  {
+    fNumLatencyChanged++;
+    return kResultOk;
+  }
+
+  tresult processInputs32Bits(ProcessData &data) override
+  {
+    for(int32 c = 0; c < data.outputs[0].numChannels; c++)
+      std::fill(data.outputs[0].channelBuffers32[c], data.outputs[0].channelBuffers32[c] + data.numSamples, 0);
+    return kResultOk;
+  }
+
+  TestParameters fParameters{};
+  TestRTState fState;
+  LatencySource fLookahead{3};
+  uint32 fAdHocLatency{0};
+  bool fBypassed{false};
+  double fDryMix{0};
+  int fNumLatencyChanged{0};
+};
+
+// RTProcessor - latency reporting and compensation
+TEST(RTProcessor, latencyCompensation)
+{
+  constexpr int32 kNumSamples = 8;
+
+  LatencyRTProcessor processor{};
+
+  ProcessSetup setup{};
+  setup.symbolicSampleSize = kSample32;
+  setup.maxSamplesPerBlock = kNumSamples;
+  setup.sampleRate = 44100;
+  ASSERT_EQ(kResultOk, processor.setupProcessing(setup));
+  ASSERT_EQ(kResultOk, processor.setActive(true));
+  ASSERT_EQ(3u, processor.getLatencySamples());
+
+  std::vector<Sample32> inputs[2] = {std::vector<Sample32>(kNumSamples), std::vector<Sample32>(kNumSamples)};
+  std::vector<Sample32> outputs[2] = {std::vector<Sample32>(kNumSamples), std::vector<Sample32>(kNumSamples)};
+  Sample32 *in[2] = {inputs[0].data(), inputs[1].data()};
+  Sample32 *out[2] = {outputs[0].data(), outputs[1].data()};
+
+  AudioBusBuffers inBus{};
+  inBus.numChannels = 2;
+  inBus.channelBuffers32 = in;
+  AudioBusBuffers outBus{};
+  outBus.numChannels = 2;
+  outBus.channelBuffers32 = out;
+
+  ProcessData data{};
+  data.symbolicSampleSize = kSample32;
+  data.numSamples = kNumSamples;
+  data.numInputs = 1;
+  data.inputs = &inBus;
+  data.numOutputs = 1;
+  data.outputs = &outBus;
+
+  // input is a ramp (channel 1 is negated)
+  int next = 1;
+  auto processFrame = [&]() {
+    for(int32 i = 0; i < kNumSamples; i++, next++)
+    {
+      inputs[0][i] = static_cast<Sample32>(next);
+      inputs[1][i] = static_cast<Sample32>(-next);
+    }
+    return processor.process(data);
+  };
+
+  // no dry signal => only the wet signal
+  ASSERT_EQ(kResultOk, processFrame());
+  for(int32 i = 0; i < kNumSamples; i++)
+    ASSERT_EQ(0, outputs[0][i]);
+
+  // bypassed => the input delayed by the latency (exact)
+  processor.fBypassed = true;
+  ASSERT_EQ(kResultOk, processFrame());
+  ASSERT_EQ(kResultOk, processFrame());
+  for(int32 i = 0; i < kNumSamples; i++)
+  {
+    ASSERT_EQ(inputs[0][i] - 3, outputs[0][i]) << "i=" << i;
+    ASSERT_EQ(inputs[1][i] + 3, outputs[1][i]) << "i=" << i;
+  }
+
+  // the latency changes => the delay follows and the controller gets notified (once)
+  processor.fLookahead.setLatencySamples(5);
+  ASSERT_EQ(kResultOk, processFrame());
+  ASSERT_EQ(5u, processor.getLatencySamples());
+  for(int32 i = 0; i < kNumSamples; i++)
+    ASSERT_EQ(inputs[0][i] - 5, outputs[0][i]) << "i=" << i;
+  ASSERT_EQ(0, processor.fNumLatencyChanged);
+  processor.onGUIMessageTimer();
+  ASSERT_EQ(1, processor.fNumLatencyChanged);
+  processor.onGUIMessageTimer();
+  ASSERT_EQ(1, processor.fNumLatencyChanged);
+
+  // from bypass to 50% dry => ramps over one frame then stays at 50%
+  processor.fBypassed = false;
+  processor.fDryMix = 0.5;
+  ASSERT_EQ(kResultOk, processFrame());
+  for(int32 i = 0; i < kNumSamples; i++)
+  {
+    auto gain = 1.0f - 0.5f * static_cast<float>(i + 1) / kNumSamples;
+    ASSERT_FLOAT_EQ((inputs[0][i] - 5) * gain, outputs[0][i]) << "i=" << i;
+  }
+  ASSERT_EQ(kResultOk, processFrame());
+  for(int32 i = 0; i < kNumSamples; i++)
+    ASSERT_FLOAT_EQ((inputs[0][i] - 5) * 0.5f, outputs[0][i]) << "i=" << i;
+}
+
+// RTProcessor - latency compensation with an overridden getLatencySamples (no latency source)
+TEST(RTProcessor, adHocLatencyCompensation)
+{
+  constexpr int32 kNumSamples = 8;
+
+  LatencyRTProcessor processor{false};
+  processor.fAdHocLatency = 2;
+  processor.fBypassed = true;
+
+  ProcessSetup setup{};
+  setup.symbolicSampleSize = kSample32;
+  setup.maxSamplesPerBlock = kNumSamples;
+  setup.sampleRate = 44100;
+  ASSERT_EQ(kResultOk, processor.setupProcessing(setup));
+  ASSERT_EQ(kResultOk, processor.setActive(true));
+  ASSERT_EQ(2u, processor.getLatencySamples());
+
+  std::vector<Sample32> inputs[2] = {std::vector<Sample32>(kNumSamples), std::vector<Sample32>(kNumSamples)};
+  std::vector<Sample32> outputs[2] = {std::vector<Sample32>(kNumSamples), std::vector<Sample32>(kNumSamples)};
+  Sample32 *in[2] = {inputs[0].data(), inputs[1].data()};
+  Sample32 *out[2] = {outputs[0].data(), outputs[1].data()};
+
+  AudioBusBuffers inBus{};
+  inBus.numChannels = 2;
+  inBus.channelBuffers32 = in;
+  AudioBusBuffers outBus{};
+  outBus.numChannels = 2;
+  outBus.channelBuffers32 = out;
+
+  ProcessData data{};
+  data.symbolicSampleSize = kSample32;
+  data.numSamples = kNumSamples;
+  data.numInputs = 1;
+  data.inputs = &inBus;
+  data.numOutputs = 1;
+  data.outputs = &outBus;
+
+  // input is a ramp
+  int next = 1;
+  auto processFrame = [&]() {
+    for(int32 i = 0; i < kNumSamples; i++, next++)
+    {
+      for(auto &input: inputs)
+        input[i] = static_cast<Sample32>(next);
+    }
+    return processor.process(data);
+  };
+
+  // bypassed => the input delayed by the latency
+  ASSERT_EQ(kResultOk, processFrame());
+  ASSERT_EQ(kResultOk, processFrame());
+  for(int32 i = 0; i < kNumSamples; i++)
+    ASSERT_EQ(inputs[0][i] - 2, outputs[0][i]) << "i=" << i;
+
+  // the (overridden) latency changes after activation => the delay follows and the controller gets notified
+  processor.fAdHocLatency = 7;
+  ASSERT_EQ(kResultOk, processFrame());
+  for(int32 i = 0; i < kNumSamples; i++)
+    ASSERT_EQ(inputs[0][i] - 7, outputs[0][i]) << "i=" << i;
+  ASSERT_EQ(0, processor.fNumLatencyChanged);
+  processor.onGUIMessageTimer();
+  ASSERT_EQ(1, processor.fNumLatencyChanged);
+}
+
+// RTProcessor - silence bypass with latency
+TEST(RTProcessor, silenceBypassLatency)
+{
+  constexpr int32 kNumSamples = 8;
+
+  // bypassed => the outputs are the inputs delayed by 13 samples (no tail)
+  LatencyRTProcessor processor{};
+  processor.enableSilenceBypass();
+  processor.fLookahead.setLatencySamples(13);
+  processor.fBypassed = true;
+
+  ProcessSetup setup{};
+  setup.symbolicSampleSize = kSample32;
+  setup.maxSamplesPerBlock = kNumSamples;
+  setup.sampleRate = 44100;
+  ASSERT_EQ(kResultOk, processor.setupProcessing(setup));
+  ASSERT_EQ(kResultOk, processor.setActive(true));
+
+  std::vector<Sample32> inputs[2] = {std::vector<Sample32>(kNumSamples), std::vector<Sample32>(kNumSamples)};
+  std::vector<Sample32> outputs[2] = {std::vector<Sample32>(kNumSamples), std::vector<Sample32>(kNumSamples)};
+  Sample32 *in[2] = {inputs[0].data(), inputs[1].data()};
+  Sample32 *out[2] = {outputs[0].data(), outputs[1].data()};
+
+  AudioBusBuffers inBus{};
+  inBus.numChannels = 2;
+  inBus.channelBuffers32 = in;
+  AudioBusBuffers outBus{};
+  outBus.numChannels = 2;
+  outBus.channelBuffers32 = out;
+
+  ProcessData data{};
+  data.symbolicSampleSize = kSample32;
+  data.numSamples = kNumSamples;
+  data.numInputs = 1;
+  data.inputs = &inBus;
+  data.numOutputs = 1;
+  data.outputs = &outBus;
+
+  // the samples of the signal are 1, 2, 3... (0 once silent)
+  int next = 1;
+  auto processFrame = [&](bool iSilent) {
+    for(int32 i = 0; i < kNumSamples; i++, next++)
+    {
+      for(auto &input: inputs)
+        input[i] = iSilent ? 0 : static_cast<Sample32>(next);
+    }
+    inBus.silenceFlags = iSilent ? 3 : 0;
+    return processor.process(data);
+  };
+
+  ASSERT_EQ(kResultOk, processFrame(false));
+
+  // the signal (samples 1 to 8) comes out 13 samples later, over the next 2 (silent) frames
+  std::vector<Sample32> delayed{};
+  for(int frame = 0; frame < 2; frame++)
+  {
+    ASSERT_EQ(kResultOk, processFrame(true));
+    ASSERT_FALSE(processor.isBypassingSilence()) << "frame=" << frame;
+    delayed.insert(delayed.end(), outputs[0].begin(), outputs[0].end());
+  }
+  ASSERT_EQ((std::vector<Sample32>{0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 0, 0}), delayed);
+
+  // the latency has elapsed => bypassed
+  ASSERT_EQ(kResultOk, processFrame(true));
+  ASSERT_TRUE(processor.isBypassingSilence());
+  for(auto &output: outputs)
+  {
+    for(auto s: output)
+      ASSERT_EQ(0, s);
+  }
+}
+
+// counts the calls to the hooks
+struct CountingRTState : public RTState
+{
+  explicit CountingRTState(TestParameters const &iParams) : RTState(iParams) {}
+
+  bool beforeProcessing() override { fNumBeforeProcessing++; return RTState::beforeProcessing(); }
+  void afterProcessing() override { fNumAfterProcessing++; RTState::afterProcessing(); }
+
+  int fNumBeforeProcessing{0};
+  int fNumAfterProcessing{0};
+};
+
+class TestTRTProcessor : public TRTProcessor<TestTRTProcessor, CountingRTState>
+{
+public:
+  TestTRTProcessor() : TRTProcessor(FUID{}), fState{fParameters} {}
+
+  using RTProcessor::enableSilenceBypass;
+
+  CountingRTState *getRTState() override { return &fState; }
+
+  template<typename SampleType>
+  tresult genericProcessInputs(ProcessData &data)
+  {
+    if constexpr(std::is_same_v<SampleType, Sample32>)
+      fNum32BitsCalls++;
+    else
+      fNum64BitsCalls++;
+    return kResultOk;
+  }
+
+  TestParameters fParameters{};
+  CountingRTState fState;
+  int fNum32BitsCalls{0};
+  int fNum64BitsCalls{0};
+};
+
+// TRTProcessor - process
+TEST(TRTProcessor, process)
+{
+  TestTRTProcessor processor{};
+  ProcessData data{};
+
+  data.symbolicSampleSize = kSample32;
+  ASSERT_EQ(kResultOk, processor.process(data));
+  ASSERT_EQ(1, processor.fNum32BitsCalls);
+  ASSERT_EQ(0, processor.fNum64BitsCalls);
+  ASSERT_EQ(1, processor.fState.fNumBeforeProcessing);
+  ASSERT_EQ(1, processor.fState.fNumAfterProcessing);
+
+  data.symbolicSampleSize = kSample64;
+  ASSERT_EQ(kResultOk, processor.process(data));
+  ASSERT_EQ(1, processor.fNum32BitsCalls);
+  ASSERT_EQ(1, processor.fNum64BitsCalls);
+  ASSERT_EQ(2, processor.fState.fNumBeforeProcessing);
+  ASSERT_EQ(2, processor.fState.fNumAfterProcessing);
+
+  data.symbolicSampleSize = -1;
+  ASSERT_EQ(kResultFalse, processor.process(data));
+  ASSERT_EQ(3, processor.fState.fNumAfterProcessing);
+
+  // through RTProcessor::process (silence bypass enabled but inputs are not silent)
+  processor.enableSilenceBypass();
+  data.symbolicSampleSize = kSample32;
+  ASSERT_EQ(kResultOk, processor.process(data));
+  ASSERT_EQ(2, processor.fNum32BitsCalls);
+  ASSERT_EQ(4, processor.fState.fNumBeforeProcessing);
+  ASSERT_EQ(4, processor.fState.fNumAfterProcessing);
+}
+
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include <gtest/gtest.h>
+#include <pongasoft/VST/RT/RTScratchArena.h>
+#include <pongasoft/VST/AudioBuffer.h>
+
+#include <cstdint>
+
+namespace pongasoft::VST::RT::TestRTScratchArena {
+
+inline bool isAligned(void const *iPtr, size_t iAlignment = RTScratchArena::kAlignment)
+{
+  return reinterpret_cast<std::uintptr_t>(iPtr) % iAlignment == 0;
+}
+
+// RTScratchArena - allocate
+TEST(RTScratchArena, allocate)
+{
+  RTScratchArena arena{};
+
+  // nothing reserved
+  ASSERT_EQ(0u, arena.getCapacity());
+  ASSERT_EQ(nullptr, arena.allocate(1));
+
+  arena.reserve(256);
+  ASSERT_EQ(256u, arena.getCapacity());
+
+  auto p1 = arena.allocate(10);
+  ASSERT_TRUE(p1 != nullptr);
+  ASSERT_TRUE(isAligned(p1));
+  ASSERT_EQ(10u, arena.getSize());
+
+  // next allocation is aligned
+  auto p2 = arena.allocateArray<int32>(4);
+  ASSERT_TRUE(p2 != nullptr);
+  ASSERT_TRUE(isAligned(p2));
+  ASSERT_EQ(static_cast<char *>(p1) + 64, reinterpret_cast<char *>(p2));
+  ASSERT_EQ(80u, arena.getSize());
+
+  // smaller alignment
+  auto p3 = arena.allocate(4, 4);
+  ASSERT_EQ(reinterpret_cast<char *>(p2) + 16, static_cast<char *>(p3));
+  ASSERT_EQ(84u, arena.getSize());
+
+  // not enough room
+  ASSERT_EQ(nullptr, arena.allocate(200));
+  ASSERT_EQ(84u, arena.getSize());
+
+  // bigger alignment than kAlignment (the address is aligned, not only the offset)
+  {
+    RTScratchArena bigArena{};
+    bigArena.reserve(1024);
+    for(int i = 0; i < 4; i++)
+    {
+      auto p = bigArena.allocate(10, 256);
+      ASSERT_TRUE(p != nullptr);
+      ASSERT_TRUE(isAligned(p, 256));
+    }
+  }
+
+  // exactly enough room
+  ASSERT_TRUE(arena.allocate(128) != nullptr);
+  ASSERT_EQ(256u, arena.getSize());
+  ASSERT_EQ(nullptr, arena.allocate(1));
+
+  // reset => same memory
+  arena.reset();
+  ASSERT_EQ(0u, arena.getSize());
+  ASSERT_EQ(256u, arena.getHighWaterMark());
+  ASSERT_EQ(p1, arena.allocate(10));
+
+  // reserve less does not reallocate
+  arena.reserve(128);
+  ASSERT_EQ(256u, arena.getCapacity());
+  ASSERT_EQ(0u, arena.getSize());
+  ASSERT_EQ(p1, arena.allocate(10));
+
+  // reserve more reallocates
+  arena.reserve(1024);
+  ASSERT_EQ(1024u, arena.getCapacity());
+  ASSERT_EQ(0u, arena.getHighWaterMark());
+  ASSERT_TRUE(isAligned(arena.allocate(10)));
+}
+
+// RTScratchArena - allocateAudioBusBuffers
+TEST(RTScratchArena, allocateAudioBusBuffers)
+{
+  constexpr int32 kNumSamples = 100;
+
+  RTScratchArena arena{};
+  arena.reserve(RTScratchArena::computeAudioBusBuffersSize(2, kNumSamples, sizeof(Sample32)));
+
+  auto bus = arena.allocateAudioBusBuffers<Sample32>(2, kNumSamples);
+  ASSERT_TRUE(bus != nullptr);
+  ASSERT_TRUE(arena.getSize() <= arena.getCapacity());
+
+  AudioBuffers32 buffers{*bus, kNumSamples};
+  ASSERT_EQ(2, buffers.getNumChannels());
+  ASSERT_TRUE(buffers.isSilent());
+
+  for(int32 c = 0; c < 2; c++)
+  {
+    auto channel = buffers.getBuffer()[c];
+    ASSERT_TRUE(isAligned(channel));
+    for(int32 i = 0; i < kNumSamples; i++)
+      ASSERT_EQ(0, channel[i]);
+  }
+
+  // channels do not overlap
+  buffers.getLeftChannel().forEachSample([](Sample32 &s) { s = 1.0f; });
+  ASSERT_FALSE(buffers.adjustSilenceFlags());
+  ASSERT_EQ(0, buffers.getRightChannel().getBuffer()[0]);
+
+  // not enough room => nothing allocated
+  arena.reset();
+  arena.allocate(1);
+  auto size = arena.getSize();
+  ASSERT_EQ(nullptr, arena.allocateAudioBusBuffers<Sample32>(2, kNumSamples));
+  ASSERT_EQ(size, arena.getSize());
+
+  // 64 bits
+  arena.reset();
+  auto bus64 = arena.allocateAudioBusBuffers<Sample64>(1, kNumSamples / 2);
+  ASSERT_TRUE(bus64 != nullptr);
+  AudioBuffers64 buffers64{*bus64, kNumSamples / 2};
+  ASSERT_TRUE(buffers64.isSilent());
+  ASSERT_EQ(0, buffers64.getLeftChannel().getBuffer()[kNumSamples / 2 - 1]);
+}
+
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include <gtest/gtest.h>
+#include <pongasoft/VST/RT/RTState.h>
+#include <pongasoft/VST/Parameters.h>
+#include <array>
+
+namespace pongasoft::VST::RT::TestRTSmoothedParameter {
+
+struct TestParameters : public Parameters
+{
+  VstParam<Percent> fLinear;
+  VstParam<Percent> fOnePole;
+
+  TestParameters()
+  {
+    fLinear = vst<PercentParamConverter>(1, STR16("linear")).defaultValue(0.0).add();
+    fOnePole = vst<PercentParamConverter>(2, STR16("onePole")).defaultValue(0.0).add();
+    setRTSaveStateOrder(1, fLinear, fOnePole);
+  }
+};
+
+struct TestRTState : public RTState
+{
+  RTSmoothedVstParam<Percent> fLinear;
+  RTSmoothedVstParam<Percent> fOnePole;
+
+  explicit TestRTState(TestParameters const &iParams) :
+    RTState(iParams),
+    fLinear{add(iParams.fLinear, RTSmoothing::linear(1))},
+    fOnePole{add(iParams.fOnePole, RTSmoothing::onePole(1))}
+  {}
+};
+
+// RTSmoothedVstParam - linear
+TEST(RTSmoothedVstParam, linear)
+{
+  TestParameters params{};
+  TestRTState state{params};
+  ASSERT_EQ(kResultOk, state.init());
+
+  // 1ms at 8000Hz => 8 samples
+  state.setSampleRate(8000);
+
+  ASSERT_FALSE(state.fLinear.isSmoothing());
+  state.fLinear = 0.8;
+  ASSERT_DOUBLE_EQ(0.8, *state.fLinear);
+  ASSERT_DOUBLE_EQ(0.0, state.fLinear.smoothedValue());
+  ASSERT_TRUE(state.fLinear.isSmoothing());
+
+  ASSERT_DOUBLE_EQ(0.1, state.fLinear.nextSmoothedValue());
+  ASSERT_DOUBLE_EQ(0.2, state.fLinear.nextSmoothedValue());
+
+  std::array<float, 10> ramp{};
+  ASSERT_DOUBLE_EQ(0.8, state.fLinear.fillRamp(ramp.data(), 10));
+  std::array<float, 10> expected{0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f, 0.8f, 0.8f, 0.8f, 0.8f};
+  for(size_t i = 0; i < ramp.size(); i++)
+    ASSERT_FLOAT_EQ(expected[i], ramp[i]) << "index " << i;
+  ASSERT_FALSE(state.fLinear.isSmoothing());
+
+  // per block
+  state.fLinear = 0.0;
+  ASSERT_DOUBLE_EQ(0.4, state.fLinear.advance(4));
+  ASSERT_TRUE(state.fLinear.isSmoothing());
+  ASSERT_DOUBLE_EQ(0.0, state.fLinear.advance(100));
+  ASSERT_FALSE(state.fLinear.isSmoothing());
+
+  // applyRamp
+  state.fLinear = 0.8;
+  std::array<double, 4> buffer{1.0, 2.0, 3.0, 4.0};
+  state.fLinear.applyRamp(buffer.data(), 4);
+  ASSERT_DOUBLE_EQ(0.1, buffer[0]);
+  ASSERT_DOUBLE_EQ(0.4, buffer[1]);
+  ASSERT_DOUBLE_EQ(0.9, buffer[2]);
+  ASSERT_DOUBLE_EQ(1.6, buffer[3]);
+
+  // snap
+  state.fLinear.snapToTarget();
+  ASSERT_DOUBLE_EQ(0.8, state.fLinear.smoothedValue());
+  ASSERT_FALSE(state.fLinear.isSmoothing());
+}
+
+// RTSmoothedVstParam - onePole
+TEST(RTSmoothedVstParam, onePole)
+{
+  TestParameters params{};
+  TestRTState state{params};
+  ASSERT_EQ(kResultOk, state.init());
+
+  // 1ms at 8000Hz => time constant of 8 samples (ramp ends after 40 samples)
+  state.setSampleRate(8000);
+
+  state.fOnePole = 1.0;
+  ASSERT_TRUE(state.fOnePole.isSmoothing());
+
+  auto a = std::exp(-1.0 / 8);
+  ASSERT_DOUBLE_EQ(1.0 - a, state.fOnePole.nextSmoothedValue());
+
+  std::array<double, 7> ramp{};
+  state.fOnePole.fillRamp(ramp.data(), 7);
+  ASSERT_NEAR(1.0 - std::exp(-1.0), ramp[6], 1e-12);
+
+  // per sample and per block yield the same value
+  ASSERT_NEAR(1.0 - std::exp(-2.0), state.fOnePole.advance(8), 1e-12);
+
+  // ramp always ends
+  ASSERT_DOUBLE_EQ(1.0, state.fOnePole.advance(24));
+  ASSERT_FALSE(state.fOnePole.isSmoothing());
+
+  // fillRamp, advance and nextSmoothedValue all end up with the exact same value
+  TestRTState filledState{params}, advancedState{params}, perSampleState{params};
+  for(auto s: {&filledState, &advancedState, &perSampleState})
+  {
+    ASSERT_EQ(kResultOk, s->init());
+    s->setSampleRate(8000);
+    s->fOnePole = 1.0;
+  }
+  std::array<double, 13> block{};
+  auto filled = filledState.fOnePole.fillRamp(block.data(), 13);
+  ASSERT_EQ(filled, block[12]);
+  ASSERT_EQ(filled, advancedState.fOnePole.advance(13));
+  for(int i = 0; i < 13; i++)
+    perSampleState.fOnePole.nextSmoothedValue();
+  ASSERT_EQ(filled, perSampleState.fOnePole.smoothedValue());
+
+  // applyRamp on 1s yields the same gains as fillRamp (including the last sample when the ramp ends in the block)
+  TestRTState rampFilledState{params}, rampAppliedState{params};
+  for(auto s: {&rampFilledState, &rampAppliedState})
+  {
+    ASSERT_EQ(kResultOk, s->init());
+    s->setSampleRate(8000);
+    s->fOnePole = 1.0;
+  }
+  std::array<double, 50> filledBlock{};
+  std::array<double, 50> appliedBlock{};
+  appliedBlock.fill(1.0);
+  // 2 blocks: the ramp ends (after 40 samples) in the second one
+  for(int offset: {0, 25})
+  {
+    ASSERT_EQ(rampFilledState.fOnePole.fillRamp(filledBlock.data() + offset, 25),
+              rampAppliedState.fOnePole.applyRamp(appliedBlock.data() + offset, 25));
+  }
+  for(size_t i = 0; i < filledBlock.size(); i++)
+    ASSERT_EQ(filledBlock[i], appliedBlock[i]) << "index " << i;
+  ASSERT_EQ(1.0, appliedBlock[39]);
+}
+
+// RTSmoothedVstParam - no sample rate => no smoothing
+TEST(RTSmoothedVstParam, noSampleRate)
+{
+  TestParameters params{};
+  TestRTState state{params};
+  ASSERT_EQ(kResultOk, state.init());
+
+  state.fLinear = 0.5;
+  ASSERT_FALSE(state.fLinear.isSmoothing());
+  ASSERT_DOUBLE_EQ(0.5, state.fLinear.nextSmoothedValue());
+}
+
+}
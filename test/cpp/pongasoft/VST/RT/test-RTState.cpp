@@ -0,0 +1,668 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include <gtest/gtest.h>
+#include <pongasoft/VST/RT/RTState.h>
+#include <pongasoft/VST/Parameters.h>
+#include <pongasoft/VST/GUI/GUIState.h>
+#include <pongasoft/VST/MessageHandler.h>
+#include <pongasoft/VST/VstUtils/FastWriteMemoryStream.h>
+#include <base/source/fstreamer.h>
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <cstring>
+
+namespace pongasoft::VST::RT::TestRTState {
+
+using namespace Steinberg::Vst;
+
+// MockParamValueQueue
+class MockParamValueQueue : public IParamValueQueue
+{
+public:
+  explicit MockParamValueQueue(ParamID iParamID) : fParamID{iParamID} {}
+
+  ParamID PLUGIN_API getParameterId() override { return fParamID; }
+  int32 PLUGIN_API getPointCount() override { return static_cast<int32>(fPoints.size()); }
+
+  tresult PLUGIN_API getPoint(int32 index, int32 &sampleOffset, ParamValue &value) override
+  {
+    if(index < 0 || index >= getPointCount())
+      return kResultFalse;
+    sampleOffset = fPoints[index].first;
+    value = fPoints[index].second;
+    return kResultOk;
+  }
+
+  tresult PLUGIN_API addPoint(int32 sampleOffset, ParamValue value, int32 &index) override
+  {
+    fPoints.emplace_back(sampleOffset, value);
+    index = getPointCount() - 1;
+    return kResultOk;
+  }
+
+  tresult PLUGIN_API queryInterface(const TUID /* _iid */, void **obj) override { *obj = nullptr; return kNoInterface; }
+  uint32 PLUGIN_API addRef() override { return 1; }
+  uint32 PLUGIN_API release() override { return 1; }
+
+private:
+  ParamID fParamID;
+  std::vector<std::pair<int32, ParamValue>> fPoints{};
+};
+
+// MockParameterChanges
+class MockParameterChanges : public IParameterChanges
+{
+public:
+  MockParameterChanges() { fQueues.reserve(16); }
+
+  int32 PLUGIN_API getParameterCount() override { return static_cast<int32>(fQueues.size()); }
+  IParamValueQueue *PLUGIN_API getParameterData(int32 index) override { return &fQueues[index]; }
+
+  IParamValueQueue *PLUGIN_API addParameterData(const ParamID &id, int32 &index) override
+  {
+    fQueues.emplace_back(id);
+    index = getParameterCount() - 1;
+    return &fQueues[index];
+  }
+
+  MockParameterChanges &add(ParamID iParamID, std::vector<std::pair<int32, ParamValue>> const &iPoints)
+  {
+    int32 index;
+    auto queue = addParameterData(iParamID, index);
+    for(auto &p: iPoints)
+      queue->addPoint(p.first, p.second, index);
+    return *this;
+  }
+
+  tresult PLUGIN_API queryInterface(const TUID /* _iid */, void **obj) override { *obj = nullptr; return kNoInterface; }
+  uint32 PLUGIN_API addRef() override { return 1; }
+  uint32 PLUGIN_API release() override { return 1; }
+
+private:
+  std::vector<MockParamValueQueue> fQueues{};
+};
+
+struct TestParameters : public Parameters
+{
+  VstParam<Percent> fParam1;
+  VstParam<Percent> fParam2;
+  RawVstParam fParam3;
+
+  TestParameters()
+  {
+    fParam1 = vst<PercentParamConverter>(1, STR16("param1")).defaultValue(0.1).add();
+    fParam2 = vst<PercentParamConverter>(2, STR16("param2")).defaultValue(0.2).add();
+    fParam3 = raw(3, STR16("param3")).defaultValue(0.3).add();
+    setRTSaveStateOrder(1, fParam1, fParam2, fParam3);
+  }
+};
+
+struct TestRTState : public RTState
+{
+  RTVstParam<Percent> fParam1;
+  RTVstParam<Percent> fParam2;
+  RTRawVstParam fParam3;
+
+  explicit TestRTState(TestParameters const &iParams) :
+    RTState(iParams),
+    fParam1{add(iParams.fParam1)},
+    fParam2{add(iParams.fParam2)},
+    fParam3{add(iParams.fParam3)}
+  {}
+
+  using RTState::findVstParameterSlot;
+  using RTState::findVstParameter;
+  using RTState::getDirtyParameters;
+
+  // returns the values as written by writeLatestState
+  std::vector<double> getLatestValues()
+  {
+    VstUtils::FastWriteMemoryStream stream{};
+    IBStreamer streamer{&stream};
+    writeLatestState(streamer);
+    std::vector<double> res{};
+    auto data = stream.getData() + sizeof(uint16); // skipping version
+    for(size_t i = 0; i < (stream.getSize() - sizeof(uint16)) / sizeof(double); i++)
+    {
+      double d;
+      std::memcpy(&d, data + i * sizeof(double), sizeof(double));
+      res.emplace_back(d);
+    }
+    return res;
+  }
+};
+
+struct SparseTestParameters : public Parameters
+{
+  RawVstParam fParam1;
+  RawVstParam fParam2;
+
+  SparseTestParameters()
+  {
+    fParam1 = raw(0x10000000, STR16("param1")).add();
+    fParam2 = raw(5, STR16("param2")).add();
+    setRTSaveStateOrder(1, fParam1, fParam2);
+  }
+};
+
+struct SparseTestRTState : public RTState
+{
+  RTRawVstParam fParam1;
+  RTRawVstParam fParam2;
+
+  explicit SparseTestRTState(SparseTestParameters const &iParams) :
+    RTState(iParams),
+    fParam1{add(iParams.fParam1)},
+    fParam2{add(iParams.fParam2)}
+  {}
+
+  using RTState::findVstParameterSlot;
+};
+
+// RTState - ParameterTable
+TEST(RTState, ParameterTable)
+{
+  TestParameters params{};
+  TestRTState state{params};
+
+  // before init (linear search)
+  ASSERT_EQ(0, state.findVstParameterSlot(1));
+  ASSERT_EQ(2, state.findVstParameterSlot(3));
+  ASSERT_EQ(-1, state.findVstParameterSlot(4));
+
+  ASSERT_EQ(kResultOk, state.init());
+
+  // after init (dense index)
+  ASSERT_EQ(0, state.findVstParameterSlot(1));
+  ASSERT_EQ(1, state.findVstParameterSlot(2));
+  ASSERT_EQ(2, state.findVstParameterSlot(3));
+  ASSERT_EQ(-1, state.findVstParameterSlot(0));
+  ASSERT_EQ(-1, state.findVstParameterSlot(4));
+  ASSERT_EQ(-1, state.findVstParameterSlot(100000));
+  ASSERT_EQ(nullptr, state.findVstParameter(4));
+  ASSERT_EQ(2, state.findVstParameter(2)->getParamID());
+
+  MockParameterChanges changes{};
+  changes.add(2, {{0, 0.8}}).add(4, {{0, 0.5}});
+  ASSERT_TRUE(state.applyParameterChanges(changes));
+  ASSERT_DOUBLE_EQ(0.8, *state.fParam2);
+
+  SparseTestParameters sparseParams{};
+  SparseTestRTState sparseState{sparseParams};
+  ASSERT_EQ(kResultOk, sparseState.init());
+
+  // after init (sparse index)
+  ASSERT_EQ(0, sparseState.findVstParameterSlot(0x10000000));
+  ASSERT_EQ(1, sparseState.findVstParameterSlot(5));
+  ASSERT_EQ(-1, sparseState.findVstParameterSlot(4));
+  ASSERT_EQ(-1, sparseState.findVstParameterSlot(0x10000001));
+}
+
+// RTState - SampleAccurateAutomation
+TEST(RTState, SampleAccurateAutomation)
+{
+  TestParameters params{};
+  TestRTState state{params};
+  ASSERT_EQ(kResultOk, state.init());
+
+  ASSERT_FALSE(state.isSampleAccurateAutomationEnabled());
+  state.enableSampleAccurateAutomation(4);
+  ASSERT_TRUE(state.isSampleAccurateAutomationEnabled());
+
+  MockParameterChanges changes{};
+  changes.add(1, {{0, 0.5}, {10, 0.6}, {20, 0.7}}).add(2, {{15, 0.9}});
+
+  state.beforeProcessing();
+  ASSERT_TRUE(state.applyParameterChanges(changes));
+
+  // default behavior is preserved: the parameter ends up with the last value
+  ASSERT_DOUBLE_EQ(0.7, *state.fParam1);
+  ASSERT_DOUBLE_EQ(0.9, *state.fParam2);
+  ASSERT_DOUBLE_EQ(0.3, *state.fParam3);
+
+  ASSERT_TRUE(state.hasAutomationPoints());
+  ASSERT_EQ(3, state.fParam1.getAutomationPointCount());
+  ASSERT_EQ(10, state.fParam1.getAutomationPoint(1).fSampleOffset);
+  ASSERT_DOUBLE_EQ(0.6, state.fParam1.getAutomationPoint(1).fValue);
+  ASSERT_EQ(1, state.fParam2.getAutomationPointCount());
+  ASSERT_EQ(0, state.fParam3.getAutomationPointCount());
+
+  // rewinding restores the values at the beginning of the block
+  state.rewindAutomation();
+  ASSERT_DOUBLE_EQ(0.1, *state.fParam1);
+  ASSERT_DOUBLE_EQ(0.2, *state.fParam2);
+
+  std::vector<int32> offsets{};
+  int32 offset = 0;
+  while(offset < 32)
+  {
+    state.advanceAutomation(offset);
+    offsets.emplace_back(offset);
+
+    if(offset == 15)
+    {
+      ASSERT_DOUBLE_EQ(0.6, *state.fParam1);
+      ASSERT_DOUBLE_EQ(0.9, *state.fParam2);
+    }
+
+    offset = state.getNextAutomationSampleOffset(offset, 32);
+  }
+  ASSERT_EQ((std::vector<int32>{0, 10, 15, 20}), offsets);
+
+  state.advanceAutomation(32);
+  ASSERT_DOUBLE_EQ(0.7, *state.fParam1);
+
+  state.afterProcessing();
+  ASSERT_FALSE(state.hasAutomationPoints());
+  ASSERT_EQ(0, state.fParam1.getAutomationPointCount());
+
+  // more points than preallocated => last point is always kept
+  MockParameterChanges overflow{};
+  overflow.add(1, {{0, 0.1}, {1, 0.2}, {2, 0.3}, {3, 0.4}, {4, 0.5}, {5, 0.6}});
+  state.beforeProcessing();
+  ASSERT_TRUE(state.applyParameterChanges(overflow));
+  ASSERT_EQ(4, state.fParam1.getAutomationPointCount());
+  ASSERT_EQ(5, state.fParam1.getAutomationPoint(3).fSampleOffset);
+  ASSERT_DOUBLE_EQ(0.6, state.fParam1.getAutomationPoint(3).fValue);
+  ASSERT_DOUBLE_EQ(0.6, *state.fParam1);
+  state.afterProcessing();
+}
+
+// RTState - DirtyParameters
+TEST(RTState, DirtyParameters)
+{
+  TestParameters params{};
+  TestRTState state{params};
+  ASSERT_EQ(kResultOk, state.init());
+  state.afterProcessing();
+
+  ASSERT_TRUE(state.getDirtyParameters().empty());
+  ASSERT_EQ((std::vector<double>{0.1, 0.2, 0.3}), state.getLatestValues());
+
+  // frame 1: param2 changes via the host, param3 via the plugin
+  MockParameterChanges changes{};
+  changes.add(2, {{0, 0.8}});
+  state.beforeProcessing();
+  ASSERT_TRUE(state.applyParameterChanges(changes));
+  state.fParam3 = 0.6;
+  ASSERT_EQ((std::vector<int32>{1, 2}), state.getDirtyParameters().getSlots());
+  ASSERT_TRUE(state.fParam2.hasChanged());
+  ASSERT_TRUE(state.fParam3.hasChanged());
+  ASSERT_FALSE(state.fParam1.hasChanged());
+  state.afterProcessing();
+
+  ASSERT_TRUE(state.getDirtyParameters().empty());
+  ASSERT_FALSE(state.fParam2.hasChanged());
+  ASSERT_FALSE(state.fParam3.hasChanged());
+  ASSERT_DOUBLE_EQ(0.8, state.fParam2.previous());
+  ASSERT_EQ((std::vector<double>{0.1, 0.8, 0.6}), state.getLatestValues());
+
+  // frame 2: nothing changes
+  state.beforeProcessing();
+  ASSERT_TRUE(state.getDirtyParameters().empty());
+  state.afterProcessing();
+  ASSERT_EQ((std::vector<double>{0.1, 0.8, 0.6}), state.getLatestValues());
+
+  // frame 3: param1 changes via the typed api
+  state.beforeProcessing();
+  state.fParam1 = 0.4;
+  ASSERT_EQ((std::vector<int32>{0}), state.getDirtyParameters().getSlots());
+  state.afterProcessing();
+  ASSERT_FALSE(state.fParam1.hasChanged());
+  ASSERT_EQ((std::vector<double>{0.4, 0.8, 0.6}), state.getLatestValues());
+}
+
+using StepsConverter = DiscreteValueParamConverter<10>;
+
+// subclass of StepsConverter which reverses the steps
+struct ReversedStepsConverter : public StepsConverter
+{
+  ParamValue normalize(int32 const &iValue) const override { return StepsConverter::normalize(10 - iValue); }
+  int32 denormalize(ParamValue iNormalizedValue) const override
+  {
+    return 10 - StepsConverter::denormalize(iNormalizedValue);
+  }
+};
+
+struct CompileTimeConverterParameters : public Parameters
+{
+  TVstParam<Percent, PercentParamConverter> fParam1;
+  TVstParam<int32, StepsConverter> fParam2;
+  TVstParam<int32, StepsConverter> fReversedParam;
+  TVstParam<int32, DiscreteValueParamConverter<5>> fInvalidParam;
+
+  CompileTimeConverterParameters()
+  {
+    fParam1 = vst<PercentParamConverter>(1, STR16("param1")).defaultValue(0.1).add<PercentParamConverter>();
+    fParam2 = vst<StepsConverter>(2, STR16("param2")).defaultValue(3).add<StepsConverter>();
+
+    // the converter is a subclass of the expected type (which must still be used)
+    fReversedParam = vst<ReversedStepsConverter>(4, STR16("param4")).defaultValue(3).add<StepsConverter>();
+
+    // the converter is not of the expected type
+    fInvalidParam = vst<StepsConverter>(3, STR16("param3")).add<DiscreteValueParamConverter<5>>();
+
+    setRTSaveStateOrder(1, fParam1, fParam2, fReversedParam);
+  }
+};
+
+struct CompileTimeConverterRTState : public RTState
+{
+  RTVstParam<Percent> fParam1;
+  RTVstParam<int32> fParam2;
+  RTVstParam<int32, StepsConverter> fReversedParam;
+
+  explicit CompileTimeConverterRTState(CompileTimeConverterParameters const &iParams) :
+    RTState(iParams),
+    fParam1{add(iParams.fParam1)},
+    fParam2{add(iParams.fParam2)},
+    fReversedParam{add(iParams.fReversedParam)}
+  {}
+
+  using RTState::findVstParameter;
+};
+
+// RTState - CompileTimeConverter
+TEST(RTState, CompileTimeConverter)
+{
+  CompileTimeConverterParameters params{};
+  ASSERT_EQ(nullptr, params.fInvalidParam);
+
+  // static api
+  ASSERT_EQ(3, params.fParam2->fDefaultValue);
+  ASSERT_DOUBLE_EQ(0.3, params.fParam2->normalize(3));
+  ASSERT_EQ(7, params.fParam2->denormalize(0.7));
+  ASSERT_EQ(10, params.fParam2->getConverter().getStepCount());
+
+  // type erased api (ex: GUI)
+  VstParam<int32> param2 = params.fParam2;
+  ASSERT_DOUBLE_EQ(0.3, param2->normalize(3));
+  ASSERT_EQ(7, param2->denormalize(0.7));
+  std::shared_ptr<RawVstParamDef> rawParam2 = params.fParam2;
+  ASSERT_NE(nullptr, std::dynamic_pointer_cast<VstParamDef<int32>>(rawParam2));
+  ASSERT_EQ(params.fParam2.get(), params.getRawVstParamDef(2).get());
+
+  // subclass => the overridden methods are used (static and type erased api)
+  ASSERT_DOUBLE_EQ(0.7, params.getRawVstParamDef(4)->fDefaultValue);
+  ASSERT_DOUBLE_EQ(0.7, params.fReversedParam->normalize(3));
+  ASSERT_EQ(3, params.fReversedParam->denormalize(0.7));
+  VstParam<int32> reversedParam = params.fReversedParam;
+  ASSERT_EQ(3, reversedParam->denormalize(0.7));
+
+  CompileTimeConverterRTState state{params};
+  ASSERT_EQ(kResultOk, state.init());
+  ASSERT_DOUBLE_EQ(0.1, *state.fParam1);
+  ASSERT_EQ(3, *state.fParam2);
+  ASSERT_EQ(3, *state.fReversedParam);
+
+  // host changes
+  MockParameterChanges changes{};
+  changes.add(1, {{0, 0.6}}).add(2, {{0, 0.5}}).add(4, {{0, 0.2}});
+  state.beforeProcessing();
+  ASSERT_TRUE(state.applyParameterChanges(changes));
+  ASSERT_DOUBLE_EQ(0.6, *state.fParam1);
+  ASSERT_EQ(5, *state.fParam2);
+  ASSERT_EQ(8, *state.fReversedParam);
+  state.afterProcessing();
+
+  // every rt path uses the same (overridden) converter (static or virtual api)
+  ASSERT_EQ(2, state.fReversedParam.denormalize(0.8));
+  ASSERT_DOUBLE_EQ(0.8, state.fReversedParam.normalize(2));
+  RTVstParam<int32> reversedRTParam = state.fReversedParam;
+  ASSERT_EQ(2, reversedRTParam.denormalize(0.8));
+  ASSERT_DOUBLE_EQ(0.8, reversedRTParam.normalize(2));
+  state.beforeProcessing();
+  state.fReversedParam = 1;
+  ASSERT_DOUBLE_EQ(0.9, state.fReversedParam.normalizedValue());
+  state.afterProcessing();
+
+  // plugin changes
+  state.beforeProcessing();
+  state.fParam2 = 8;
+  ASSERT_TRUE(state.fParam2.hasChanged());
+  ASSERT_DOUBLE_EQ(0.8, state.fParam2.normalizedValue());
+  ASSERT_DOUBLE_EQ(0.8, state.findVstParameter(2)->getNormalizedValue());
+  state.afterProcessing();
+  ASSERT_EQ(8, state.fParam2.previous());
+}
+
+class MockAttributeList : public IAttributeList
+{
+public:
+  tresult PLUGIN_API setInt(AttrID id, int64 value) override { fInts[id] = value; return kResultOk; }
+  tresult PLUGIN_API getInt(AttrID id, int64 &value) override
+  {
+    auto iter = fInts.find(id);
+    if(iter == fInts.end())
+      return kResultFalse;
+    value = iter->second;
+    return kResultOk;
+  }
+  tresult PLUGIN_API setFloat(AttrID id, double value) override { return kNotImplemented; }
+  tresult PLUGIN_API getFloat(AttrID id, double &value) override { return kNotImplemented; }
+  tresult PLUGIN_API setString(AttrID id, const TChar *string) override { return kNotImplemented; }
+  tresult PLUGIN_API getString(AttrID id, TChar *string, uint32 sizeInBytes) override { return kNotImplemented; }
+  tresult PLUGIN_API setBinary(AttrID id, const void *data, uint32 sizeInBytes) override
+  {
+    auto bytes = static_cast<char const *>(data);
+    fBinaries[id].assign(bytes, bytes + sizeInBytes);
+    return kResultOk;
+  }
+  tresult PLUGIN_API getBinary(AttrID id, const void *&data, uint32 &sizeInBytes) override
+  {
+    auto iter = fBinaries.find(id);
+    if(iter == fBinaries.end())
+      return kResultFalse;
+    data = iter->second.data();
+    sizeInBytes = static_cast<uint32>(iter->second.size());
+    return kResultOk;
+  }
+  tresult PLUGIN_API queryInterface(const TUID, void **) override { return kNoInterface; }
+
+  std::map<std::string, int64> fInts{};
+  std::map<std::string, std::vector<char>> fBinaries{};
+};
+
+class MockMessage : public IMessage
+{
+public:
+  FIDString PLUGIN_API getMessageID() override { return nullptr; }
+  void PLUGIN_API setMessageID(FIDString id) override {}
+  IAttributeList *PLUGIN_API getAttributes() override { return &fAttributes; }
+  tresult PLUGIN_API queryInterface(const TUID, void **) override { return kNoInterface; }
+
+  MockAttributeList fAttributes{};
+};
+
+struct MockMessageProducer : public IMessageProducer, public IMessageHandler
+{
+  MockMessageProducer(JmbParam<int32> iValueParam, JmbParam<int32> iEventsParam) :
+    fValueParam{std::move(iValueParam)},
+    fEventsParam{std::move(iEventsParam)}
+  {
+    fMessageHandler.registerHandler(fValueParam->fParamID, this);
+    fMessageHandler.registerHandler(fEventsParam->fParamID, this);
+  }
+
+  IPtr<IMessage> allocateMessage() override
+  {
+    return owned(static_cast<IMessage *>(new MockMessage()));
+  }
+
+  tresult sendMessage(IPtr<IMessage> iMessage) override
+  {
+    fSendCount++;
+    fMessages.insert(iMessage.get());
+
+    // simulates a host which delivers the message asynchronously
+    if(fKeepMessages)
+      fKeptMessages.emplace_back(iMessage);
+
+    // same as the GUI side
+    Message m{iMessage.get()};
+    return fMessageHandler.handleMessage(m);
+  }
+
+  tresult handleMessage(Message const &iMessage) override
+  {
+    int32 value;
+    auto param = iMessage.getMessageID() == fValueParam->fParamID ? fValueParam : fEventsParam;
+    EXPECT_EQ(kResultOk, param->readFromMessage(iMessage, value));
+    fReceived.emplace_back(iMessage.getMessageID(), value);
+    return kResultOk;
+  }
+
+  JmbParam<int32> fValueParam;
+  JmbParam<int32> fEventsParam;
+  MessageHandler fMessageHandler{};
+  std::set<IMessage *> fMessages{}; // distinct messages sent (a recycled message is sent again)
+  int fSendCount{0};
+  std::vector<std::pair<MessageID, int32>> fReceived{};
+  bool fKeepMessages{false};
+  std::vector<IPtr<IMessage>> fKeptMessages{};
+};
+
+struct MessagingTestParameters : public Parameters
+{
+  JmbParam<int32> fValue;
+  JmbParam<int32> fEvents;
+
+  MessagingTestParameters()
+  {
+    fValue = jmb<Int32ParamSerializer>(10, STR16("value")).rtOwned().shared().transient().add();
+    fEvents = jmb<Int32ParamSerializer>(11, STR16("events")).rtOwned().shared().transient().add();
+  }
+};
+
+struct MessagingTestRTState : public RTState
+{
+  RTJmbOutParam<int32> fValue;
+  RTJmbOutParam<int32> fEvents;
+
+  explicit MessagingTestRTState(MessagingTestParameters const &iParams) :
+    RTState(iParams),
+    fValue{addJmbOut(iParams.fValue)},
+    fEvents{addJmbOut(iParams.fEvents, 4)}
+  {}
+};
+
+// RTState - Messaging
+TEST(RTState, Messaging)
+{
+  using Received = std::vector<std::pair<MessageID, int32>>;
+
+  MessagingTestParameters params{};
+  MessagingTestRTState state{params};
+  ASSERT_EQ(kResultOk, state.init());
+
+  MockMessageProducer producer{params.fValue, params.fEvents};
+
+  // nothing to send
+  ASSERT_EQ(kResultOk, state.sendPendingMessages(&producer));
+  ASSERT_EQ(0u, producer.fMessages.size());
+
+  // single element queue => only the last value is sent / queue => every value is sent (up to capacity)
+  state.fValue.broadcast(1);
+  state.fValue.broadcast(2);
+  for(int32 i = 3; i < 9; i++)
+    state.fEvents.broadcast(i);
+  ASSERT_EQ(kResultOk, state.sendPendingMessages(&producer));
+  ASSERT_EQ((Received{{10, 2}, {11, 3}, {11, 4}, {11, 5}, {11, 6}}), producer.fReceived);
+
+  // one message per parameter, recycled after that
+  ASSERT_EQ(2u, producer.fMessages.size());
+  producer.fReceived.clear();
+  state.fValue.broadcast(3);
+  state.fEvents.broadcast(9);
+  ASSERT_EQ(kResultOk, state.sendPendingMessages(&producer));
+  ASSERT_EQ((Received{{10, 3}, {11, 9}}), producer.fReceived);
+  ASSERT_EQ(2u, producer.fMessages.size());
+
+  // a message still referenced by the host cannot be recycled (the first one is, the second one is not)
+  producer.fReceived.clear();
+  producer.fKeepMessages = true;
+  state.fEvents.broadcast(10);
+  state.fEvents.broadcast(11);
+  ASSERT_EQ(kResultOk, state.sendPendingMessages(&producer));
+  ASSERT_EQ((Received{{11, 10}, {11, 11}}), producer.fReceived);
+  ASSERT_EQ(3u, producer.fMessages.size());
+
+  // values filled in place and handed over
+  producer.fReceived.clear();
+  producer.fKeepMessages = false;
+  *state.fValue.acquire() = 12;
+  ASSERT_TRUE(state.fValue.broadcastAcquired());
+  for(int32 i = 13; i < 18; i++)
+  {
+    auto event = state.fEvents.acquire();
+    // queue full => no more values
+    if(i < 17)
+    {
+      ASSERT_TRUE(event != nullptr);
+      *event = i;
+      ASSERT_TRUE(state.fEvents.broadcastAcquired());
+    }
+    else
+    {
+      ASSERT_EQ(nullptr, event);
+      ASSERT_FALSE(state.fEvents.broadcastAcquired());
+    }
+  }
+  ASSERT_EQ(kResultOk, state.sendPendingMessages(&producer));
+  ASSERT_EQ((Received{{10, 12}, {11, 13}, {11, 14}, {11, 15}, {11, 16}}), producer.fReceived);
+}
+
+// RTState - MessageBatching
+TEST(RTState, MessageBatching)
+{
+  using Received = std::vector<std::pair<MessageID, int32>>;
+
+  MessagingTestParameters params{};
+  MessagingTestRTState state{params};
+  ASSERT_EQ(kResultOk, state.init());
+  state.enableMessageBatching();
+
+  MockMessageProducer producer{params.fValue, params.fEvents};
+
+  // nothing to send
+  ASSERT_EQ(kResultOk, state.sendPendingMessages(&producer));
+  ASSERT_EQ(0, producer.fSendCount);
+
+  // every update is sent in a single message
+  state.fValue.broadcast(1);
+  state.fValue.broadcast(2);
+  for(int32 i = 3; i < 6; i++)
+    state.fEvents.broadcast(i);
+  ASSERT_EQ(kResultOk, state.sendPendingMessages(&producer));
+  ASSERT_EQ((Received{{10, 2}, {11, 3}, {11, 4}, {11, 5}}), producer.fReceived);
+  ASSERT_EQ(1, producer.fSendCount);
+  ASSERT_EQ(1u, producer.fMessages.size());
+
+  // the message is recycled
+  producer.fReceived.clear();
+  state.fEvents.broadcast(6);
+  ASSERT_EQ(kResultOk, state.sendPendingMessages(&producer));
+  ASSERT_EQ((Received{{11, 6}}), producer.fReceived);
+  ASSERT_EQ(2, producer.fSendCount);
+  ASSERT_EQ(1u, producer.fMessages.size());
+}
+
+}
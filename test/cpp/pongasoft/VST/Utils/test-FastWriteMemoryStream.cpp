@@ -125,4 +125,25 @@ TEST(TestFastWriteMemoryStream, test_read)
   read(1, {'c'});
 }
 
+
+// TestFastWriteMemoryStream - test_rewind
+TEST(TestFastWriteMemoryStream, test_rewind)
+{
+  FastWriteMemoryStream vs{};
+
+  std::array<int8, 5> str = {'a', 'b', 'c', 'd', 'e'};
+  ASSERT_EQ(kResultOk, vs.write(str.data(), 5, nullptr));
+  auto data = vs.getData();
+
+  // rewind empties the stream but keeps the memory
+  vs.rewind();
+  ASSERT_EQ(0, vs.getSize());
+  ASSERT_EQ(0, vs.pos());
+  ASSERT_EQ(data, vs.getData());
+
+  ASSERT_EQ(kResultOk, vs.write(str.data() + 3, 2, nullptr));
+  ASSERT_EQ(data, vs.getData());
+  ASSERT_EQ((std::vector<int8>{'d', 'e'}), std::vector<int8>(vs.getData(), vs.getData() + vs.getSize()));
+}
+
 }
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include <pongasoft/VST/AudioBuffer.h>
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <cstdint>
 
 namespace pongasoft {
 namespace VST {
@@ -325,5 +326,109 @@ TEST(AudioBuffers, testCopyFrom) {
   }
 }
 
+// AudioBuffers - testGainMixSilence
+TEST(AudioBuffers, testGainMixSilence) {
+  constexpr Steinberg::int32 NUM_SAMPLES = 37;
+
+  InternalBuffer in{2, NUM_SAMPLES};
+  InternalBuffer out{2, NUM_SAMPLES};
+
+  AudioBuffers32 inBuffers = in.toAudioBuffers();
+  AudioBuffers32 outBuffers = out.toAudioBuffers();
+
+  ASSERT_TRUE(inBuffers.adjustSilenceFlags());
+
+  for(int i = 0; i < NUM_SAMPLES; i++)
+    inBuffers.getRightChannel().getBuffer()[i] = i % 2 == 0 ? 2 : -2;
+
+  ASSERT_FALSE(inBuffers.adjustSilenceFlags());
+  ASSERT_TRUE(inBuffers.getLeftChannel().isSilent());
+  ASSERT_FALSE(inBuffers.getRightChannel().isSilent());
+  ASSERT_FLOAT_EQ(2, inBuffers.getRightChannel().rms());
+  ASSERT_EQ(0, inBuffers.getLeftChannel().rms());
+
+  ASSERT_EQ(kResultOk, outBuffers.copyFromWithGain(inBuffers, 0.5));
+  ASSERT_EQ(1, outBuffers.absoluteMax());
+
+  ASSERT_EQ(kResultOk, outBuffers.mixFrom(inBuffers));
+  ASSERT_EQ(3, outBuffers.absoluteMax());
+
+  outBuffers.applyGain(2);
+  ASSERT_EQ(6, outBuffers.absoluteMax());
+  ASSERT_EQ(-6, outBuffers.getRightChannel().getBuffer()[NUM_SAMPLES - 2]);
+
+  ASSERT_FALSE(outBuffers.getRightChannel().adjustSilenceFlag());
+  ASSERT_TRUE(outBuffers.getLeftChannel().adjustSilenceFlag());
+}
+
+// OwnedAudioBuffers - testAlignment
+TEST(OwnedAudioBuffers, testAlignment) {
+  OwnedAudioBuffers32 buffers{3, 10};
+
+  ASSERT_EQ(3, buffers.getNumChannels());
+  ASSERT_EQ(10, buffers.getNumSamples());
+  ASSERT_TRUE(buffers.isSilent());
+
+  for(int32 c = 0; c < buffers.getNumChannels(); c++)
+  {
+    auto channel = buffers.getAudioChannel(c);
+    ASSERT_TRUE(channel.isActive());
+    ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(channel.getBuffer()) % OwnedAudioBuffers32::kAlignment);
+    for(int32 i = 0; i < buffers.getNumSamples(); i++)
+      ASSERT_EQ(0, channel.getBuffer()[i]);
+  }
+
+  // channels do not overlap
+  buffers.getAudioChannel(1).forEachSample([](Sample32 &s) { s = 1.0f; });
+  ASSERT_EQ(0, buffers.getAudioChannel(0).getBuffer()[9]);
+  ASSERT_EQ(0, buffers.getAudioChannel(2).getBuffer()[0]);
+  ASSERT_FALSE(buffers.adjustSilenceFlags());
+
+  OwnedAudioBuffers64 buffers64{2, 7};
+  ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(buffers64.getRightChannel().getBuffer()) % 64);
+
+  OwnedAudioBuffers32 noChannels{0, 10};
+  ASSERT_FALSE(noChannels.getLeftChannel().isActive());
+}
+
+// OwnedAudioBuffers - testAudioBuffersApi
+TEST(OwnedAudioBuffers, testAudioBuffersApi) {
+  constexpr Steinberg::int32 NUM_SAMPLES = 16;
+
+  InternalBuffer hostBuffer{2, NUM_SAMPLES};
+  auto host = hostBuffer.toAudioBuffers();
+  for(int32 i = 0; i < NUM_SAMPLES; i++)
+  {
+    host.getLeftChannel().getBuffer()[i] = static_cast<Sample32>(i);
+    host.getRightChannel().getBuffer()[i] = static_cast<Sample32>(-i);
+  }
+
+  // copy host -> owned
+  OwnedAudioBuffers32 owned{2, NUM_SAMPLES};
+  ASSERT_EQ(kResultOk, owned.copyFrom(host));
+  ASSERT_EQ(15, owned.getLeftChannel().getBuffer()[15]);
+  ASSERT_EQ(-15, owned.getRightChannel().getBuffer()[15]);
+
+  // usable as an AudioBuffers
+  AudioBuffers32 &asAudioBuffers = owned;
+  ASSERT_EQ(15, asAudioBuffers.absoluteMax());
+
+  // view over fewer samples
+  auto view = owned.view(4);
+  ASSERT_EQ(4, view.getNumSamples());
+  ASSERT_EQ(owned.getLeftChannel().getBuffer(), view.getLeftChannel().getBuffer());
+  ASSERT_EQ(3, view.absoluteMax());
+  view.clear();
+  ASSERT_EQ(0, owned.getLeftChannel().getBuffer()[3]);
+  ASSERT_EQ(4, owned.getLeftChannel().getBuffer()[4]);
+  ASSERT_EQ(NUM_SAMPLES, owned.view(100).getNumSamples());
+
+  // copy owned -> host
+  owned.applyGain(2);
+  ASSERT_EQ(kResultOk, owned.copyTo(host));
+  ASSERT_EQ(0, host.getLeftChannel().getBuffer()[3]);
+  ASSERT_EQ(30, host.getLeftChannel().getBuffer()[15]);
+}
+
 }
 }
\ No newline at end of file
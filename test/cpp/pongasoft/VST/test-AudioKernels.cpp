@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include <pongasoft/VST/AudioKernels.h>
+#include <pongasoft/VST/AudioUtils.h>
+#include <gtest/gtest.h>
+#include <vector>
+#include <limits>
+
+namespace pongasoft::VST::AudioKernels::TestAudioKernels {
+
+// all instruction sets (the ones not supported fall back to scalar)
+constexpr InstructionSet kInstructionSets[] = {
+  InstructionSet::kScalar,
+  InstructionSet::kSSE2,
+  InstructionSet::kAVX2,
+  InstructionSet::kNEON
+};
+
+// restores the best instruction set when going out of scope
+struct InstructionSetGuard
+{
+  ~InstructionSetGuard() { setInstructionSet(getBestInstructionSet()); }
+};
+
+// generates a "random" but deterministic buffer
+template<typename SampleType>
+std::vector<SampleType> generate(int32 iNumSamples, SampleType iAmplitude = 1)
+{
+  std::vector<SampleType> res(static_cast<size_t>(iNumSamples));
+  uint32 seed = 12345;
+  for(auto &s: res)
+  {
+    seed = seed * 1664525 + 1013904223;
+    s = iAmplitude * (static_cast<SampleType>(seed >> 8) / static_cast<SampleType>(1 << 24) * 2 - 1);
+  }
+  return res;
+}
+
+template<typename SampleType>
+void testKernels()
+{
+  InstructionSetGuard guard{};
+
+  for(auto instructionSet: kInstructionSets)
+  {
+    auto actual = setInstructionSet(instructionSet);
+    ASSERT_TRUE(actual == instructionSet || actual == InstructionSet::kScalar);
+
+    // testing various sizes to exercise the tails
+    for(int32 numSamples: {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 64, 67})
+    {
+      auto buffer = generate<SampleType>(numSamples);
+
+      // absoluteMax / sumOfSquares
+      SampleType expectedMax = 0;
+      SampleType expectedSum = 0;
+      for(auto s: buffer)
+      {
+        expectedMax = std::max(expectedMax, std::abs(s));
+        expectedSum += s * s;
+      }
+      ASSERT_EQ(expectedMax, absoluteMax(buffer.data(), numSamples));
+      ASSERT_NEAR(expectedSum, sumOfSquares(buffer.data(), numSamples), 1e-4);
+
+      // applyGain
+      auto gained = buffer;
+      applyGain(gained.data(), numSamples, static_cast<SampleType>(0.5));
+      for(int32 i = 0; i < numSamples; i++)
+        ASSERT_EQ(buffer[i] * static_cast<SampleType>(0.5), gained[i]);
+
+      // copyWithGain
+      std::vector<SampleType> copy(buffer.size());
+      copyWithGain(buffer.data(), copy.data(), numSamples, static_cast<SampleType>(2));
+      for(int32 i = 0; i < numSamples; i++)
+        ASSERT_EQ(buffer[i] * 2, copy[i]);
+
+      // mix
+      mix(buffer.data(), copy.data(), numSamples, static_cast<SampleType>(-1));
+      for(int32 i = 0; i < numSamples; i++)
+        ASSERT_EQ(buffer[i], copy[i]);
+
+      // isSilent
+      auto silent = generate<SampleType>(numSamples, getSampleSilentThreshold<SampleType>());
+      ASSERT_TRUE(isSilent(silent.data(), numSamples));
+
+      // a single non silent sample anywhere (including the tail) is enough
+      for(int32 i = 0; i < numSamples; i++)
+      {
+        auto notSilent = silent;
+        notSilent[i] = static_cast<SampleType>(i % 2 == 0 ? 0.1 : -0.1);
+        ASSERT_FALSE(isSilent(notSilent.data(), numSamples));
+        notSilent[i] = std::numeric_limits<SampleType>::quiet_NaN();
+        ASSERT_FALSE(isSilent(notSilent.data(), numSamples));
+      }
+    }
+  }
+}
+
+// AudioKernels - Sample32
+TEST(AudioKernels, Sample32)
+{
+  testKernels<Sample32>();
+}
+
+// AudioKernels - Sample64
+TEST(AudioKernels, Sample64)
+{
+  testKernels<Sample64>();
+}
+
+template<typename SampleType>
+void testDbConversion(double iRelativeTolerance, double iDbTolerance)
+{
+  InstructionSetGuard guard{};
+
+  for(auto instructionSet: kInstructionSets)
+  {
+    setInstructionSet(instructionSet);
+
+    for(int32 numSamples: {0, 1, 3, 4, 7, 8, 9, 17, 67, 1001})
+    {
+      // [-120dB, +24dB]
+      std::vector<SampleType> db(static_cast<size_t>(numSamples));
+      for(int32 i = 0; i < numSamples; i++)
+        db[i] = static_cast<SampleType>(-120.0 + 144.0 * i / std::max(numSamples - 1, 1));
+
+      std::vector<SampleType> samples(db.size());
+      dbToSample(db.data(), samples.data(), numSamples);
+      for(int32 i = 0; i < numSamples; i++)
+      {
+        auto expected = pongasoft::VST::dbToSample<double>(db[i]);
+        ASSERT_NEAR(expected, samples[i], expected * iRelativeTolerance) << "db=" << db[i];
+      }
+
+      // in place
+      sampleToDb(samples.data(), samples.data(), numSamples);
+      for(int32 i = 0; i < numSamples; i++)
+        ASSERT_NEAR(db[i], samples[i], iDbTolerance) << "db=" << db[i];
+    }
+
+    // <= 0 is clamped (finite result)
+    SampleType nonPositive[] = {0, -1, 0, -0.5, 0, 1};
+    sampleToDb(nonPositive, nonPositive, 6);
+    for(int32 i = 0; i < 5; i++)
+    {
+      ASSERT_TRUE(std::isfinite(nonPositive[i]));
+      ASSERT_LT(nonPositive[i], -700);
+    }
+    ASSERT_NEAR(0, nonPositive[5], iDbTolerance);
+
+    // NaN is propagated (every lane of the vectorized path + the scalar remainder)
+    auto const nan = std::numeric_limits<SampleType>::quiet_NaN();
+    SampleType withNaN[] = {0, nan, 6, 0, nan, 0, 0, 0, nan};
+    dbToSample(withNaN, withNaN, 9);
+    for(int32 i = 0; i < 9; i++)
+      ASSERT_EQ(i == 1 || i == 4 || i == 8, std::isnan(withNaN[i])) << "i=" << i;
+  }
+}
+
+// AudioKernels - dbConversion
+TEST(AudioKernels, dbConversion)
+{
+  testDbConversion<Sample32>(2e-6, 1e-4);
+  testDbConversion<Sample64>(1e-12, 1e-10);
+}
+
+// AudioKernels - rms
+TEST(AudioKernels, rms)
+{
+  std::vector<Sample32> buffer{1, -1, 1, -1, 1, -1, 1, -1, 1};
+  ASSERT_FLOAT_EQ(1.0f, rms(buffer.data(), static_cast<int32>(buffer.size())));
+  ASSERT_FLOAT_EQ(0.0f, rms(buffer.data(), 0));
+}
+
+}
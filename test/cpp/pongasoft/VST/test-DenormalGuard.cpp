@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include <pongasoft/VST/DenormalGuard.h>
+#include <gtest/gtest.h>
+
+namespace pongasoft::VST::TestDenormalGuard {
+
+// computes a denormal (0 when flushing denormals)
+float computeDenormal()
+{
+  volatile float tiny = 1e-30f;
+  volatile float factor = 1e-10f;
+  return tiny * factor;
+}
+
+// DenormalGuard - scope
+TEST(DenormalGuard, scope)
+{
+  if(!DenormalGuard::isSupported())
+    GTEST_SKIP() << "Flushing denormals not supported on this platform";
+
+  ASSERT_FALSE(DenormalGuard::isFlushingDenormals());
+  ASSERT_NE(0, computeDenormal());
+
+  {
+    DenormalGuard guard{};
+    ASSERT_TRUE(DenormalGuard::isFlushingDenormals());
+    ASSERT_EQ(0, computeDenormal());
+
+    // nested guard does not restore the mode when it goes out of scope
+    {
+      DenormalGuard nested{};
+      ASSERT_TRUE(DenormalGuard::isFlushingDenormals());
+    }
+    ASSERT_TRUE(DenormalGuard::isFlushingDenormals());
+  }
+
+  // restored
+  ASSERT_FALSE(DenormalGuard::isFlushingDenormals());
+  ASSERT_NE(0, computeDenormal());
+
+  // disabled guard does nothing
+  {
+    DenormalGuard guard{false};
+    ASSERT_FALSE(DenormalGuard::isFlushingDenormals());
+  }
+  ASSERT_FALSE(DenormalGuard::isFlushingDenormals());
+}
+
+}
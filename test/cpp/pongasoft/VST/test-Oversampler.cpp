@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include <pongasoft/VST/Oversampler.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+namespace pongasoft::VST::TestOversampler {
+
+constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+// Oversampler - coefficients
+TEST(Oversampler, coefficients)
+{
+  // computed at compile time
+  static_assert(Impl::kHalfBandCoefficients<double, 24>[0] > 0);
+  static_assert(Impl::kHalfBandCoefficients<double, 24>[1] < 0);
+
+  auto sum = 0.0;
+  for(auto c: Impl::kHalfBandCoefficients<double, 24>)
+    sum += c;
+  ASSERT_NEAR(0.25, sum, 1e-12);
+
+  ASSERT_EQ(47, (Oversampler<Sample32, 2>::kLatency));
+  ASSERT_EQ(54.5, (Oversampler<Sample32, 4>::kLatency));
+  ASSERT_EQ(56.25, (Oversampler<Sample32, 8>::kLatency));
+  ASSERT_EQ(56u, (Oversampler<Sample32, 8>{1, 16}.getLatencySamples()));
+}
+
+template<typename SampleType, int32 Factor>
+void testIdentity(bool iInPlace)
+{
+  constexpr int32 kNumSamples = 2000;
+  constexpr double kFrequency = 0.03; // in cycles per sample
+
+  Oversampler<SampleType, Factor> oversampler{2, 64};
+  ASSERT_EQ(Factor, oversampler.getFactor());
+
+  std::vector<SampleType> inputs[2] = {std::vector<SampleType>(kNumSamples), std::vector<SampleType>(kNumSamples)};
+  std::vector<SampleType> outputs[2] = {std::vector<SampleType>(kNumSamples), std::vector<SampleType>(kNumSamples)};
+  for(int32 i = 0; i < kNumSamples; i++)
+  {
+    inputs[0][i] = static_cast<SampleType>(std::sin(kTwoPi * kFrequency * i));
+    inputs[1][i] = static_cast<SampleType>(0.5 * std::cos(kTwoPi * kFrequency * i));
+  }
+
+  int32 numKernelSamples = 0;
+  auto identity = [&numKernelSamples](AudioBuffers<SampleType> &ioBuffers) {
+    ASSERT_EQ(2, ioBuffers.getNumChannels());
+    ASSERT_EQ(0, ioBuffers.getNumSamples() % Factor);
+    numKernelSamples += ioBuffers.getNumSamples();
+  };
+
+  // varying block sizes (100 is bigger than the max and is split)
+  int32 blockSizes[] = {1, 33, 64, 100, 5};
+  int32 offset = 0;
+  for(int32 i = 0; offset < kNumSamples; i++)
+  {
+    auto n = std::min(blockSizes[i % 5], kNumSamples - offset);
+
+    SampleType *in[2] = {inputs[0].data() + offset, inputs[1].data() + offset};
+    SampleType *out[2] = {outputs[0].data() + offset, outputs[1].data() + offset};
+
+    if(iInPlace)
+    {
+      std::copy(in[0], in[0] + n, out[0]);
+      std::copy(in[1], in[1] + n, out[1]);
+    }
+
+    AudioBusBuffers inBus{};
+    inBus.numChannels = 2;
+    AudioBusBuffers outBus{};
+    outBus.numChannels = 2;
+    if constexpr(std::is_same_v<SampleType, Sample32>)
+    {
+      inBus.channelBuffers32 = iInPlace ? out : in;
+      outBus.channelBuffers32 = out;
+    }
+    else
+    {
+      inBus.channelBuffers64 = iInPlace ? out : in;
+      outBus.channelBuffers64 = out;
+    }
+
+    AudioBuffers<SampleType> inBuffers{inBus, n};
+    AudioBuffers<SampleType> outBuffers{outBus, n};
+    oversampler.process(inBuffers, outBuffers, identity);
+
+    offset += n;
+  }
+
+  ASSERT_EQ(kNumSamples * Factor, numKernelSamples);
+
+  // output is the input delayed by the (exact) latency
+  auto latency = Oversampler<SampleType, Factor>::kLatency;
+  for(int32 i = 0; i < kNumSamples; i++)
+  {
+    // the beginning is off (the filters see the sine start abruptly)
+    auto t = i - latency;
+    if(t < latency)
+      continue;
+    auto expected0 = std::sin(kTwoPi * kFrequency * t);
+    auto expected1 = 0.5 * std::cos(kTwoPi * kFrequency * t);
+    ASSERT_NEAR(expected0, outputs[0][i], 1e-3) << "i=" << i;
+    ASSERT_NEAR(expected1, outputs[1][i], 1e-3) << "i=" << i;
+  }
+}
+
+// Oversampler - identity kernel (the output is the input delayed)
+TEST(Oversampler, identity)
+{
+  testIdentity<Sample32, 2>(false);
+  testIdentity<Sample32, 4>(true);
+  testIdentity<Sample32, 8>(false);
+  testIdentity<Sample64, 2>(true);
+  testIdentity<Sample64, 4>(false);
+  testIdentity<Sample64, 8>(true);
+}
+
+// Oversampler - the kernel runs at the high sample rate
+TEST(Oversampler, highRate)
+{
+  constexpr int32 kNumSamples = 512;
+  constexpr double kFrequency = 0.05;
+
+  Oversampler<Sample64, 4> oversampler{1, kNumSamples};
+
+  std::vector<Sample64> signal(kNumSamples);
+  for(int32 i = 0; i < kNumSamples; i++)
+    signal[i] = std::sin(kTwoPi * kFrequency * i);
+
+  Sample64 *channels[1] = {signal.data()};
+  AudioBusBuffers bus{};
+  bus.numChannels = 1;
+  bus.channelBuffers64 = channels;
+  AudioBuffers64 buffers{bus, kNumSamples};
+
+  // the upsampled signal is the same sine at 4 times the rate (delayed by the upsampling filters: 47/2 + 15/4)
+  auto upLatency = 47.0 / 2.0 + 15.0 / 4.0;
+  std::vector<Sample64> upsampled{};
+  oversampler.process(buffers, buffers, [&upsampled](AudioBuffers64 &ioBuffers) {
+    auto channel = ioBuffers.getBuffer()[0];
+    upsampled.assign(channel, channel + ioBuffers.getNumSamples());
+  });
+
+  ASSERT_EQ(static_cast<size_t>(4 * kNumSamples), upsampled.size());
+  for(int32 j = 200; j < 4 * kNumSamples; j++)
+    ASSERT_NEAR(std::sin(kTwoPi * kFrequency * (j / 4.0 - upLatency)), upsampled[j], 1e-3) << "j=" << j;
+}
+
+}
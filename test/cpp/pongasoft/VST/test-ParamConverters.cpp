@@ -191,5 +191,71 @@ TEST(ParamConverters, testDiscreteTypeParamConverter) {
 
 }
 
+// a gain (in dB) curve: [0, 1] => [-60dB, +12dB]
+class TestGainParamConverter : public IParamConverter<double>
+{
+public:
+  using IParamConverter<double>::toString;
+
+  explicit TestGainParamConverter(double iMaxDb = 12.0) : fMaxDb{iMaxDb} {}
+
+  ParamValue normalize(double const &iValue) const override
+  {
+    return (20.0 * std::log10(iValue) + 60.0) / (fMaxDb + 60.0);
+  }
+
+  double denormalize(ParamValue iNormalizedValue) const override
+  {
+    return std::pow(10.0, (iNormalizedValue * (fMaxDb + 60.0) - 60.0) / 20.0);
+  }
+
+  void toString(double const &iValue, String128 oString, int32 iPrecision) const override
+  {
+    Steinberg::UString wrapper(oString, str16BufferSize (String128));
+    wrapper.printFloat(20.0 * std::log10(iValue), iPrecision);
+  }
+
+private:
+  double fMaxDb;
+};
+
+// ParamConverters - testLUTParamConverter
+TEST(ParamConverters, testLUTParamConverter) {
+  TestGainParamConverter exact{};
+  LUTParamConverter<TestGainParamConverter> converter{};
+
+  ASSERT_GT(converter.getMaxError(), 0);
+  ASSERT_LT(converter.getMaxError(), 1e-4);
+
+  // exact on the table points (including the bounds)
+  ASSERT_DOUBLE_EQ(exact.denormalize(0), converter.denormalize(0));
+  ASSERT_DOUBLE_EQ(exact.denormalize(1.0), converter.denormalize(1.0));
+  ASSERT_DOUBLE_EQ(exact.denormalize(0.5), converter.denormalize(0.5));
+
+  // clamped
+  ASSERT_DOUBLE_EQ(exact.denormalize(0), converter.denormalize(-0.1));
+  ASSERT_DOUBLE_EQ(exact.denormalize(1.0), converter.denormalize(1.1));
+
+  for(int i = 0; i <= 1000; i++)
+  {
+    auto x = i / 1000.0;
+    ASSERT_NEAR(exact.denormalize(x), converter.denormalize(x), converter.getMaxError()) << "x=" << x;
+  }
+
+  // delegated
+  ASSERT_DOUBLE_EQ(exact.normalize(0.5), converter.normalize(0.5));
+  ASSERT_EQ(0, converter.getStepCount());
+  ASSERT_EQ(exact.toString(0.5, 2), converter.toString(0.5, 2));
+
+  // smaller table => bigger error
+  LUTParamConverter<TestGainParamConverter, 16> smallConverter{};
+  ASSERT_GT(smallConverter.getMaxError(), converter.getMaxError());
+
+  // arguments are forwarded to the wrapped converter
+  Parameters p{};
+  auto b = p.vst<LUTParamConverter<TestGainParamConverter>>(100, STR16("gain"), 0.0);
+  ASSERT_DOUBLE_EQ(1.0, b.fConverter->denormalize(1.0));
+}
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include <pongasoft/VST/RecyclableMessage.h>
+#include <pongasoft/VST/MessageProducer.h>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace pongasoft::VST::TestRecyclableMessage {
+
+struct TestMessageProducer : public IMessageProducer
+{
+  IPtr<IMessage> allocateMessage() override { return nullptr; }
+  tresult sendMessage(IPtr<IMessage> iMessage) override { return kResultOk; }
+};
+
+// RecyclableMessage - attributes
+TEST(RecyclableMessage, attributes)
+{
+  auto message = RecyclableMessage::create();
+  auto attributes = message->getAttributes();
+
+  ASSERT_EQ(nullptr, message->getMessageID());
+  message->setMessageID("id");
+  ASSERT_STREQ("id", message->getMessageID());
+
+  int64 i;
+  double f;
+  TChar s[4];
+  void const *data;
+  uint32 size;
+
+  ASSERT_EQ(kResultOk, attributes->setInt("int", 3));
+  ASSERT_EQ(kResultOk, attributes->setFloat("float", 0.5));
+  ASSERT_EQ(kResultOk, attributes->setString("string", STR16("abcdef")));
+  ASSERT_EQ(kResultOk, attributes->setBinary("binary", "xyz", 3));
+
+  ASSERT_EQ(kResultOk, attributes->getInt("int", i));
+  ASSERT_EQ(3, i);
+  ASSERT_EQ(kResultOk, attributes->getFloat("float", f));
+  ASSERT_EQ(0.5, f);
+  ASSERT_EQ(kResultOk, attributes->getBinary("binary", data, size));
+  ASSERT_EQ("xyz", std::string(static_cast<char const *>(data), size));
+
+  // truncated (0 terminated)
+  ASSERT_EQ(kResultOk, attributes->getString("string", s, sizeof(s)));
+  ASSERT_EQ(STR16("abc"), std::u16string(reinterpret_cast<char16_t const *>(s)));
+
+  // wrong type or missing
+  ASSERT_EQ(kResultFalse, attributes->getFloat("int", f));
+  ASSERT_EQ(kResultFalse, attributes->getInt("missing", i));
+
+  // overriding an attribute (even with a different type)
+  ASSERT_EQ(kResultOk, attributes->setFloat("int", 1.5));
+  ASSERT_EQ(kResultFalse, attributes->getInt("int", i));
+  ASSERT_EQ(kResultOk, attributes->getFloat("int", f));
+  ASSERT_EQ(1.5, f);
+  ASSERT_EQ(4, message->getAttributeCount());
+
+  // clear removes everything
+  message->clear();
+  ASSERT_EQ(nullptr, message->getMessageID());
+  ASSERT_EQ(0, message->getAttributeCount());
+  ASSERT_EQ(kResultFalse, attributes->getBinary("binary", data, size));
+}
+
+// IMessageProducer - recycleMessage
+TEST(IMessageProducer, recycleMessage)
+{
+  TestMessageProducer producer{};
+  IPtr<RecyclableMessage> message{};
+
+  // first call => allocates
+  auto m1 = producer.recycleMessage(message);
+  ASSERT_TRUE(m1 != nullptr);
+  m1->getAttributes()->setInt("a", 1);
+
+  // not shared => cleared and reused
+  auto m2 = producer.recycleMessage(message);
+  ASSERT_EQ(m1, m2);
+  int64 i;
+  ASSERT_EQ(kResultFalse, m2->getAttributes()->getInt("a", i));
+
+  // shared (ex: the host still holds it) => a new message is used and the previous one is left untouched
+  m2->getAttributes()->setInt("a", 2);
+  IPtr<IMessage> held{m2};
+  ASSERT_TRUE(message->isShared());
+  auto m3 = producer.recycleMessage(message);
+  ASSERT_NE(m2, m3);
+  ASSERT_EQ(kResultOk, held->getAttributes()->getInt("a", i));
+  ASSERT_EQ(2, i);
+}
+
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include <pongasoft/VST/STFTProcessor.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+namespace pongasoft::VST::TestSTFTProcessor {
+
+// a deterministic "random" signal
+template<typename SampleType>
+std::vector<SampleType> makeSignal(int32 iSize)
+{
+  std::vector<SampleType> signal(static_cast<size_t>(iSize));
+  uint32 seed = 12345;
+  for(auto &s: signal)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    s = static_cast<SampleType>(static_cast<double>(seed >> 8) / (1 << 24) * 2.0 - 1.0);
+  }
+  return signal;
+}
+
+template<typename SampleType>
+void testRealFFT(int32 iSize, double iTolerance)
+{
+  constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+  RealFFT<SampleType> fft{iSize};
+  ASSERT_EQ(iSize, fft.getSize());
+  ASSERT_EQ(iSize / 2 + 1, fft.getNumBins());
+
+  auto signal = makeSignal<SampleType>(iSize);
+  std::vector<SampleType> re(static_cast<size_t>(fft.getNumBins()));
+  std::vector<SampleType> im(static_cast<size_t>(fft.getNumBins()));
+
+  fft.forward(signal.data(), re.data(), im.data());
+
+  // compare with the (naive) DFT
+  for(int32 k = 0; k < fft.getNumBins(); k++)
+  {
+    double expectedRe = 0, expectedIm = 0;
+    for(int32 n = 0; n < iSize; n++)
+    {
+      expectedRe += signal[n] * std::cos(kTwoPi * k * n / iSize);
+      expectedIm -= signal[n] * std::sin(kTwoPi * k * n / iSize);
+    }
+    ASSERT_NEAR(expectedRe, re[k], iTolerance) << "k=" << k;
+    ASSERT_NEAR(expectedIm, im[k], iTolerance) << "k=" << k;
+  }
+
+  // round trip
+  std::vector<SampleType> output(static_cast<size_t>(iSize));
+  fft.inverse(re.data(), im.data(), output.data());
+  for(int32 n = 0; n < iSize; n++)
+    ASSERT_NEAR(signal[n], output[n], iTolerance) << "n=" << n;
+}
+
+// RealFFT - forward / inverse
+TEST(RealFFT, forwardInverse)
+{
+  for(int32 size: {4, 8, 16, 32, 64, 512, 2048})
+  {
+    testRealFFT<Sample32>(size, 1e-3);
+    testRealFFT<Sample64>(size, 1e-9);
+  }
+}
+
+template<typename SampleType>
+void testIdentity(int32 iFFTSize, int32 iHopSize, STFTWindow iWindow, bool iInPlace)
+{
+  constexpr int32 kNumChannels = 2;
+  constexpr int32 kNumSamples = 3000;
+
+  STFTProcessor<SampleType> stft{kNumChannels, iFFTSize, iHopSize, iWindow};
+  ASSERT_EQ(static_cast<uint32>(iFFTSize), stft.getLatencySamples());
+
+  std::vector<SampleType> inputs[kNumChannels] = {makeSignal<SampleType>(kNumSamples),
+                                                  makeSignal<SampleType>(kNumSamples + 1)};
+  std::vector<SampleType> outputs[kNumChannels] = {std::vector<SampleType>(kNumSamples),
+                                                   std::vector<SampleType>(kNumSamples)};
+
+  int numFrames = 0;
+  auto identity = [&numFrames, &stft](int32 iChannel, SampleType *ioReal, SampleType *ioImag, int32 iNumBins) {
+    ASSERT_EQ(stft.getNumBins(), iNumBins);
+    if(iChannel == 0)
+      numFrames++;
+  };
+
+  // process with varying block sizes
+  int32 blockSizes[] = {1, 7, 64, 100, 3};
+  int32 offset = 0;
+  for(int32 i = 0; offset < kNumSamples; i++)
+  {
+    auto n = std::min(blockSizes[i % 5], kNumSamples - offset);
+
+    SampleType *in[kNumChannels] = {inputs[0].data() + offset, inputs[1].data() + offset};
+    SampleType *out[kNumChannels] = {outputs[0].data() + offset, outputs[1].data() + offset};
+
+    if(iInPlace)
+    {
+      std::copy(in[0], in[0] + n, out[0]);
+      std::copy(in[1], in[1] + n, out[1]);
+    }
+
+    AudioBusBuffers inBus{};
+    inBus.numChannels = kNumChannels;
+    AudioBusBuffers outBus{};
+    outBus.numChannels = kNumChannels;
+    if constexpr(std::is_same_v<SampleType, Sample32>)
+    {
+      inBus.channelBuffers32 = iInPlace ? out : in;
+      outBus.channelBuffers32 = out;
+    }
+    else
+    {
+      inBus.channelBuffers64 = iInPlace ? out : in;
+      outBus.channelBuffers64 = out;
+    }
+
+    AudioBuffers<SampleType> inBuffers{iInPlace ? outBus : inBus, n};
+    AudioBuffers<SampleType> outBuffers{outBus, n};
+    stft.process(inBuffers, outBuffers, identity);
+
+    offset += n;
+  }
+
+  ASSERT_EQ(kNumSamples / iHopSize, numFrames);
+
+  // output is the input delayed by the latency
+  for(int32 c = 0; c < kNumChannels; c++)
+  {
+    for(int32 i = 0; i < iFFTSize; i++)
+      ASSERT_NEAR(0, outputs[c][i], 1e-4) << "c=" << c << ", i=" << i;
+    for(int32 i = iFFTSize; i < kNumSamples; i++)
+      ASSERT_NEAR(inputs[c][i - iFFTSize], outputs[c][i], 1e-4) << "c=" << c << ", i=" << i;
+  }
+}
+
+// STFTProcessor - identity (the output is the input delayed)
+TEST(STFTProcessor, identity)
+{
+  testIdentity<Sample32>(256, 64, STFTWindow::kHann, false);
+  testIdentity<Sample32>(256, 64, STFTWindow::kHann, true);
+  testIdentity<Sample32>(128, 128, STFTWindow::kRectangular, false);
+  testIdentity<Sample32>(512, 128, STFTWindow::kBlackman, true);
+  testIdentity<Sample64>(64, 32, STFTWindow::kHamming, false);
+  testIdentity<Sample64>(1024, 256, STFTWindow::kHann, true);
+}
+
+// STFTProcessor - spectral processing
+TEST(STFTProcessor, processing)
+{
+  constexpr double kTwoPi = 6.283185307179586476925286766559;
+  constexpr int32 kFFTSize = 256;
+  constexpr int32 kNumSamples = 4096;
+
+  STFTProcessor<Sample64> stft{1, kFFTSize, kFFTSize / 4};
+
+  // 2 sines exactly on bins 4 and 64
+  std::vector<Sample64> signal(kNumSamples);
+  for(int32 i = 0; i < kNumSamples; i++)
+    signal[i] = std::sin(kTwoPi * 4 * i / kFFTSize) + std::sin(kTwoPi * 64 * i / kFFTSize);
+
+  Sample64 *channels[1] = {signal.data()};
+  AudioBusBuffers bus{};
+  bus.numChannels = 1;
+  bus.channelBuffers64 = channels;
+  AudioBuffers64 buffers{bus, kNumSamples};
+
+  // remove everything above bin 32 (in place)
+  stft.process(buffers, buffers, [](int32 iChannel, Sample64 *ioReal, Sample64 *ioImag, int32 iNumBins) {
+    for(int32 k = 32; k < iNumBins; k++)
+      ioReal[k] = ioImag[k] = 0;
+  });
+
+  ASSERT_FALSE(buffers.isSilent());
+
+  // only the low sine remains (delayed)
+  for(int32 i = 2 * kFFTSize; i < kNumSamples; i++)
+    ASSERT_NEAR(std::sin(kTwoPi * 4 * (i - kFFTSize) / kFFTSize), signal[i], 1e-9) << "i=" << i;
+}
+
+}